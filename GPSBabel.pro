@@ -83,8 +83,9 @@ JEEPS += jeeps/gpsapp.cc jeeps/gpscom.cc \
 SUPPORT = queue.cc route.cc waypt.cc filter_vecs.cc util.cc vecs.cc mkshort.cc \
           csv_util.cc strptime.c grtcirc.cc util_crc.cc xmlgeneric.cc \
           formspec.cc xmltag.cc cet.cc cet_util.cc fatal.cc rgbcolors.cc \
-          inifile.cc garmin_fs.cc units.cc gbser.cc \
-          gbfile.cc parse.cc session.cc main.cc globals.cc \
+          inifile.cc garmin_fs.cc units.cc gbser.cc context.cc \
+          gbfile.cc parse.cc progress.cc session.cc main.cc globals.cc server.cc \
+          src/core/timeindex.cc \
           src/core/usasciicodec.cc \
           src/core/xmlstreamwriter.cc 
 
@@ -95,6 +96,7 @@ HEADERS =  \
 	cet/cp1252.h \
 	cet/iso_8859_8.h \
 	cet_util.h \
+	context.h \
 	csv_util.h \
 	defs.h \
 	explorist_ini.h \
@@ -133,7 +135,9 @@ HEADERS =  \
 	magellan.h \
 	mapsend.h \
 	navilink.h \
+	progress.h \
 	queue.h \
+	server.h \
 	session.h \
 	shapelib/shapefil.h \
 	strptime.h \
@@ -153,6 +157,7 @@ HEADERS =  \
 	src/core/datetime.h \
 	src/core/file.h \
 	src/core/logging.h \
+	src/core/timeindex.h \
 	src/core/usasciicodec.h \
 	src/core/xmlstreamwriter.h \
 	src/core/xmltag.h
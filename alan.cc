@@ -497,12 +497,12 @@ static Waypoint* get_wpt(struct wprdata* wprdata, unsigned n)
   for (j=WPT_COMMENT_LEN-1; j >= 0 && wpt->comment[j] == ' '; j--) {};
   if (j >= 0) {
     char *s = xstrndup(wpt->comment, j+1);
-    WP->description = s;
+    WP->SetDescription(s);
     xfree(s);
   } else {
-    WP->description = "";
+    WP->SetDescription("");
   }
-  WP->notes = "";
+  WP->SetNotes("");
 
   return WP;
 }
@@ -682,7 +682,7 @@ static int add_wpt(struct wprdata* wprdata, const Waypoint* WP,int isroute)
 
   wpt = &(wprdata->wpt[wpt_idx]);
   str2lab(wpt->name, WP->shortname, WPT_NAME_LEN, "W%05d", wpt_idx);
-  str2lab(wpt->comment, WP->description, WPT_COMMENT_LEN, nullptr, 0);
+  str2lab(wpt->comment, WP->GetDescription(), WPT_COMMENT_LEN, nullptr, 0);
   wpt->pt.x = deg2pt(WP->longitude);
   wpt->pt.y = deg2pt(-WP->latitude);
   wpt->usecount = isroute ? 1 : 0;
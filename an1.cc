@@ -673,15 +673,15 @@ static void Read_AN1_Waypoints(gbfile* f)
     }
     wpt_tmp->longitude = -DecodeOrd(rec->lon);
     wpt_tmp->latitude = DecodeOrd(rec->lat);
-    wpt_tmp->notes = rec->comment;
-    wpt_tmp->description = rec->name;
+    wpt_tmp->SetNotes(rec->comment);
+    wpt_tmp->SetDescription(rec->name);
 
     if (rec->url) {
       wpt_tmp->AddUrlLink(rec->url);
     } else {
-      int u = wpt_tmp->description.indexOf("{URL=");
+      int u = wpt_tmp->GetDescription().indexOf("{URL=");
       if (u != -1) {
-        QString us = wpt_tmp->description.mid(u);
+        QString us = wpt_tmp->GetDescription().mid(u);
         us.remove(0,5); // throw away anything up to and including "{URL="
         us.chop(1); // throw away final character, assumed to be "}"
         if (!us.isEmpty()) {
@@ -691,9 +691,9 @@ static void Read_AN1_Waypoints(gbfile* f)
     }
 
     if (rec->image_name) {
-      wpt_tmp->icon_descr = rec->image_name;
+      wpt_tmp->SetIconDescr(rec->image_name);
     } else if (FindIconByGuid(&rec->guid, &icon)) {
-      wpt_tmp->icon_descr = icon;
+      wpt_tmp->SetIconDescr(icon);
     }
 
     fs_chain_add(&(wpt_tmp->fs), (format_specific_data*)rec);
@@ -737,7 +737,7 @@ Write_One_AN1_Waypoint(const Waypoint* wpt)
     rec->visible_zoom = opt_zoom?opt_zoom_num:10;
     rec->unk6_1 = 1;
   }
-  rec->name = xstrdup(wpt->description);
+  rec->name = xstrdup(wpt->GetDescription());
 
   if (!nogc && wpt->gc_data->id) {
 #if NEW_STRINGS
@@ -765,11 +765,11 @@ Write_One_AN1_Waypoint(const Waypoint* wpt)
     }
     rec->url = xstrdup(l.url_);
   }
-  if (!wpt->notes.isEmpty()) {
+  if (!wpt->GetNotes().isEmpty()) {
     if (rec->comment) {
       xfree(rec->comment);
     }
-    rec->comment = xstrdup(wpt->notes);
+    rec->comment = xstrdup(wpt->GetNotes());
   }
 
 
@@ -779,14 +779,14 @@ Write_One_AN1_Waypoint(const Waypoint* wpt)
   rec->serial = serial++;
 
   if (rec->type == 0x12) {    /* image */
-    if (wpt->icon_descr.contains(":\\")) {
-      rec->image_name = xstrdup(wpt->icon_descr);
+    if (wpt->GetIconDescr().contains(":\\")) {
+      rec->image_name = xstrdup(wpt->GetIconDescr());
       rec->height = -244;
       rec->width = -1;
     }
   }
-  if (!rec->image_name && !wpt->icon_descr.isNull()) {
-    FindIconByName(CSTR(wpt->icon_descr), &rec->guid);
+  if (!rec->image_name && !wpt->GetIconDescr().isNull()) {
+    FindIconByName(CSTR(wpt->GetIconDescr()), &rec->guid);
   }
 
   Write_AN1_Waypoint(outfile, rec);
@@ -36,7 +36,7 @@
 
 void ArcDistanceFilter::arcdist_arc_disp_wpt_cb(const Waypoint* arcpt2)
 {
-  static Waypoint* arcpt1 = nullptr;
+  static thread_local Waypoint* arcpt1 = nullptr;
   double prjlat, prjlon, frac;
 
   if (arcpt2 && arcpt2->latitude != BADVAL && arcpt2->longitude != BADVAL &&
@@ -183,19 +183,18 @@ void ArcDistanceFilter::process()
           }
         }
         if (trkopt &&
-            (ed->arcpt2->GetCreationTime().isValid()) &&
-            (ptsopt || (ed->arcpt1->GetCreationTime().isValid()))) {
+            (ed->arcpt2->creation_time.isValid()) &&
+            (ptsopt || (ed->arcpt1->creation_time.isValid()))) {
           /* Interpolate time */
           if (ptsopt) {
-            wp->SetCreationTime(ed->arcpt2->GetCreationTime());
+            wp->creation_time = ed->arcpt2->creation_time;
           } else {
             // Apply the multiplier to the difference between the times
             // of the two points.   Add that to the first for the
             // interpolated time.
             int scaled_time = ed->frac *
-                              ed->arcpt1->GetCreationTime().msecsTo(ed->arcpt2->GetCreationTime());
-            QDateTime new_time(ed->arcpt1->GetCreationTime().addMSecs(scaled_time));
-            wp->SetCreationTime(new_time);
+                              ed->arcpt1->creation_time.msecsTo(ed->arcpt2->creation_time);
+            wp->creation_time = ed->arcpt1->creation_time.addMSecs(scaled_time);
           }
         }
         if (global_opts.debug_level >= 1) {
@@ -126,7 +126,7 @@ bcr_icon_mapping_t bcr_icon_mapping[] = {
 static void
 bcr_handle_icon_str(const char* str, Waypoint* wpt)
 {
-  wpt->icon_descr = BCR_DEF_MPS_ICON;
+  wpt->SetIconDescr(BCR_DEF_MPS_ICON);
 
   for (bcr_icon_mapping_t* m = bcr_icon_mapping; (m->bcr_name); m++) {
     if (case_ignore_strcmp(str, m->bcr_name) == 0) {
@@ -137,10 +137,10 @@ bcr_handle_icon_str(const char* str, Waypoint* wpt)
         }
         return;
       }
-      wpt->description = m->symbol_DE;
+      wpt->SetDescription(m->symbol_DE);
       if (m->mps_name != nullptr) {
         int nr = gt_find_icon_number_from_desc(m->mps_name, MAPSOURCE);
-        wpt->icon_descr = gt_find_desc_from_icon_number(nr, MAPSOURCE);
+        wpt->SetIconDescr(gt_find_desc_from_icon_number(nr, MAPSOURCE));
       }
       return;
     }
@@ -287,7 +287,7 @@ bcr_data_read()
     if (!str.isNull()) {
       QString note = str.section(',', 0, 0);
       if (!note.isEmpty()) {
-        wpt->notes = note;
+        wpt->SetNotes(note);
       }
       QString shortname = str.section(',', 1, 1);
       if (!shortname.isEmpty()) {
@@ -380,7 +380,7 @@ bcr_route_header(const route_head* route)
 
     i++;
 
-    const char* icon = get_bcr_icon_from_icon_descr(wpt->icon_descr);
+    const char* icon = get_bcr_icon_from_icon_descr(wpt->GetIconDescr());
 
     sout = QString("%1,%2").arg(icon).arg(BCR_UNKNOWN,10);
     bcr_write_line(fout, "STATION", &i, sout);
@@ -423,9 +423,9 @@ bcr_route_header(const route_head* route)
 
     i++;
     wpt = reinterpret_cast<Waypoint *>(elem);
-    QString s1 = wpt->notes;
+    QString s1 = wpt->GetNotes();
     if (s1.isEmpty()) {
-      s1 = wpt->description;
+      s1 = wpt->GetDescription();
     }
 
     if (prefer_shortnames_opt || (s1.isEmpty())) {
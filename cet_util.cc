@@ -25,21 +25,18 @@
 #include "src/core/logging.h"
 #include <QtCore/QDebug>
 #include <QtCore/QTextCodec>
-#include <cstdlib> // qsort
 
 #define MYNAME "cet_util"
 
 static cet_cs_vec_t* cet_cs_vec_root = nullptr;
 
 typedef struct cet_cs_alias_s {
-  char* name;
+  const char* name;
   cet_cs_vec_t* vec;
 } cet_cs_alias_t;
 
-static cet_cs_alias_t* cet_cs_alias;
-static int cet_cs_alias_ct = 0;
 static int cet_cs_vec_ct = 0;
-static int cet_output = 0;
+static thread_local int cet_output = 0;
 
 /* %%% fixed inbuild character sets %%% */
 
@@ -79,14 +76,6 @@ cet_str_any_to_any(const char* src, const cet_cs_vec_t* src_vec, const cet_cs_ve
   return c1;
 }
 
-static signed int
-cet_cs_alias_qsort_cb(const void* a, const void* b)
-{
-  const cet_cs_alias_t* va = (const cet_cs_alias_t*) a;
-  const cet_cs_alias_t* vb = (const cet_cs_alias_t*) b;
-  return case_ignore_strcmp(va->name, vb->name);
-}
-
 void
 cet_register_cs(cet_cs_vec_t* vec)
 {
@@ -118,10 +107,48 @@ cet_cs_vec_t cet_cs_vec_utf8 = {
   nullptr,
 };
 
+/*
+ * Names and aliases of the character sets above, sorted the way
+ * case_ignore_strcmp() orders them so that cet_find_cs_by_name() can
+ * search them without building a table first.  Keep this in step with
+ * the alias lists in cet/*.h.
+ */
+static const cet_cs_alias_t cet_cs_alias[] = {
+  { "1252", &cet_cs_vec_cp1252 },
+  { "367", &cet_cs_vec_ansi_x3_4_1968 },
+  { "ANSI_X3.4-1968", &cet_cs_vec_ansi_x3_4_1968 },
+  { "ANSI_X3.4-1986", &cet_cs_vec_ansi_x3_4_1968 },
+  { "ASCII", &cet_cs_vec_ansi_x3_4_1968 },
+  { "CP1252", &cet_cs_vec_cp1252 },
+  { "CP367", &cet_cs_vec_ansi_x3_4_1968 },
+  { "csASCII", &cet_cs_vec_ansi_x3_4_1968 },
+  { "csISOLatinHebrew", &cet_cs_vec_iso_8859_8 },
+  { "hebrew", &cet_cs_vec_iso_8859_8 },
+  { "IBM367", &cet_cs_vec_ansi_x3_4_1968 },
+  { "ISO-8859-8", &cet_cs_vec_iso_8859_8 },
+  { "iso-ir-138", &cet_cs_vec_iso_8859_8 },
+  { "iso-ir-6", &cet_cs_vec_ansi_x3_4_1968 },
+  { "ISO646-US", &cet_cs_vec_ansi_x3_4_1968 },
+  { "ISO646.1991-IRV", &cet_cs_vec_ansi_x3_4_1968 },
+  { "ISO8859-8", &cet_cs_vec_iso_8859_8 },
+  { "ISO_646.irv:1991", &cet_cs_vec_ansi_x3_4_1968 },
+  { "ISO_8859-8", &cet_cs_vec_iso_8859_8 },
+  { "ISO_8859-8:1988", &cet_cs_vec_iso_8859_8 },
+  { "ms-ansi", &cet_cs_vec_cp1252 },
+  { "us", &cet_cs_vec_ansi_x3_4_1968 },
+  { "US-ASCII", &cet_cs_vec_ansi_x3_4_1968 },
+  { "UTF-8", &cet_cs_vec_utf8 },
+  { "utf8", &cet_cs_vec_utf8 },
+  { "WIN-CP1252", &cet_cs_vec_cp1252 },
+  { "windows-1252", &cet_cs_vec_cp1252 },
+};
+
+static const int cet_cs_alias_ct = sizeof(cet_cs_alias) / sizeof(cet_cs_alias[0]);
+
 void
 cet_register()
 {
-  int i, c;
+  int i;
 
   if (cet_cs_vec_root != nullptr) {
     return;
@@ -142,44 +169,6 @@ cet_register()
 
 
   if (cet_cs_vec_ct > 0) {
-    cet_cs_vec_t* p;
-    c = 0;
-
-    /* enumerate count of all names and aliases */
-
-    for (p = cet_cs_vec_root; p != nullptr; p = p->next) {
-      c++;
-      if (p->alias != nullptr) {
-        const char** a = p->alias;
-        while ((*a) != nullptr) {
-          a++;
-          c++;
-        }
-      }
-    }
-    /* create name to vec table */
-
-    cet_cs_alias_t* list = (cet_cs_alias_t*) xcalloc(c, sizeof(*list));
-    i = 0;
-    for (p = cet_cs_vec_root; p != nullptr; p = p->next) {
-      if (p->alias != nullptr) {
-        const char** a = p->alias;
-
-        list[i].name = xstrdup(p->name);
-        list[i].vec = p;
-        i++;
-        while (*a != nullptr) {
-          list[i].name = xstrdup(*a);
-          list[i].vec = p;
-          i++;
-          a++;
-        }
-      }
-    }
-    qsort(list, c, sizeof(*list), cet_cs_alias_qsort_cb);
-    cet_cs_alias = list;
-    cet_cs_alias_ct = c;
-
     /* install fallback for ascii-like (first 128 ch.) character sets */
     for (i = 1250; i <= 1258; i++) {
       char name[16];
@@ -210,16 +199,12 @@ cet_find_cs_by_name(const QString& name)
 {
   cet_register();
 
-  if (cet_cs_alias == nullptr) {
-    return nullptr;
-  }
-
   int i = 0;
   int j = cet_cs_alias_ct - 1;
 
   while (i <= j) {
     int a = (i + j) >> 1;
-    cet_cs_alias_t* n = &cet_cs_alias[a];
+    const cet_cs_alias_t* n = &cet_cs_alias[a];
     int x = case_ignore_strcmp(name, n->name);
     if (x == 0) {
       return n->vec;
@@ -232,25 +217,6 @@ cet_find_cs_by_name(const QString& name)
   return nullptr;
 }
 
-void
-cet_deregister()
-{
-  int j = cet_cs_alias_ct;
-  cet_cs_alias_t* p = cet_cs_alias;
-
-  if (p == nullptr) {
-    return;
-  }
-
-  cet_cs_alias_ct = 0;
-  cet_cs_alias = nullptr;
-
-  for (int i = 0; i < j; i++) {
-    xfree(p[i].name);
-  }
-  xfree(p);
-}
-
 /* gpsbabel additions */
 
 int
@@ -290,7 +256,7 @@ cet_convert_init(const QString& cs_name, const int force)
   if ((force != 0) || (global_opts.charset == nullptr)) {
     cet_convert_deinit();
     if (0 == cet_validate_cs(cs_name, &global_opts.charset, &global_opts.charset_name)) {
-      Fatal() << "Unsupported character set \"" << cs_name << ".";
+      fatal(FatalMsg() << "Unsupported character set \"" << cs_name << ".");
     }
     if (cs_name.isEmpty()) {	/* set default us-ascii */
       global_opts.codec = QTextCodec::codecForName(CET_CHARSET_ASCII);
@@ -299,7 +265,7 @@ cet_convert_init(const QString& cs_name, const int force)
       global_opts.codec = QTextCodec::codecForName(ba);
     }
     if (!global_opts.codec) {
-      Fatal() << "Unsupported character set \"" << cs_name << ".";
+      fatal(FatalMsg() << "Unsupported character set \"" << cs_name << ".");
     }
   }
 }
@@ -330,7 +296,7 @@ cet_flag_all()
 /* %%%         complete data strings transformation                 %%% */
 /* -------------------------------------------------------------------- */
 
-static char* (*converter)(const char*) = nullptr;
+static thread_local char* (*converter)(const char*) = nullptr;
 
 /* two converters */
 
@@ -32,7 +32,6 @@
 
 cet_cs_vec_t* cet_find_cs_by_name(const QString& name);
 void cet_register();
-void cet_deregister();
 
 /* short hand transmissions */
 
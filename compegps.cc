@@ -210,12 +210,11 @@ parse_wpt(char* buff)
         wpt->altitude = atof(c);
         break;
       case 7:
-        wpt->description = c;
+        wpt->SetDescription(c);
         break;
       default:
         if (col > 7) {
-          wpt->description += " ";
-          wpt->description += c;
+          wpt->SetDescription(wpt->GetDescription() + " " + c);
         }
       }
     }
@@ -240,7 +239,7 @@ parse_wpt_info(const char* buff, Waypoint* wpt)		/* "w" */
 #endif
       switch (col) {
       case 0:
-        wpt->icon_descr = c;
+        wpt->SetIconDescr(c);
         break;
       case 1:
         break;			/* Text postion */
@@ -487,15 +486,15 @@ write_waypt_cb(const Waypoint* wpt)
             fabs(wpt->longitude), 0xBA, (wpt->longitude >= 0) ? 'E' : 'W');
   gbfprintf(fout, "27-MAR-62 00:00:00 %.6f",
             (wpt->altitude != unknown_alt) ? wpt->altitude : 0.0);
-  if (wpt->description != nullptr) {
-    gbfprintf(fout, " %s", CSTRc(wpt->description));
+  if (wpt->GetDescription() != nullptr) {
+    gbfprintf(fout, " %s", CSTRc(wpt->GetDescription()));
   }
   gbfprintf(fout, "\n");
 
-  if ((!wpt->icon_descr.isNull()) || (wpt->wpt_flags.proximity) || \
+  if ((!wpt->GetIconDescr().isNull()) || (wpt->wpt_flags.proximity) || \
       (option_icon != nullptr)) {
     gbfprintf(fout, "w  %s,0,0.0,16777215,255,1,7,,%.1f\n",
-              wpt->icon_descr.isNull() ? "Waypoint" : CSTR(wpt->icon_descr),
+              wpt->GetIconDescr().isNull() ? "Waypoint" : CSTR(wpt->GetIconDescr()),
               WAYPT_GET(wpt, proximity, 0));
   }
 }
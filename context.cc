@@ -0,0 +1,74 @@
+/*
+    The state of one conversion.
+
+    Copyright (C) 2019 Robert Lipe, gpsbabel.org
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111 USA
+
+ */
+
+#include "context.h"
+
+#include "defs.h"
+#include "filterdefs.h"       // for exit_filter_vecs
+#include "session.h"          // for session_exit, session_init
+
+/*
+ * The formats that keep all of their state in thread local storage.
+ * Before adding one here, check everything it calls along the way.
+ */
+static const char* const reentrant_formats[] = {
+  "gpx",
+  "kml",
+  "nmea",
+  "unicsv",
+  "xcsv",
+  nullptr
+};
+
+ConversionContext::ConversionContext(const global_options& opts)
+{
+  global_opts = opts;
+  session_init();
+  waypt_init();
+  route_init();
+}
+
+ConversionContext::~ConversionContext()
+{
+  waypt_flush_all();
+  route_flush_all();
+  session_exit();
+  exit_thread_vecs();
+  exit_filter_vecs();
+}
+
+bool
+ConversionContext::is_reentrant(const QString& format)
+{
+  for (const char* const* f = reentrant_formats; *f; f++) {
+    if (format.compare(*f, Qt::CaseInsensitive) == 0) {
+      return true;
+    }
+  }
+
+  /* The xcsv styles are read and written by xcsv. */
+  for (style_vecs_t* svec = style_list; svec->name; svec++) {
+    if (format.compare(svec->name, Qt::CaseInsensitive) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,55 @@
+/*
+    The state of one conversion.
+
+    Copyright (C) 2019 Robert Lipe, gpsbabel.org
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111 USA
+
+ */
+
+#ifndef CONTEXT_H_INCLUDED_
+#define CONTEXT_H_INCLUDED_
+
+#include "defs.h"             // for global_options
+
+#include <QtCore/QString>     // for QString
+
+/*
+ * Everything a conversion works on, the waypoints, routes and tracks, the
+ * sessions, global_opts and the state of the formats and filters, is kept
+ * in thread local storage.  Readers, writers and filters find it under the
+ * names they always used, but every thread has its own, so conversions on
+ * different threads don't see each other.
+ *
+ * A ConversionContext readies the calling thread's state for a conversion
+ * with the given options, and clears it again when it goes out of scope.
+ * A thread can have only one context at a time.
+ *
+ * The core and all filters keep their state this way, but of the formats
+ * only those is_reentrant() accepts do.  A conversion that uses any other
+ * format must not run while another conversion is running.
+ */
+class ConversionContext
+{
+public:
+  explicit ConversionContext(const global_options& opts);
+  ~ConversionContext();
+  ConversionContext(const ConversionContext&) = delete;
+  ConversionContext& operator=(const ConversionContext&) = delete;
+
+  static bool is_reentrant(const QString& format);
+};
+
+#endif // CONTEXT_H_INCLUDED_
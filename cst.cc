@@ -61,7 +61,7 @@ cst_add_wpt(route_head* track, Waypoint* wpt)
     // Rather than creating a new waypt on each read, tis format bizarrely
     // recycles the same one, relying on new waypoint(*) above and then manually
     // resetting fields.  Weird.
-    wpt->urls.clear();
+    wpt->ClearUrlLinks();
 
     if (temp_route == nullptr) {
       temp_route = route_head_alloc();
@@ -228,7 +228,7 @@ cst_data_read()
             line++;
             cin = lrtrim(buff);
             if (*cin != '\0') {
-              wpt->notes = QString::fromLatin1(cin);
+              wpt->SetNotes(QString::fromLatin1(cin));
             }
           } else if (strcmp(cin + 2, "end") == 0) {
             data = 1;
@@ -58,7 +58,7 @@ csv_stringclean(const QString& source, const QString& to_nuke)
 char*
 csv_stringtrim(const char* string, const char* enclosure, int strip_max)
 {
-  static const char* p1 = nullptr;
+  static thread_local const char* p1 = nullptr;
   char* tmp = xstrdup(string);
   size_t elen;
   int stripped = 0;
@@ -131,8 +131,8 @@ char*
 csv_lineparse(const char* stringstart, const char* delimited_by,
               const char* enclosed_in, const int line_no)
 {
-  static const char* p = nullptr;
-  static char* tmp = nullptr;
+  static thread_local const char* p = nullptr;
+  static thread_local char* tmp = nullptr;
   size_t dlen = 0, elen = 0, efound = 0;
   int enclosedepth = 0;
   short int hyper_whitespace_delimiter = 0;
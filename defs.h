@@ -34,6 +34,7 @@
 #include "inifile.h"
 #include "session.h"
 
+#include <QtCore/QSharedData>
 #include <QtCore/QString>
 #include <utility>
 #include "src/core/datetime.h"
@@ -177,6 +178,8 @@ typedef struct {
   gpsdata_type objective;
   unsigned int	masked_objective;
   int verbose_status;	/* set by GUI wrappers for status */
+  int progress;		/* -vp: machine readable progress, see progress.h */
+  int profile;		/* --profile: 1 for a table, 2 for JSON, see progress.h */
   int smart_icons;
   int smart_names;
   cet_cs_vec_t* charset;
@@ -185,7 +188,11 @@ typedef struct {
   QTextCodec* codec;
 } global_options;
 
-extern global_options global_opts;
+/*
+ * Thread local, like the rest of the state of a conversion, so that every
+ * thread converts in a context of its own.  See context.h.
+ */
+extern thread_local global_options global_opts;
 extern const char gpsbabel_version[];
 extern time_t gpsbabel_now;	/* gpsbabel startup-time; initialized in main.c with time() */
 extern time_t gpsbabel_time;	/* gpsbabel startup-time; initialized in main.c with current_time(), ! ZERO within testo ! */
@@ -251,7 +258,11 @@ public:
   QString utfstring;
 };
 
-class geocache_data
+/*
+ * Geocache data is shared between copies of a Waypoint and only
+ * duplicated when a copy asks for write access via AllocGCData().
+ */
+class geocache_data : public QSharedData
 {
 public:
   geocache_data() :
@@ -444,6 +455,31 @@ typedef struct {
 #define WAYPT_UNSET(wpt,member) wpt->wpt_flags.member = 0
 #define WAYPT_HAS(wpt,member) (wpt->wpt_flags.member)
 
+/*
+ * The text of a waypoint that is only passed through from input to
+ * output.  Most track points have none of it, so Waypoint keeps it
+ * behind a pointer that stays null until one of the fields is set.
+ */
+struct waypoint_text {
+  /*
+   * description is typically a human readable description of the
+   * waypoint.   It may be used as a comment field in some receivers.
+   * These are probably under 40 bytes, but that's only a guideline.
+   */
+  QString description;
+  /*
+   * notes are relatively long - over 100 characters - prose associated
+   * with the above.   Unlike shortname and description, these are never
+   * used to compute anything else and are strictly "passed through".
+   * Few formats support this.
+   */
+  QString notes;
+
+  UrlList urls;
+
+  QString icon_descr;
+};
+
 /*
  * This is a waypoint, as stored in the GPSR.   It tries to not
  * cater to any specific model or protocol.  Anything that needs to
@@ -454,14 +490,59 @@ class Waypoint
 {
 private:
   static geocache_data empty_gc_data;
+  static const waypoint_text empty_text;
 
 public:
   queue Q;			/* Master waypoint q.  Not for use
 					   by modules. */
 
+  /*
+   * The members are grouped so that the numeric data touched by
+   * filters and track_recompute() when walking a track shares the
+   * cache line following Q.  The rarely used members follow, and the
+   * text that is only passed through is kept out of line.
+   */
   double latitude;		/* Degrees */
   double longitude; 		/* Degrees */
   double altitude; 		/* Meters. */
+
+  /*
+   * Checking, comparing and shifting times works on this directly.
+   * For anything else use Get/SetCreationTime(), which convert to and
+   * from DateTime.
+   */
+  gpsbabel::TimeStamp creation_time;
+
+  float course;	/* Optional: degrees true */
+  float speed;   	/* Optional: meters per second. */
+  wp_flags wpt_flags;
+  unsigned char heartrate; /* Beats/min. likely to get moved to fs. */
+  unsigned char cadence;	 /* revolutions per minute */
+  float power; /* watts, as measured by cyclists */
+  float temperature; /* Degrees celsius */
+  float odometer_distance; /* Meters? */
+
+  /* Optional dilution of precision:  positional, horizontal, veritcal.
+   * 1 <= dop <= 50
+   */
+  float hdop;
+  float vdop;
+  float pdop;
+  fix_type fix;	/* Optional: 3d, 2d, etc. */
+  int  sat;	/* Optional: number of sats used for fix */
+
+  /*
+   * route priority is for use by the simplify filter.  If we have
+   * some reason to believe that the route point is more important,
+   * we can give it a higher (numerically; 0 is the lowest) priority.
+   * This causes it to be removed last.
+   * This is currently used by the saroute input filter to give named
+   * waypoints (representing turns) a higher priority.
+   * This is also used by the google input filter because they were
+   * nice enough to use exactly the same priority scheme.
+   */
+  int route_priority;
+
   double geoidheight;	/* Height (in meters) of geoid (mean sea level) above WGS84 earth ellipsoid. */
 
   /*
@@ -485,60 +566,20 @@ public:
    * 8 for Magellan and 10 for Vista.   These are only guidelines.
    */
   QString shortname;
-  /*
-   * description is typically a human readable description of the
-   * waypoint.   It may be used as a comment field in some receivers.
-   * These are probably under 40 bytes, but that's only a guideline.
-   */
-  QString description;
-  /*
-   * notes are relatively long - over 100 characters - prose associated
-   * with the above.   Unlike shortname and description, these are never
-   * used to compute anything else and are strictly "passed through".
-   * Few formats support this.
-   */
-  QString notes;
-
-  UrlList urls;
-
-  wp_flags wpt_flags;
-  QString icon_descr;
-
-  gpsbabel::DateTime creation_time;
-
-  /*
-   * route priority is for use by the simplify filter.  If we have
-   * some reason to believe that the route point is more important,
-   * we can give it a higher (numerically; 0 is the lowest) priority.
-   * This causes it to be removed last.
-   * This is currently used by the saroute input filter to give named
-   * waypoints (representing turns) a higher priority.
-   * This is also used by the google input filter because they were
-   * nice enough to use exactly the same priority scheme.
-   */
-  int route_priority;
 
-  /* Optional dilution of precision:  positional, horizontal, veritcal.
-   * 1 <= dop <= 50
-   */
-  float hdop;
-  float vdop;
-  float pdop;
-  float course;	/* Optional: degrees true */
-  float speed;   	/* Optional: meters per second. */
-  fix_type fix;	/* Optional: 3d, 2d, etc. */
-  int  sat;	/* Optional: number of sats used for fix */
-
-  unsigned char heartrate; /* Beats/min. likely to get moved to fs. */
-  unsigned char cadence;	 /* revolutions per minute */
-  float power; /* watts, as measured by cyclists */
-  float temperature; /* Degrees celsius */
-  float odometer_distance; /* Meters? */
+  /* Shared with copies of this waypoint, use AllocGCData() to modify. */
   geocache_data* gc_data;
   format_specific_data* fs;
   const session_t* session;	/* pointer to a session struct */
   void* extra_data;	/* Extra data added by, say, a filter. */
 
+  /* Null until one of its fields is set.  Not for use by modules,
+   * use the accessors below. */
+  waypoint_text* text;
+
+private:
+  waypoint_text* AllocText();
+
 public:
   Waypoint();
   ~Waypoint();
@@ -548,7 +589,15 @@ public:
   bool HasUrlLink() const;
   const UrlLink& GetUrlLink() const;
   [[deprecated]] const QList<UrlLink> GetUrlLinks() const;
+  const UrlList& GetUrlList() const;
   void AddUrlLink(const UrlLink& l);
+  void ClearUrlLinks();
+  const QString& GetDescription() const;
+  void SetDescription(const QString& s);
+  const QString& GetNotes() const;
+  void SetNotes(const QString& s);
+  const QString& GetIconDescr() const;
+  void SetIconDescr(const QString& s);
   QString CreationTimeXML() const;
   gpsbabel::DateTime GetCreationTime() const;
   void SetCreationTime(const gpsbabel::DateTime& t);
@@ -566,6 +615,7 @@ void waypt_init();
 void waypt_add(Waypoint* wpt);
 void waypt_del(Waypoint* wpt);
 unsigned int waypt_count();
+unsigned int waypt_session_count(const session_t* se);
 void set_waypt_count(unsigned int nc);
 void waypt_disp(const Waypoint* wpt);
 void waypt_status_disp(int total_ct, int myct);
@@ -599,8 +649,9 @@ template <typename T>
 void
 waypt_disp_session(const session_t* se, T cb)
 {
-  extern queue waypt_head;
+  extern thread_local queue waypt_head;
   int i = 0;
+  int total = global_opts.verbose_status ? waypt_session_count(se) : 0;
 #if NEWQ
   foreach (Waypoint* waypointp, waypt_list) {
 #else
@@ -611,7 +662,7 @@ waypt_disp_session(const session_t* se, T cb)
     if ((se == nullptr) || (waypointp->session == se)) {
       if (global_opts.verbose_status) {
         i++;
-        waypt_status_disp(waypt_count(), i);
+        waypt_status_disp(total, i);
       }
       cb(waypointp);
     }
@@ -661,6 +712,10 @@ public:
   gb_color line_color;         /* Optional line color for rendering */
   int line_width;         /* in pixels (sigh).  < 0 is unknown. */
   const session_t* session;	/* pointer to a session struct */
+  /* Statistics cached by track_recompute(), valid while trkdata_generation
+   * matches the current generation (see track_recompute_invalidate()). */
+  mutable computed_trkdata trkdata;
+  mutable unsigned int trkdata_generation;
 
 public:
   route_head();
@@ -709,6 +764,7 @@ void route_restore(queue* head_bak);
 void track_backup(signed int* count, queue** head_bak);
 void track_restore(queue* head_bak);
 computed_trkdata track_recompute(const route_head* trk);
+void track_recompute_invalidate();
 
 template <typename T>
 void
@@ -787,7 +843,7 @@ template <typename T1, typename T2, typename T3>
 void
 route_disp_all(T1 rh, T2 rt, T3 wc)
 {
-  extern queue my_route_head;
+  extern thread_local queue my_route_head;
 
   common_disp_all(&my_route_head, rh, rt, wc);
 }
@@ -796,7 +852,7 @@ template <typename T1, typename T2, typename T3>
 void
 track_disp_all(T1 rh, T2 rt, T3 wc)
 {
-  extern queue my_track_head;
+  extern thread_local queue my_track_head;
 
   common_disp_all(&my_track_head, rh, rt, wc);
 }
@@ -825,13 +881,13 @@ geocache_container gs_mkcont(const QString& t);
  * This is an opaque pointer.  Callers must not fondle the contents of it.
  */
 // This is a crutch until the new C++ shorthandle goes in.
-#define PRIME 37
+struct mkshort_namelist;
 typedef struct {
   unsigned int target_len;
   char* badchars;
   char* goodchars;
   char* defname;
-  queue namelist[PRIME];
+  mkshort_namelist* namelist;
 
   /* Various internal flags at end to allow alignment flexibility. */
   unsigned int mustupper:1;
@@ -973,6 +1029,21 @@ extern style_vecs_t style_list[];
 [[noreturn]] void fatal(const char*, ...) PRINTFLIKE(1, 2);
 void is_fatal(int condition, const char*, ...) PRINTFLIKE(2, 3);
 void warning(const char*, ...) PRINTFLIKE(1, 2);
+/* The same for a message built with the stream operators of src/core/logging.h. */
+class LogMessage;
+[[noreturn]] void fatal(const LogMessage& msg);
+void warning(const LogMessage& msg);
+
+/*
+ * While a log is set with fatal_capture(), warnings are appended to it and
+ * fatal() throws a FatalError instead of exiting.  This lets the library
+ * report a failed conversion to its caller.
+ */
+struct FatalError {
+  QString message;
+};
+void fatal_capture(QString* log);
+
 void debug_print(int level, const char* fmt, ...) PRINTFLIKE(2,3);
 
 ff_vecs_t* find_vec(const char*, const char**);
@@ -980,8 +1051,8 @@ void assign_option(const char* vecname, arglist_t* ap, const char* val);
 void disp_vec_options(const char* vecname, arglist_t* ap);
 void disp_vecs();
 void disp_vec(const char* vecname);
-void init_vecs();
 void exit_vecs();
+void exit_thread_vecs();
 void disp_formats(int version);
 const char* name_option(uint32_t type);
 void printposn(double c, int is_lat);
@@ -1033,6 +1104,8 @@ char* strlower(char* src);
 signed int get_tz_offset();
 time_t mklocaltime(struct tm* t);
 time_t mkgmtime(struct tm* t);
+struct tm* gb_gmtime_r(const time_t* t, struct tm* result);
+struct tm* gb_localtime_r(const time_t* t, struct tm* result);
 gpsbabel::DateTime current_time();
 void dotnet_time_to_time_t(double dotnet, time_t* t, int* millisecs);
 signed int month_lookup(const char* m);
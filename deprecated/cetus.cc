@@ -592,7 +592,7 @@ data_write(void)
   int i, ct = waypt_count();
   struct hdr* htable, *bh;
   queue* elem, *tmp;
-  extern queue waypt_head;
+  extern thread_local queue waypt_head;
   waypoint* waypointp;
   mkshort_wr_handle = mkshort_new_handle();
   setshort_length(mkshort_wr_handle, 15);
@@ -209,7 +209,7 @@ data_write(void)
   int i, ct = waypt_count();
   struct hdr *htable, *bh;
   queue *elem, *tmp;
-  extern queue waypt_head;
+  extern thread_local queue waypt_head;
   waypoint *waypointp;
 
   if (dbname) {
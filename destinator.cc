@@ -167,7 +167,7 @@ destinator_read_poi()
     Waypoint* wpt = new Waypoint;
 
     wpt->shortname = read_wcstr(0);
-    wpt->notes = read_wcstr(0);		/* comment */
+    wpt->SetNotes(read_wcstr(0));		/* comment */
 
     QString hnum = read_wcstr(0);			/* house number */
 
@@ -239,7 +239,7 @@ destinator_read_rte()
     Waypoint* wpt = new Waypoint;
 
     wpt->shortname = read_wcstr(0);
-    wpt->notes = read_wcstr(0);
+    wpt->SetNotes(read_wcstr(0));
 
     (void) gbfgetint32(fin);
     (void) gbfgetdbl(fin);
@@ -378,7 +378,7 @@ destinator_wpt_disp(const Waypoint* wpt)
 
   write_wcstr(DST_DYN_POI);
   write_wcstr((!wpt->shortname.isEmpty()) ? wpt->shortname : "WPT");
-  write_wcstr((!wpt->notes.isEmpty()) ? wpt->notes : wpt->description);
+  write_wcstr((!wpt->GetNotes().isEmpty()) ? wpt->GetNotes() : wpt->GetDescription());
 
   write_wcstr(nullptr);				/* house number */
   write_wcstr(GMSD_GET(addr, NULL));		/* street */
@@ -447,7 +447,7 @@ destinator_rtept_disp(const Waypoint* wpt)
 {
   write_wcstr(DST_ITINERARY);
   write_wcstr((!wpt->shortname.isEmpty()) ? wpt->shortname : "RTEPT");
-  write_wcstr((!wpt->notes.isEmpty()) ? wpt->notes : wpt->description);
+  write_wcstr((!wpt->GetNotes().isEmpty()) ? wpt->GetNotes() : wpt->GetDescription());
 
   gbfputint32(0, fout);
   gbfputdbl(0, fout);
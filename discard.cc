@@ -77,13 +77,13 @@ void DiscardFilter::fix_process_wpt(const Waypoint* wpt)
   if (nameopt && name_regex.indexIn(waypointp->shortname) >= 0) {
     del = 1;
   }
-  if (descopt && desc_regex.indexIn(waypointp->description) >= 0) {
+  if (descopt && desc_regex.indexIn(waypointp->GetDescription()) >= 0) {
     del = 1;
   }
-  if (cmtopt && cmt_regex.indexIn(waypointp->notes) >= 0) {
+  if (cmtopt && cmt_regex.indexIn(waypointp->GetNotes()) >= 0) {
     del = 1;
   }
-  if (iconopt && icon_regex.indexIn(waypointp->icon_descr) >= 0) {
+  if (iconopt && icon_regex.indexIn(waypointp->GetIconDescr()) >= 0) {
     del = 1;
   }
 
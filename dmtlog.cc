@@ -505,8 +505,8 @@ read_CTrackFile(const int version)
 
       gbfseek(fin, 36, SEEK_CUR);	/* skip unknown 36 bytes */
 
-      wpt->notes = read_str(fin);
-      wpt->description = read_str(fin);
+      wpt->SetNotes(read_str(fin));
+      wpt->SetDescription(read_str(fin));
       (void) gbfgetint16(fin);
 
       waypt_add(wpt);
@@ -541,7 +541,7 @@ read_CTrackFile(const int version)
       if (name && *name) {
         switch (i) {
         case 0:
-          wpt->description = name;
+          wpt->SetDescription(name);
           break;
         case 1:
           wpt->shortname = name;
@@ -773,12 +773,12 @@ wpt_cb(const Waypoint* wpt)
   gbfputdbl(wpt->altitude != unknown_alt ? wpt->altitude : 0, fout);
 
   int names = 1;
-  if (!wpt->description.isEmpty()) {
+  if (!wpt->GetDescription().isEmpty()) {
     names = 2;
   }
   gbfputint32(names, fout);
   if (names > 1) {
-    write_str(wpt->description, fout);
+    write_str(wpt->GetDescription(), fout);
   }
   write_str(wpt->shortname.isEmpty() ? "Name" : wpt->shortname, fout);
 }
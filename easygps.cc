@@ -89,10 +89,10 @@ data_read()
         break;
       case 2:
       case 3:
-        wpt_tmp->description = gbfgetpstr(file_in);
+        wpt_tmp->SetDescription(gbfgetpstr(file_in));
         break;
       case 5:
-        wpt_tmp->notes = gbfgetpstr(file_in);
+        wpt_tmp->SetNotes(gbfgetpstr(file_in));
         break;
       case 6: {
         QString ult = gbfgetpstr(file_in);
@@ -101,11 +101,11 @@ data_read()
       break;
       case 7: {
         QString id = gbfgetpstr(file_in);
-        wpt_tmp->icon_descr = id;
+        wpt_tmp->SetIconDescr(id);
       }
       break;
       case 8:  /* NULL Terminated (vs. pascal) descr */
-        wpt_tmp->notes = gbfgetcstr(file_in);
+        wpt_tmp->SetNotes(gbfgetcstr(file_in));
         break;
       case 9: { /* NULL Terminated (vs. pascal) link */
         QString url = gbfgetcstr(file_in);
@@ -156,22 +156,22 @@ ez_disp(const Waypoint* wpt)
     gbfputc(1, file_out);
     gbfputpstr(wpt->shortname, file_out);
   }
-  if (!wpt->description.isEmpty()) {
+  if (!wpt->GetDescription().isEmpty()) {
     gbfputc(3, file_out);
-    gbfputpstr(wpt->description, file_out);
+    gbfputpstr(wpt->GetDescription(), file_out);
   }
-  if (!wpt->icon_descr.isNull()) {
+  if (!wpt->GetIconDescr().isNull()) {
     gbfputc(7, file_out);
-    gbfputpstr(wpt->icon_descr, file_out);
+    gbfputpstr(wpt->GetIconDescr(), file_out);
   }
   gbfputc(0x63, file_out);
   gbfputdbl(wpt->latitude, file_out);
 
   gbfputc(0x64, file_out);
   gbfputdbl(wpt->longitude, file_out);
-  if (!wpt->notes.isEmpty()) {
+  if (!wpt->GetNotes().isEmpty()) {
     gbfputc(5, file_out);
-    gbfputpstr(wpt->notes, file_out);
+    gbfputpstr(wpt->GetNotes(), file_out);
   }
   if (wpt->HasUrlLink()) {
     UrlLink link = wpt->GetUrlLink();
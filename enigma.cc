@@ -116,7 +116,7 @@ data_read()
     xfree(sn);
 
     char* ds = xstrndup(ewpt.longname, ewpt.longname_len);
-    wpt->description = ds;
+    wpt->SetDescription(ds);
     xfree(ds);
 
     switch (ewpt.waypoint_type) {
@@ -183,9 +183,9 @@ enigma_waypt_disp(const Waypoint* wpt)
     ewpt.shortname_len = (uint8_t) min(6, strlen(CSTRc(wpt->shortname)));
     strncpy(ewpt.shortname, CSTRc(wpt->shortname), 6);
   }
-  if (wpt->description != nullptr) {
-    ewpt.longname_len = (uint8_t) min(27, strlen(CSTRc(wpt->description)));
-    strncpy(ewpt.longname, CSTRc(wpt->description), 27);
+  if (wpt->GetDescription() != nullptr) {
+    ewpt.longname_len = (uint8_t) min(27, strlen(CSTRc(wpt->GetDescription())));
+    strncpy(ewpt.longname, CSTRc(wpt->GetDescription()), 27);
   }
   gbfwrite(&ewpt, sizeof(ewpt), 1, file_out);
 }
@@ -39,14 +39,19 @@
 #include "gbfile.h"                // for gbfile, gbfclose, gbfcopyfrom, gbfseek, gbfwrite, gbfopen_be, gbftell, gbfputuint16, gbfputuint32, gbfgetuint16, gbfgetuint32, gbfread, gbfrewind, gbfgetflt
 #include "jeeps/gpsmath.h"         // for GPS_Math_WGS84_To_Known_Datum_M
 #include "src/core/datetime.h"     // for DateTime
+#include "src/core/timeindex.h"    // for TimeIndex
 #include <QtCore/QByteArray>       // for QByteArray
 #include <QtCore/QDate>            // for QDate
 #include <QtCore/QDateTime>        // for QDateTime
+#include <QtCore/QDir>             // for QDir, QDir::Files, QDir::IgnoreCase, QDir::Name
 #include <QtCore/QFile>            // for QFile
+#include <QtCore/QFileInfo>        // for QFileInfo
+#include <QtCore/QIODevice>        // for QIODevice, QIODevice::ReadOnly, QIODevice::Text
 #include <QtCore/QList>            // for QList<>::iterator, QList
 #include <QtCore/QPair>            // for QPair
 #include <QtCore/QRegExp>          // for QRegExp
 #include <QtCore/QString>          // for QString
+#include <QtCore/QStringList>      // for QStringList
 #include <QtCore/QTextCodec>       // for QTextCodec
 #include <QtCore/QTime>            // for QTime
 #include <QtCore/QVariant>         // for QVariant
@@ -190,14 +195,17 @@ static QList<ExifApp>* exif_apps;
 static ExifApp* exif_app;
 static const Waypoint* exif_wpt_ref;
 static QDateTime exif_time_ref;
+static gpsbabel::TimeIndex exif_time_index;
 static char exif_success;
 static QString exif_fout_name;
+static QStringList exif_batch_files;
 
-static char* opt_filename, *opt_overwrite, *opt_frame, *opt_name;
+static char* opt_filename, *opt_overwrite, *opt_frame, *opt_name, *opt_batch;
 
 static uint8_t writer_gps_tag_version[4] = {2, 0, 0, 0};
 
 static arglist_t exif_args[] = {
+  { "batch", &opt_batch, "Tag all images in a directory or list file", nullptr, ARGTYPE_BOOL, ARG_NOMINMAX, nullptr },
   { "filename", &opt_filename, "Set waypoint name to source filename", "Y", ARGTYPE_BOOL, ARG_NOMINMAX, nullptr },
   { "frame", &opt_frame, "Time-frame (in seconds)", "10", ARGTYPE_INT, "0", nullptr, nullptr },
   { "name", &opt_name, "Locate waypoint for tagging by this name", nullptr, ARGTYPE_STRING, ARG_NOMINMAX, nullptr },
@@ -965,7 +973,7 @@ exif_waypt_from_exif_app(ExifApp* app)
   if (tag && (tag->size > 8)) {
     // TODO: User comments with JIS and Undefined Code Designations are ignored.
     if (memcmp(tag->data.at(0).toByteArray().constData(), "ASCII\0\0\0", 8) == 0) {
-      wpt->notes = QString::fromLatin1(tag->data.at(0).toByteArray().constData() + 8, tag->size - 8);
+      wpt->SetNotes(QString::fromLatin1(tag->data.at(0).toByteArray().constData() + 8, tag->size - 8));
     } else if (memcmp(tag->data.at(0).toByteArray().constData(), "UNICODE\0", 8) == 0) {
       QTextCodec* utf16_codec;
       if (app->fcache->big_endian) {
@@ -973,7 +981,7 @@ exif_waypt_from_exif_app(ExifApp* app)
       } else {
         utf16_codec = QTextCodec::codecForName("UTF-16LE");
       }
-      wpt->notes = utf16_codec->toUnicode(tag->data.at(0).toByteArray().constData() + 8, tag->size - 8);
+      wpt->SetNotes(utf16_codec->toUnicode(tag->data.at(0).toByteArray().constData() + 8, tag->size - 8));
     }
   }
 
@@ -1218,17 +1226,9 @@ exif_remove_tag(const int ifd_nr, const int tag_id)
 }
 
 static void
-exif_find_wpt_by_time(const Waypoint* wpt)
+exif_index_wpt(const Waypoint* wpt)
 {
-  if (!wpt->creation_time.isValid()) {
-    return;
-  }
-
-  if (exif_wpt_ref == nullptr) {
-    exif_wpt_ref = wpt;
-  } else if (labs(exif_time_ref.msecsTo(wpt->creation_time)) < labs(exif_time_ref.msecsTo(exif_wpt_ref->creation_time))) {
-    exif_wpt_ref = wpt;
-  }
+  exif_time_index.add(wpt);
 }
 
 static void
@@ -1513,8 +1513,22 @@ exif_read()
   }
 }
 
-static void
-exif_wr_init(const QString& fname)
+/*
+ * In batch mode a bad image is reported and skipped, otherwise it
+ * ends the program as before.
+ */
+static bool
+exif_wr_reject(const QString& fname, const char* reason)
+{
+  if (opt_batch) {
+    warning(MYNAME ": %s: %s, skipped.\n", qPrintable(fname), reason);
+    return false;
+  }
+  fatal(MYNAME ": %s: %s.\n", qPrintable(fname), reason);
+}
+
+static bool
+exif_wr_open(const QString& fname)
 {
   exif_success = 0;
   exif_fout_name = fname;
@@ -1525,26 +1539,34 @@ exif_wr_init(const QString& fname)
   is_fatal(fin->is_pipe, MYNAME ": Sorry, this format cannot be used with pipes!");
 
   uint16_t soi = gbfgetuint16(fin);
-  is_fatal(soi != 0xFFD8, MYNAME ": Unknown image file.");
+  if (soi != 0xFFD8) {
+    gbfclose(fin);
+    exif_release_apps();
+    return exif_wr_reject(fname, "Unknown image file");
+  }
   exif_app = exif_load_apps();
-  is_fatal(exif_app == nullptr, MYNAME ": No EXIF header found in source file \"%s\".", fin->name);
-  exif_examine_app(exif_app);
   gbfclose(fin);
+  if (exif_app == nullptr) {
+    exif_release_apps();
+    return exif_wr_reject(fname, "No EXIF header found in source file");
+  }
+  exif_examine_app(exif_app);
 
   exif_time_ref = exif_get_exif_time(exif_app);
   if (!exif_time_ref.isValid()) {
-    fatal(MYNAME ": No valid timestamp found in picture!\n");
+    exif_release_apps();
+    return exif_wr_reject(fname, "No valid timestamp found in picture");
   }
 
   QString filename(fname);
   filename += ".jpg";
   fout = gbfopen_be(filename, "wb", MYNAME);
+  return true;
 }
 
 static void
-exif_wr_deinit()
+exif_wr_close()
 {
-
   exif_release_apps();
   QString tmpname = QString(fout->name);
   gbfclose(fout);
@@ -1561,8 +1583,69 @@ exif_wr_deinit()
   exif_fout_name.clear();
 }
 
+/*
+ * The batch source is either a directory, of which all JPEG files are
+ * tagged, or a text file listing one image per line.  Relative names in
+ * a list file are taken relative to the list file.
+ */
 static void
-exif_write()
+exif_batch_init(const QString& fname)
+{
+  QFileInfo info(fname);
+
+  if (info.isDir()) {
+    QDir dir(fname);
+    const QStringList names = dir.entryList(QStringList() << "*.jpg" << "*.jpeg",
+                                            QDir::Files, QDir::Name | QDir::IgnoreCase);
+    for (const auto& name : names) {
+      /* Leave out "x.jpg.jpg" next to "x.jpg", written by an earlier run. */
+      if (name.endsWith(".jpg", Qt::CaseInsensitive) &&
+          names.contains(name.left(name.size() - 4), Qt::CaseInsensitive)) {
+        continue;
+      }
+      exif_batch_files.append(dir.filePath(name));
+    }
+  } else {
+    QFile list(fname);
+    if (!list.open(QIODevice::ReadOnly | QIODevice::Text)) {
+      fatal(MYNAME ": Cannot open image list \"%s\".\n", qPrintable(fname));
+    }
+    QDir dir = info.absoluteDir();
+    while (!list.atEnd()) {
+      QString name = QString::fromUtf8(list.readLine()).trimmed();
+      if (!name.isEmpty()) {
+        exif_batch_files.append(dir.filePath(name));
+      }
+    }
+  }
+
+  if (exif_batch_files.isEmpty()) {
+    warning(MYNAME ": No images found in \"%s\".\n", qPrintable(fname));
+  }
+}
+
+static void
+exif_wr_init(const QString& fname)
+{
+  if (opt_batch) {
+    exif_batch_init(fname);
+  } else {
+    exif_wr_open(fname);
+  }
+}
+
+static void
+exif_wr_deinit()
+{
+  if (!opt_batch) {
+    exif_wr_close();
+  }
+  exif_batch_files.clear();
+  exif_time_index.clear();
+}
+
+static void
+exif_tag_image()
 {
   exif_wpt_ref = nullptr;
 
@@ -1578,21 +1661,24 @@ exif_write()
       warning(MYNAME ": No matching point with name \"%s\" found.\n", opt_name);
     }
   } else {
-    track_disp_all(nullptr, nullptr, exif_find_wpt_by_time);
-    route_disp_all(nullptr, nullptr, exif_find_wpt_by_time);
-    waypt_disp_all(exif_find_wpt_by_time);
+    if (exif_time_index.isEmpty()) {
+      track_disp_all(nullptr, nullptr, exif_index_wpt);
+      route_disp_all(nullptr, nullptr, exif_index_wpt);
+      waypt_disp_all(exif_index_wpt);
+    }
+    exif_wpt_ref = exif_time_index.nearest(exif_time_ref.toMSecsSinceEpoch());
 
     qint64 frame = atoi(opt_frame);
 
     if (exif_wpt_ref == nullptr) {
       warning(MYNAME ": No point with a valid timestamp found.\n");
-    } else if (labs(exif_time_ref.secsTo(exif_wpt_ref->creation_time)) > frame) {
+    } else if (labs(exif_time_ref.secsTo(exif_wpt_ref->GetCreationTime())) > frame) {
       QString str = exif_time_str(exif_time_ref);
       warning(MYNAME ": No matching point found for image date %s!\n", qPrintable(str));
       if (exif_wpt_ref != nullptr) {
-        QString str = exif_time_str(exif_wpt_ref->creation_time);
+        QString str = exif_time_str(exif_wpt_ref->GetCreationTime());
         warning(MYNAME ": Best is from %s, %ld second(s) away.\n",
-                qPrintable(str), labs(exif_time_ref.secsTo(exif_wpt_ref->creation_time)));
+                qPrintable(str), labs(exif_time_ref.secsTo(exif_wpt_ref->GetCreationTime())));
       }
       exif_wpt_ref = nullptr;
     }
@@ -1669,6 +1755,44 @@ exif_write()
 
 }
 
+/*
+ * In batch mode the track is read and indexed once and all images are
+ * tagged in this one run.
+ */
+static void
+exif_write()
+{
+  if (!opt_batch) {
+    exif_tag_image();
+    return;
+  }
+
+  int tagged = 0;
+  for (const auto& fname : qAsConst(exif_batch_files)) {
+    if (!QFileInfo(fname).isFile()) {
+      exif_wr_reject(fname, "No such file");
+      continue;
+    }
+    if (!exif_wr_open(fname)) {
+      continue;
+    }
+    exif_tag_image();
+    if (exif_success) {
+      tagged++;
+      if (global_opts.debug_level >= 1) {
+        printf(MYNAME ": %s: tagged.\n", qPrintable(fname));
+      }
+    } else {
+      warning(MYNAME ": %s: not tagged.\n", qPrintable(fname));
+    }
+    exif_wr_close();
+  }
+
+  if (global_opts.debug_level >= 1) {
+    printf(MYNAME ": %d of %d image(s) tagged.\n", tagged, exif_batch_files.size());
+  }
+}
+
 /**************************************************************************/
 
 ff_vecs_t exif_vecs = {
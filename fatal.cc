@@ -20,13 +20,28 @@
  */
 
 #include "defs.h"
+#include "src/core/logging.h"
 #include <cstdio>
 #include <cstdlib>
+
+static thread_local QString* capture_log = nullptr;
+
+void
+fatal_capture(QString* log)
+{
+  capture_log = log;
+}
+
 [[noreturn]] void
 fatal(const char* fmt, ...)
 {
   va_list ap;
   va_start(ap, fmt);
+  if (capture_log) {
+    FatalError error{QString::vasprintf(fmt, ap)};
+    va_end(ap);
+    throw error;
+  }
   vfprintf(stderr, fmt, ap);
   va_end(ap);
   exit(1);
@@ -37,10 +52,26 @@ warning(const char* fmt, ...)
 {
   va_list ap;
   va_start(ap, fmt);
-  vfprintf(stderr, fmt, ap);
+  if (capture_log) {
+    capture_log->append(QString::vasprintf(fmt, ap));
+  } else {
+    vfprintf(stderr, fmt, ap);
+  }
   va_end(ap);
 }
 
+[[noreturn]] void
+fatal(const LogMessage& msg)
+{
+  fatal("%s\n", msg.str().toLocal8Bit().constData());
+}
+
+void
+warning(const LogMessage& msg)
+{
+  warning("%s\n", msg.str().toLocal8Bit().constData());
+}
+
 void
 debug_print(int level, const char* fmt, ...)
 {
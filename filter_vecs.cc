@@ -53,27 +53,27 @@ typedef struct {
   const char* desc;
 } fl_vecs_t;
 
-ArcDistanceFilter arcdist;
-BendFilter bend;
-DiscardFilter discard;
-DuplicateFilter duplicate;
-HeightFilter height;
-InterpolateFilter interpolate;
-NukeDataFilter nukedata;
-PolygonFilter polygon;
-PositionFilter position;
-RadiusFilter radius;
-ReverseRouteFilter reverse_route;
-SimplifyRouteFilter routesimple;
-SortFilter sort;
-StackFilter stackfilt;
-SwapDataFilter swapdata;
-TrackFilter trackfilter;
-TransformFilter transform;
-ValidateFilter validate;
-
-
-static
+thread_local ArcDistanceFilter arcdist;
+thread_local BendFilter bend;
+thread_local DiscardFilter discard;
+thread_local DuplicateFilter duplicate;
+thread_local HeightFilter height;
+thread_local InterpolateFilter interpolate;
+thread_local NukeDataFilter nukedata;
+thread_local PolygonFilter polygon;
+thread_local PositionFilter position;
+thread_local RadiusFilter radius;
+thread_local ReverseRouteFilter reverse_route;
+thread_local SimplifyRouteFilter routesimple;
+thread_local SortFilter sort;
+thread_local StackFilter stackfilt;
+thread_local SwapDataFilter swapdata;
+thread_local TrackFilter trackfilter;
+thread_local TransformFilter transform;
+thread_local ValidateFilter validate;
+
+
+static thread_local
 fl_vecs_t filter_vec_list[] = {
 #if FILTERS_ENABLED
     {
@@ -31,10 +31,10 @@
 
 #if NEWQ
 #include <QtCore/QList>
-extern QList<Waypoint*> waypt_list;
+extern thread_local QList<Waypoint*> waypt_list;
 #else
 #include "queue.h"
-extern queue waypt_head;
+extern thread_local queue waypt_head;
 #endif
 #include "filter.h"
 
@@ -112,12 +112,11 @@ parse_line(char* buff, int index, const char* delimiter, Waypoint* wpt)
       break;
 
     case WAYPT__OFS + 1:
-      wpt->description = (cin);
+      wpt->SetDescription(cin);
       break;
 
     case WAYPT__OFS + 2:
-      wpt->icon_descr = gt_find_desc_from_icon_number(
-                          atoi(cin), PCX);
+      wpt->SetIconDescr(gt_find_desc_from_icon_number(atoi(cin), PCX));
       break;
 
     case WAYPT__OFS + 4:
@@ -461,8 +460,7 @@ data_read()
       }
       if (*cdata == ';') {
         cdata++;
-        wpt->icon_descr = gt_find_desc_from_icon_number(
-                            atoi(cdata), PCX);
+        wpt->SetIconDescr(gt_find_desc_from_icon_number(atoi(cdata), PCX));
       }
       waypt_add(wpt);
       break;
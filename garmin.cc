@@ -394,17 +394,15 @@ waypt_read()
     Waypoint* wpt_tmp = new Waypoint;
 
     wpt_tmp->shortname = QString::fromLatin1(way[i]->ident);
-    wpt_tmp->description = QString::fromLatin1(way[i]->cmnt);
+    wpt_tmp->SetDescription(QString::fromLatin1(way[i]->cmnt));
     wpt_tmp->shortname = wpt_tmp->shortname.simplified();
-    wpt_tmp->description = wpt_tmp->description.simplified();
+    wpt_tmp->SetDescription(wpt_tmp->GetDescription().simplified());
     wpt_tmp->longitude = way[i]->lon;
     wpt_tmp->latitude = way[i]->lat;
     if (gps_waypt_type == 103) {
-      wpt_tmp->icon_descr = d103_symbol_from_icon_number(
-                              way[i]->smbl);
+      wpt_tmp->SetIconDescr(d103_symbol_from_icon_number(way[i]->smbl));
     } else {
-      wpt_tmp->icon_descr = gt_find_desc_from_icon_number(
-                              way[i]->smbl, PCX);
+      wpt_tmp->SetIconDescr(gt_find_desc_from_icon_number(way[i]->smbl, PCX));
     }
     /*
      * If a unit doesn't store altitude info (i.e. a D103)
@@ -911,10 +909,10 @@ waypoint_prepare()
   int i;
   int n = waypt_count();
 #if NEWQ
-  extern QList<Waypoint*> waypt_list;
+  extern thread_local QList<Waypoint*> waypt_list;
 #else
   queue* elem, *tmp;
-  extern queue waypt_head;
+  extern thread_local queue waypt_head;
 #endif
   int icon;
 
@@ -936,11 +934,11 @@ waypoint_prepare()
     char obuf[256];
 
     QString src;
-    if (!wpt->description.isEmpty()) {
-      src = wpt->description;
+    if (!wpt->GetDescription().isEmpty()) {
+      src = wpt->GetDescription();
     }
-    if (!wpt->notes.isEmpty()) {
-      src = wpt->notes;
+    if (!wpt->GetNotes().isEmpty()) {
+      src = wpt->GetNotes();
     }
 
     /*
@@ -963,9 +961,9 @@ waypoint_prepare()
 
     // If we were explictly given a comment from GPX, use that.
     //  This logic really is horrible and needs to be untangled.
-    if (!wpt->description.isEmpty() &&
+    if (!wpt->GetDescription().isEmpty() &&
         global_opts.smart_names && !wpt->gc_data->diff) {
-      memcpy(tx_waylist[i]->cmnt, CSTRc(wpt->description), strlen(CSTRc(wpt->description)));
+      memcpy(tx_waylist[i]->cmnt, CSTRc(wpt->GetDescription()), strlen(CSTRc(wpt->GetDescription())));
     } else {
       if (global_opts.smart_names &&
           wpt->gc_data->diff && wpt->gc_data->terr) {
@@ -990,7 +988,7 @@ waypoint_prepare()
       if (get_cache_icon(wpt)) {
         icon = gt_find_icon_number_from_desc(get_cache_icon(wpt), PCX);
       } else {
-        icon = gt_find_icon_number_from_desc(wpt->icon_descr, PCX);
+        icon = gt_find_icon_number_from_desc(wpt->GetIconDescr(), PCX);
       }
     }
 
@@ -998,7 +996,7 @@ waypoint_prepare()
      * overwrite that and go very literal.
      */
     if (gps_waypt_type == 103) {
-      icon = d103_icon_number_from_symbol(wpt->icon_descr);
+      icon = d103_icon_number_from_symbol(wpt->GetIconDescr());
     }
     tx_waylist[i]->smbl = icon;
     if (wpt->altitude == unknown_alt) {
@@ -1076,7 +1074,7 @@ route_waypt_pr(const Waypoint* wpt)
 
   rte->lon = wpt->longitude;
   rte->lat = wpt->latitude;
-  rte->smbl = gt_find_icon_number_from_desc(wpt->icon_descr, PCX);
+  rte->smbl = gt_find_icon_number_from_desc(wpt->GetIconDescr(), PCX);
 
   // map class so unit doesn't duplicate routepoints as a waypoint.
   rte->wpt_class = 0x80;
@@ -1100,10 +1098,10 @@ route_waypt_pr(const Waypoint* wpt)
   }
 
   rte->ident[sizeof(rte->ident)-1] = 0;
-  if (wpt->description.isEmpty()) {
+  if (wpt->GetDescription().isEmpty()) {
     rte->cmnt[0] = 0;
   } else {
-    strncpy(rte->cmnt, CSTR(wpt->description), sizeof(rte->cmnt));
+    strncpy(rte->cmnt, CSTR(wpt->GetDescription()), sizeof(rte->cmnt));
     rte->cmnt[sizeof(rte->cmnt)-1] = 0;
   }
   cur_tx_routelist_entry++;
@@ -22,7 +22,10 @@
  */
 
 #include "defs.h"
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <vector>
 
 #define MYNAME "fit"
 
@@ -86,11 +89,44 @@ typedef struct {
   int type;
 } fit_field_t;
 
+// What a field of a data message is stored into
+typedef enum {
+  kTargetNone,
+  kTargetTimestamp,
+  kTargetGlobalUtcOffset,
+  kTargetLatitude,
+  kTargetLongitude,
+  kTargetAltitude,
+  kTargetHeartRate,
+  kTargetCadence,
+  kTargetSpeed,
+  kTargetPower,
+  kTargetTemperature,
+  kTargetStartTime,
+  kTargetStartLatitude,
+  kTargetStartLongitude,
+  kTargetEndLatitude,
+  kTargetEndLongitude,
+  kTargetEvent,
+  kTargetEventType
+} fit_target;
+
+// One step of the plan to decode a data message, compiled from the
+// definition message.  size is 1, 2 or 4 for a value we read, or 0
+// for array or unknown data, which is decoded as 0xffffffff.
+typedef struct {
+  int offset;
+  int size;
+  fit_target target;
+} fit_decode_step;
+
 typedef struct {
   int endian;
   int global_id;
   int num_fields;
   fit_field_t* fields;
+  int record_size;
+  std::vector<fit_decode_step> plan;
 } fit_message_def;
 
 static struct {
@@ -100,6 +136,7 @@ static struct {
   uint32_t last_timestamp;
   uint32_t global_utc_offset;
   fit_message_def message_def[16];
+  std::vector<uint8_t> record;
 } fit_data;
 
 static	gbfile* fin;
@@ -123,7 +160,10 @@ fit_rd_deinit()
       xfree(def->fields);
       def->fields = nullptr;
     }
+    def->plan.clear();
+    def->record_size = 0;
   }
+  fit_data.record.clear();
 
   gbfclose(fin);
 }
@@ -236,6 +276,180 @@ fit_getuint32()
 
 }
 
+/*******************************************************************************
+* fit_field_target- where a field of a message ends up, if anywhere
+*******************************************************************************/
+static fit_target
+fit_field_target(int global_id, int field_id)
+{
+  if (field_id == kFieldTimestamp) {
+    return kTargetTimestamp;
+  }
+
+  switch (global_id) {
+  case kIdDeviceSettings: // device settings message
+    switch (field_id) {
+    case kFieldGlobalUtcOffset:
+      return kTargetGlobalUtcOffset;
+    default:
+      if (global_opts.debug_level >= 1) {
+        debug_print(1, "%s: unrecognized data type in GARMIN FIT device settings: f->id=%d\n", MYNAME, field_id);
+      }
+      return kTargetNone;
+    }
+
+  case kIdRecord: // record message - trkType is a track
+    switch (field_id) {
+    case kFieldLatitude:
+      return kTargetLatitude;
+    case kFieldLongitude:
+      return kTargetLongitude;
+    case kFieldAltitude:
+    case kFieldEnhancedAltitude:
+      return kTargetAltitude;
+    case kFieldHeartRate:
+      return kTargetHeartRate;
+    case kFieldCadence:
+      return kTargetCadence;
+    case kFieldDistance:
+      // NOTE: 5 is DISTANCE in cm ... unused.
+      return kTargetNone;
+    case kFieldSpeed:
+    case kFieldEnhancedSpeed:
+      return kTargetSpeed;
+    case kFieldPower:
+      return kTargetPower;
+    case kFieldTemperature:
+      return kTargetTemperature;
+    default:
+      if (global_opts.debug_level >= 1) {
+        debug_print(1, "%s: unrecognized data type in GARMIN FIT record: f->id=%d\n", MYNAME, field_id);
+      }
+      return kTargetNone;
+    }
+
+  case kIdLap: // lap wptType , endlat+lon is wpt
+    switch (field_id) {
+    case kFieldStartTime:
+      return kTargetStartTime;
+    case kFieldStartLatitude:
+      return kTargetStartLatitude;
+    case kFieldStartLongitude:
+      return kTargetStartLongitude;
+    case kFieldEndLatitude:
+      return kTargetEndLatitude;
+    case kFieldEndLongitude:
+      return kTargetEndLongitude;
+    case kFieldElapsedTime:
+    case kFieldTotalDistance:
+      return kTargetNone;
+    default:
+      if (global_opts.debug_level >= 1) {
+        debug_print(1, "%s: unrecognized data type in GARMIN FIT lap: f->id=%d\n", MYNAME, field_id);
+      }
+      return kTargetNone;
+    }
+
+  case kIdEvent:
+    switch (field_id) {
+    case kFieldEvent:
+      return kTargetEvent;
+    case kFieldEventType:
+      return kTargetEventType;
+    default:
+      return kTargetNone;
+    }
+
+  default:
+    if (global_opts.debug_level >= 1) {
+      debug_print(1, "%s: unrecognized/unhandled global ID for GARMIN FIT: %d\n", MYNAME, global_id);
+    }
+    return kTargetNone;
+  }
+}
+
+/*******************************************************************************
+* fit_compile_plan- turn a definition message into a decode plan, so that
+* data messages don't have to be interpreted field by field
+*******************************************************************************/
+static void
+fit_compile_plan(fit_message_def* def)
+{
+  /* https://forums.garmin.com/showthread.php?223645-Vivoactive-problems-plus-suggestions-for-future-firmwares&p=610929#post610929
+   * Per section 4.2.1.4.2 of the FIT Protocol the size of a field may be a
+   * multiple of the size of the underlying type, indicating the field
+   * contains multiple elements represented as an array.
+   *
+   * Garmin Product Support
+   */
+  // In the case that the field contains one value of the indicated type we read that value,
+  // otherwise we just skip over the data.
+  def->plan.clear();
+  def->record_size = 0;
+  for (int i = 0; i < def->num_fields; i++) {
+    const fit_field_t* f = &def->fields[i];
+    fit_decode_step step;
+    step.offset = def->record_size;
+    step.target = fit_field_target(def->global_id, f->id);
+    def->record_size += f->size;
+
+    switch (f->type) {
+    case 0: // enum
+    case 1: // sint8
+    case 2: // uint8
+      step.size = (f->size == 1) ? 1 : 0;
+      break;
+    case 0x83: // sint16
+    case 0x84: // uint16
+      step.size = (f->size == 2) ? 2 : 0;
+      break;
+    case 0x85: // sint32
+    case 0x86: // uint32
+      step.size = (f->size == 4) ? 4 : 0;
+      break;
+    default: // Ignore everything else for now.
+      step.size = 0;
+      break;
+    }
+    if (global_opts.debug_level >= 8) {
+      debug_print(8, "%s: plan: field %d type=0x%X size=%d at offset %d -> target %d%s\n",
+                  MYNAME, i, f->type, f->size, step.offset, step.target,
+                  step.size ? "" : " (skipped)");
+    }
+
+    if (step.target != kTargetNone) {
+      def->plan.push_back(step);
+    }
+  }
+}
+
+/*******************************************************************************
+* fit_read_record- read the data of a data message in one go
+* Returns the number of bytes that were actually available.
+*******************************************************************************/
+static int
+fit_read_record(int size)
+{
+  if (fit_data.record.size() < (size_t) size) {
+    fit_data.record.resize(size);
+  }
+  int avail = (size < fit_data.len) ? size : fit_data.len;
+  if (avail < size) {
+    // fail gracefully for GARMIN Edge 800 with newest firmware, seems to write a wrong record length
+    // for the last record.
+    if (global_opts.debug_level >= 1) {
+      warning("%s: record truncated: fit_data.len=%d\n", MYNAME, fit_data.len);
+    }
+    memset(fit_data.record.data() + avail, 0, size - avail);
+  }
+  if (avail > 0) {
+    is_fatal(gbfread(fit_data.record.data(), avail, 1, fin) != 1,
+             MYNAME ": unexpected end of file with fit_data.len=%d\n", fit_data.len);
+  }
+  fit_data.len -= avail;
+  return avail;
+}
+
 static void
 fit_parse_definition_message(uint8_t header)
 {
@@ -312,6 +526,7 @@ fit_parse_definition_message(uint8_t header)
       debug_print(8,"%s: definition message contains %d developer records\n",MYNAME, numOfDevFields);
     }
     if (numOfDevFields == 0) {
+      fit_compile_plan(def);
       return;
     }
 
@@ -332,76 +547,8 @@ fit_parse_definition_message(uint8_t header)
     }
     def->num_fields = numOfFields;
   }
-}
 
-static uint32_t
-fit_read_field(fit_field_t* f)
-{
-  /* https://forums.garmin.com/showthread.php?223645-Vivoactive-problems-plus-suggestions-for-future-firmwares&p=610929#post610929
-   * Per section 4.2.1.4.2 of the FIT Protocol the size of a field may be a
-   * multiple of the size of the underlying type, indicating the field
-   * contains multiple elements represented as an array.
-   *
-   * Garmin Product Support
-   */
-  // In the case that the field contains one value of the indicated type we return that value,
-  // otherwise we just skip over the data.
-  int i;
-
-  if (global_opts.debug_level >= 8) {
-    debug_print(8,"%s: fit_read_field: read data field with f->type=0x%X and f->size=%d fit_data.len=%d\n",
-                MYNAME, f->type, f->size, fit_data.len);
-  }
-  switch (f->type) {
-  case 0: // enum
-  case 1: // sint8
-  case 2: // uint8
-    if (f->size == 1) {
-      return fit_getuint8();
-    } else { // ignore array data
-      for (i = 0; i < f->size; i++) {
-        fit_getuint8();
-      }
-      if (global_opts.debug_level >= 8) {
-        debug_print(8, "%s: fit_read_field: skipping 1-byte array data\n", MYNAME);
-      }
-      return -1;
-    }
-  case 0x83: // sint16
-  case 0x84: // uint16
-    if (f->size == 2) {
-      return fit_getuint16();
-    } else { // ignore array data
-      for (i = 0; i < f->size; i++) {
-        fit_getuint8();
-      }
-      if (global_opts.debug_level >= 8) {
-        debug_print(8, "%s: fit_read_field: skipping 2-byte array data\n", MYNAME);
-      }
-      return -1;
-    }
-  case 0x85: // sint32
-  case 0x86: // uint32
-    if (f->size == 4) {
-      return fit_getuint32();
-    } else { // ignore array data
-      for (i = 0; i < f->size; i++) {
-        fit_getuint8();
-      }
-      if (global_opts.debug_level >= 8) {
-        debug_print(8, "%s: fit_read_field: skipping 4-byte array data\n", MYNAME);
-      }
-      return -1;
-    }
-  default: // Ignore everything else for now.
-    for (i = 0; i < f->size; i++) {
-      fit_getuint8();
-    }
-    if (global_opts.debug_level >= 8) {
-      debug_print(8, "%s: fit_read_field: skipping unrecognized data type\n", MYNAME);
-    }
-    return -1;
-  }
+  fit_compile_plan(def);
 }
 
 static void
@@ -430,202 +577,96 @@ fit_parse_data(fit_message_def* def, int time_offset)
   if (global_opts.debug_level >= 7) {
     debug_print(7,"%s: parsing fit data ID %d with num_fields=%d\n", MYNAME, def->global_id, def->num_fields);
   }
-  for (int i = 0; i < def->num_fields; i++) {
+  int avail = fit_read_record(def->record_size);
+  const uint8_t* record = fit_data.record.data();
+  for (const auto& step : def->plan) {
+    const uint8_t* p = record + step.offset;
+    uint32_t val;
+    if (step.size > 1 && step.offset + step.size > avail) {
+      fatal(MYNAME ": record truncated: expecting char[%d], but only got %d\n",
+            step.size, (avail > step.offset) ? avail - step.offset : 0);
+    }
+    switch (step.size) {
+    case 1:
+      val = p[0];
+      break;
+    case 2:
+      val = def->endian ? be_readu16(p) : le_readu16(p);
+      break;
+    case 4:
+      val = def->endian ? (uint32_t) be_read32(p) : le_readu32(p);
+      break;
+    default:
+      val = -1;
+      break;
+    }
     if (global_opts.debug_level >= 7) {
-      debug_print(7,"%s: parsing field %d\n", MYNAME, i);
+      debug_print(7,"%s: parsing fit data: target %d=%u\n", MYNAME, step.target, val);
     }
-    fit_field_t* f = &def->fields[i];
-    uint32_t val = fit_read_field(f);
-    if (f->id == kFieldTimestamp) {
-      if (global_opts.debug_level >= 7) {
-        debug_print(7,"%s: parsing fit data: timestamp=%d\n", MYNAME, val);
-      }
+
+    switch (step.target) {
+    case kTargetTimestamp:
       timestamp = val;
       // if the timestamp is < 0x10000000, this value represents
       // system time; to convert it to UTC, add the global utc offset to it
       if (timestamp < 0x10000000)
         timestamp += fit_data.global_utc_offset;
       fit_data.last_timestamp = timestamp;
-    } else {
-      switch (def->global_id) {
-      case kIdDeviceSettings: // device settings message
-        switch (f->id) {
-        case kFieldGlobalUtcOffset:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: global utc_offset=%d\n", MYNAME, val);
-          }
-          fit_data.global_utc_offset = val;
-          break;
-        default:
-          if (global_opts.debug_level >= 1) {
-            debug_print(1, "%s: unrecognized data type in GARMIN FIT device settings: f->id=%d\n", MYNAME, f->id);
-          }
-          break;
-        } // switch (f->id)
-        // end of case def->global_id = kIdDeviceSettings
-        break;
-
-      case kIdRecord: // record message - trkType is a track
-        switch (f->id) {
-        case kFieldLatitude:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: lat=%d\n", MYNAME, val);
-          }
-          lat = val;
-          break;
-        case kFieldLongitude:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: lon=%d\n", MYNAME, val);
-          }
-          lon = val;
-          break;
-        case kFieldAltitude:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: alt=%d\n", MYNAME, val);
-          }
-          if (val != 0xffff) {
-              alt = val;
-          }
-          break;
-        case kFieldHeartRate:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: heartrate=%d\n", MYNAME, val);
-          }
-          heartrate = val;
-          break;
-        case kFieldCadence:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: cadence=%d\n", MYNAME, val);
-          }
-          cadence = val;
-          break;
-        case kFieldDistance:
-          // NOTE: 5 is DISTANCE in cm ... unused.
-          if (global_opts.debug_level >= 7) {
-            debug_print(7, "%s: unrecognized data type in GARMIN FIT record: f->id=%d\n", MYNAME, f->id);
-          }
-          break;
-        case kFieldSpeed:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: speed=%d\n", MYNAME, val);
-          }
-          if (val != 0xffff) {
-              speed = val;
-          }
-          break;
-        case kFieldPower:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: power=%d\n", MYNAME, val);
-          }
-          power = val;
-          break;
-        case kFieldTemperature:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: temperature=%d\n", MYNAME, val);
-          }
-          temperature = val;
-          break;
-        case kFieldEnhancedSpeed:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: enhanced_speed=%d\n", MYNAME, val);
-          }
-          if (val != 0xffff) {
-              speed = val;
-          }
-          break;
-        case kFieldEnhancedAltitude:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: enhanced_altitude=%d\n", MYNAME, val);
-          }
-          if (val != 0xffff) {
-              alt = val;
-          }
-          break;
-        default:
-          if (global_opts.debug_level >= 1) {
-            debug_print(1, "%s: unrecognized data type in GARMIN FIT record: f->id=%d\n", MYNAME, f->id);
-          }
-          break;
-        } // switch (f->id)
-        // end of case def->global_id = kIdRecord
-        break;
-
-      case kIdLap: // lap wptType , endlat+lon is wpt
-        switch (f->id) {
-        case kFieldStartTime:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: starttime=%d\n", MYNAME, val);
-          }
-          starttime = val;
-          break;
-        case kFieldStartLatitude:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: startlat=%d\n", MYNAME, val);
-          }
-          startlat = val;
-          break;
-        case kFieldStartLongitude:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: startlon=%d\n", MYNAME, val);
-          }
-          startlon = val;
-          break;
-        case kFieldEndLatitude:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: endlat=%d\n", MYNAME, val);
-          }
-          endlat = val;
-          break;
-        case kFieldEndLongitude:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: endlon=%d\n", MYNAME, val);
-          }
-          endlon = val;
-          break;
-        case kFieldElapsedTime:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: elapsedtime=%d\n", MYNAME, val);
-          }
-          //elapsedtime = val;
-          break;
-        case kFieldTotalDistance:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: totaldistance=%d\n", MYNAME, val);
-          }
-          //totaldistance = val;
-          break;
-        default:
-          if (global_opts.debug_level >= 1) {
-            debug_print(1, "%s: unrecognized data type in GARMIN FIT lap: f->id=%d\n", MYNAME, f->id);
-          }
-          break;
-        } // switch (f->id)
-        // end of case def->global_id = kIdLap
-        break;
-
-      case kIdEvent:
-        switch (f->id) {
-        case kFieldEvent:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: event=%d\n", MYNAME, val);
-          }
-          event = val;
-          break;
-        case kFieldEventType:
-          if (global_opts.debug_level >= 7) {
-            debug_print(7,"%s: parsing fit data: eventtype=%d\n", MYNAME, val);
-          }
-          eventtype = val;
-          break;
-        } // switch (f->id)
-        // end of case def->global_id = kIdEvent
-        break;
-      default:
-        if (global_opts.debug_level >= 1) {
-          debug_print(1, "%s: unrecognized/unhandled global ID for GARMIN FIT: %d\n", MYNAME, def->global_id);
-        }
-        break;
-      } // switch (def->global_id)
+      break;
+    case kTargetGlobalUtcOffset:
+      fit_data.global_utc_offset = val;
+      break;
+    case kTargetLatitude:
+      lat = val;
+      break;
+    case kTargetLongitude:
+      lon = val;
+      break;
+    case kTargetAltitude:
+      if (val != 0xffff) {
+        alt = val;
+      }
+      break;
+    case kTargetHeartRate:
+      heartrate = val;
+      break;
+    case kTargetCadence:
+      cadence = val;
+      break;
+    case kTargetSpeed:
+      if (val != 0xffff) {
+        speed = val;
+      }
+      break;
+    case kTargetPower:
+      power = val;
+      break;
+    case kTargetTemperature:
+      temperature = val;
+      break;
+    case kTargetStartTime:
+      starttime = val;
+      break;
+    case kTargetStartLatitude:
+      startlat = val;
+      break;
+    case kTargetStartLongitude:
+      startlon = val;
+      break;
+    case kTargetEndLatitude:
+      endlat = val;
+      break;
+    case kTargetEndLongitude:
+      endlon = val;
+      break;
+    case kTargetEvent:
+      event = val;
+      break;
+    case kTargetEventType:
+      eventtype = val;
+      break;
+    case kTargetNone:
+      break;
     }
   }
 
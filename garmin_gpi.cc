@@ -430,7 +430,7 @@ read_poi(const int sz, const int tag)
   pos = gbftell(fin);
 
   wpt = new Waypoint;
-  wpt->icon_descr = DEFAULT_ICON;
+  wpt->SetIconDescr(DEFAULT_ICON);
 
   wpt->latitude = GPS_Math_Semi_To_Deg(gbfgetint32(fin));
   wpt->longitude = GPS_Math_Semi_To_Deg(gbfgetint32(fin));
@@ -446,11 +446,11 @@ read_poi(const int sz, const int tag)
     }
   }
 
-  if (wpt->description.isEmpty() && !wpt->notes.isEmpty()) {
-    wpt->description = wpt->notes;
+  if (wpt->GetDescription().isEmpty() && !wpt->GetNotes().isEmpty()) {
+    wpt->SetDescription(wpt->GetNotes());
   }
-  if (wpt->notes.isEmpty() && !wpt->description.isEmpty()) {
-    wpt->notes = wpt->description;
+  if (wpt->GetNotes().isEmpty() && !wpt->GetDescription().isEmpty()) {
+    wpt->SetNotes(wpt->GetDescription());
   }
 
   waypt_add(wpt);
@@ -606,7 +606,7 @@ read_tag(const char* caller, const int tag, Waypoint* wpt)
     break;
 
   case 0xa:
-    wpt->description = gpi_read_string("Description");
+    wpt->SetDescription(gpi_read_string("Description"));
     break;
 
   case 0xe:	/* ? notes or description / or both ? */
@@ -623,10 +623,10 @@ read_tag(const char* caller, const int tag, Waypoint* wpt)
       break;
     }
 
-    if (!wpt->description.isEmpty()) {
-      wpt->notes = str;
+    if (!wpt->GetDescription().isEmpty()) {
+      wpt->SetNotes(str);
     } else {
-      wpt->description = str;
+      wpt->SetDescription(str);
     }
     break;
 
@@ -971,12 +971,12 @@ wdata_compute_size(writer_data_t* data)
 
     QString str = QString();
     if (opt_descr) {
-      if (!wpt->description.isEmpty()) {
-        str = wpt->description;
+      if (!wpt->GetDescription().isEmpty()) {
+        str = wpt->GetDescription();
       }
     } else if (opt_notes) {
-      if (!wpt->notes.isEmpty()) {
-        str = wpt->notes;
+      if (!wpt->GetNotes().isEmpty()) {
+        str = wpt->GetNotes();
       }
     } else if (opt_pos) {
       str = pretty_deg_format(wpt->latitude, wpt->longitude, 's', " ", 0);
@@ -1023,9 +1023,9 @@ wdata_compute_size(writer_data_t* data)
       res += (dt->sz + 12);  /* + header size */
     }
 
-    str = wpt->description;
+    str = wpt->GetDescription();
     if (str.isEmpty()) {
-      str = wpt->notes;
+      str = wpt->GetNotes();
     }
 //		if (str && (strcmp(str, wpt->shortname) == 0)) str = NULL;
     if (!str.isEmpty()) {
@@ -1085,9 +1085,9 @@ wdata_write(const writer_data_t* data)
     Waypoint* wpt = reinterpret_cast<Waypoint *>(elem);
     gpi_waypt_t* dt = (gpi_waypt_t*) wpt->extra_data;
 
-    QString str = wpt->description;
+    QString str = wpt->GetDescription();
     if (str.isEmpty()) {
-      str = wpt->notes;
+      str = wpt->GetNotes();
     }
 
     gbfputint32(0x80002, fout);
@@ -1275,8 +1275,8 @@ enum_waypt_cb(const Waypoint* ref)
     if ((compare_strings(cmp->shortname, ref->shortname) == 0) &&
         (cmp->latitude == ref->latitude) &&
         (cmp->longitude == ref->longitude) &&
-        (compare_strings(cmp->description, ref->description) == 0) &&
-        (compare_strings(cmp->notes, ref->notes) == 0)) {
+        (compare_strings(cmp->GetDescription(), ref->GetDescription()) == 0) &&
+        (compare_strings(cmp->GetNotes(), ref->GetNotes()) == 0)) {
       return;
     }
   }
@@ -772,7 +772,7 @@ gt_find_desc_from_icon_number(const int icon, garmin_formats_e garmin_format)
 
 int gt_find_icon_number_from_desc(const QString& desc, garmin_formats_e garmin_format)
 {
-  static int find_flag = 0;
+  static thread_local int find_flag = 0;
   icon_mapping_t* i;
   int def_icon = DEFAULT_ICON_VALUE;
 
@@ -894,7 +894,7 @@ gt_get_icao_country(const QString& cc)
 const char*
 gt_get_icao_cc(const QString& country, const QString& shortname)
 {
-  static char res[3];
+  static thread_local char res[3];
   gt_country_code_t* x = &gt_country_codes[0];
 
   if (country.isEmpty()) {
@@ -968,8 +968,8 @@ gt_lookup_grid_type(const char* grid_name, const QString& module)
     }
   }
 
-  Fatal() << module << ": Unsupported grid (" << grid_name <<
-                       ". See GPSBabel help for supported grids.\n";
+  fatal(FatalMsg() << module << ": Unsupported grid (" << grid_name <<
+                       ". See GPSBabel help for supported grids.\n");
 
   return grid_unknown;	/* (warnings) */
 }
@@ -1018,8 +1018,8 @@ gt_lookup_datum_index(const char* datum_str, const QString& module)
   }
 
   if (result < 0) {
-    Fatal() << module << ": Unsupported datum (" << datum_str <<
-                         "). See GPSBabel help for supported datums.";
+    fatal(FatalMsg() << module << ": Unsupported datum (" << datum_str <<
+                         "). See GPSBabel help for supported datums.");
   }
   return result;
 }
@@ -547,10 +547,10 @@ write_waypt(const Waypoint* wpt)
 
   gbfprintf(fout, "Waypoint\t%s\t", CSTRc(wpt->shortname));
   if (wpt_class <= gt_waypt_class_airport_ndb) {
-    QString temp = wpt->notes;
+    QString temp = wpt->GetNotes();
     if (temp.isEmpty()) {
-      if (wpt->description != wpt->shortname) {
-        temp = wpt->description;
+      if (wpt->GetDescription() != wpt->shortname) {
+        temp = wpt->GetDescription();
       } else {
         temp = "";
       }
@@ -590,7 +590,7 @@ write_waypt(const Waypoint* wpt)
 
   int icon = GMSD_GET(icon, -1);
   if (icon == -1) {
-    icon = gt_find_icon_number_from_desc(wpt->icon_descr, GDB);
+    icon = gt_find_icon_number_from_desc(wpt->GetIconDescr(), GDB);
   }
   print_string("%s\t", gt_find_desc_from_icon_number(icon, GDB));
 
@@ -1101,7 +1101,7 @@ parse_waypoint()
       wpt->shortname = DUPSTR(str);
       break;
     case  2:
-      wpt->notes = DUPSTR(str);
+      wpt->SetNotes(DUPSTR(str));
       break;
     case  3:
       for (i = 0; i <= gt_waypt_class_map_line; i++) {
@@ -1145,7 +1145,7 @@ parse_waypoint()
     case 11:
       i = gt_find_icon_number_from_desc(str, GDB);
       GMSD_SET(icon, i);
-      wpt->icon_descr = gt_find_desc_from_icon_number(i, GDB);
+      wpt->SetIconDescr(gt_find_desc_from_icon_number(i, GDB));
       break;
     case 12:
       GMSD_SETSTR(facility, str);
@@ -22,8 +22,13 @@
 
 #include "defs.h"
 #include "gbfile.h"
+#include "progress.h"
 #include "src/core/logging.h"
 
+#include <QtCore/QFileInfo>
+#include <QtCore/QHash>
+#include <QtCore/QTemporaryFile>
+
 #include <cassert>
 #include <cstdarg> // for va_copy
 #include <cstdio>
@@ -325,6 +330,17 @@ stdapi_tell(gbfile* self)
   return ftell(self->handle.std);
 }
 
+/* As stdapi_tell, but beyond 4GB for the progress reports. */
+static qint64
+stdapi_tell64(gbfile* self)
+{
+#ifdef _WIN32
+  return _ftelli64(self->handle.std);
+#else
+  return ftello(self->handle.std);
+#endif
+}
+
 static int
 stdapi_eof(gbfile* self)
 {
@@ -354,6 +370,60 @@ stdapi_error(gbfile* self)
 /* %%%                     Memory stream (memapi)                          %%% */
 /*******************************************************************************/
 
+struct gbfmem_file {
+  QByteArray data;
+  QTemporaryFile* spill{nullptr};
+  bool spill_written{false};
+};
+
+static thread_local QHash<QString, gbfmem_file> gbfmem_files;
+
+void
+gbfmem_register(const QString& name, const QByteArray& data)
+{
+  gbfmem_take(name);
+  gbfmem_files[name].data = data;
+}
+
+QByteArray
+gbfmem_take(const QString& name)
+{
+  if (!gbfmem_files.contains(name)) {
+    return QByteArray();
+  }
+
+  gbfmem_file mf = gbfmem_files.take(name);
+  if (mf.spill) {
+    if (mf.spill_written && mf.spill->open()) {
+      mf.data = mf.spill->readAll();
+    }
+    delete mf.spill;
+  }
+  return mf.data;
+}
+
+QString
+gbfmem_spill(const QString& name, bool writing)
+{
+  auto mf = gbfmem_files.find(name);
+  if (mf == gbfmem_files.end()) {
+    return QString();
+  }
+
+  if (!mf->spill) {
+    mf->spill = new QTemporaryFile;
+    if (!mf->spill->open()) {
+      fatal("Cannot create a temporary file for '%s'.\n", qPrintable(name));
+    }
+    if (!writing) {
+      mf->spill->write(mf->data);
+    }
+    mf->spill->close();
+  }
+  mf->spill_written |= writing;
+  return mf->spill->fileName();
+}
+
 static gbfile*
 memapi_open(gbfile* self, const char* mode)
 {
@@ -369,6 +439,12 @@ memapi_open(gbfile* self, const char* mode)
 static int
 memapi_close(gbfile* self)
 {
+  if (self->mode == 'w') {
+    auto mf = gbfmem_files.find(self->name);
+    if (mf != gbfmem_files.end()) {
+      mf->data = QByteArray((const char*) self->handle.mem, self->memlen);
+    }
+  }
   if (self->handle.mem) {
     xfree(self->handle.mem);
   }
@@ -499,7 +575,7 @@ gbfopen(const QString& filename, const char* mode, const char* module)
   file->mode = 'r'; // default
   file->binary = (strchr(mode, 'b') != nullptr);
   file->back = -1;
-  file->memapi = (filename == nullptr);
+  file->memapi = (filename == nullptr) || gbfmem_files.contains(filename);
 
   for (const char* m = mode; *m; m++) {
     switch (tolower(*m)) {
@@ -517,7 +593,7 @@ gbfopen(const QString& filename, const char* mode, const char* module)
 
   if (file->memapi) {
     file->gzapi = 0;
-    file->name = xstrdup("(Memory stream)");
+    file->name = xstrdup((filename == nullptr) ? QString("(Memory stream)") : filename);
 
     file->fileclearerr = memapi_clearerr;
     file->fileclose = memapi_close;
@@ -580,9 +656,29 @@ gbfopen(const QString& filename, const char* mode, const char* module)
 
   file->fileopen(file, mode);
 
+  if (file->memapi && (file->mode == 'r') && gbfmem_files.contains(filename)) {
+    const QByteArray& data = gbfmem_files[filename].data;
+    if (!data.isEmpty()) {
+      file->handle.mem = (unsigned char*) xmalloc(data.size());
+      memcpy(file->handle.mem, data.constData(), data.size());
+      file->memsz = file->memlen = data.size();
+    }
+  }
+
   file->buffsz = 256;
   file->buff = (char*) xmalloc(file->buffsz);
 
+  if (!file->memapi && !file->is_pipe) {
+    qint64 total = ((file->mode == 'r') && !file->gzapi) ? QFileInfo(filename).size() : 0;
+    progress_file(file, total, [file]() -> qint64 {
+      if (!file->gzapi) {
+        return stdapi_tell64(file);
+      }
+      /* The total of a .gz file is unknown anyway, so wrapping at 4GB is harmless. */
+      return (uint32_t) file->filetell(file);
+    });
+  }
+
   return file;
 }
 
@@ -610,6 +706,7 @@ gbfclose(gbfile* file)
     return;
   }
 
+  progress_file_closed(file);
   file->fileclose(file);
 
   xfree(file->name);
@@ -1067,7 +1164,7 @@ gbfgetucs2str(gbfile* file)
 
     int clen = cet_ucs4_to_utf8(buff, sizeof(buff), c0);
     if (clen < 1) {
-      Warning() << "Malformed UCS character" << c0 << "found.";
+      warning(WarningMsg() << "Malformed UCS character" << c0 << "found.");
       return nullptr;
     }
 
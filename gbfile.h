@@ -27,6 +27,7 @@
 #include "defs.h"
 #include "cet.h"
 
+#include <QtCore/QByteArray>
 #include <QtCore/QString>
 
 struct gbfile_s;
@@ -133,4 +134,16 @@ int gbfputpstr(const QString& s, gbfile* file);	// write as pascal string
 
 gbsize_t gbfcopyfrom(gbfile* file, gbfile* src, gbsize_t count);
 
+/*
+ * In-memory files.  Once a name is registered, gbfopen() of that name reads
+ * data from memory, or writes to memory, instead of the file system.
+ * gbfmem_take() unregisters the name and returns what was written to it.
+ * gbfmem_spill() hands readers and writers that need a real file, such as
+ * gpsbabel::File, a temporary file standing in for the name.  It returns an
+ * empty string for names that aren't registered.
+ */
+void gbfmem_register(const QString& name, const QByteArray& data);
+QByteArray gbfmem_take(const QString& name);
+QString gbfmem_spill(const QString& name, bool writing);
+
 #endif
@@ -23,15 +23,54 @@
 #include "gbser.h"
 #include "gbser_private.h"
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThread>
+#include <QtCore/QWaitCondition>
+
 #include <cassert>
 #include <cerrno>
 #include <cstdarg>
 #include <cstdio>
 #include <fcntl.h>
+#include <sys/select.h>
 #include <sys/time.h>
 #include <termios.h>
 #include <unistd.h>
 
+/* Background reader for a port.  Everything that arrives is moved into
+ * a ring buffer by a thread of its own, so a device can keep sending
+ * while the caller is still busy with the previous response.
+ */
+class gbser_reader : public QThread
+{
+public:
+  explicit gbser_reader(int fd);
+  ~gbser_reader() override;
+
+  int take(unsigned char* buf, unsigned len, unsigned want, unsigned ms);
+  int flush();
+
+protected:
+  void run() override;
+
+private:
+  static constexpr unsigned RINGSIZE = 65536;
+
+  int fd;
+  int wake[2]{-1, -1};
+  QMutex lock;
+  QWaitCondition data_ready;
+  QWaitCondition space_ready;
+  unsigned char ring[RINGSIZE];
+  unsigned head{0};
+  unsigned used{0};
+  bool stopping{false};
+  bool finished{false};
+  bool failed{false};
+};
+
 typedef struct {
   struct termios  old_tio;
   struct termios  new_tio;
@@ -41,6 +80,8 @@ typedef struct {
 
   unsigned char   inbuf[BUFSIZE];
   unsigned        inbuf_used;
+
+  gbser_reader*   reader;
 } gbser_handle;
 
 /* Wrapper to safely cast a void * into a gbser_handle */
@@ -104,24 +145,137 @@ static double elapsed(hp_time* tv)
   return nt - ot;
 }
 
-static int set_rx_timeout(gbser_handle* h, unsigned vmin, unsigned vtime)
+gbser_reader::gbser_reader(int fd) : fd(fd)
+{
+  if (pipe(wake)) {
+    fatal("Failed to create serial reader pipe (%s)\n", strerror(errno));
+  }
+  start();
+}
+
+gbser_reader::~gbser_reader()
 {
-  if (vmin  > 255) {
-    vmin  = 255;
+  {
+    QMutexLocker locker(&lock);
+    stopping = true;
+    space_ready.wakeAll();
   }
-  if (vtime > 255) {
-    vtime = 255;
+  char c = 0;
+  while (write(wake[1], &c, 1) < 0 && errno == EINTR) {
+    /* retry */
   }
-  if (vmin != h->vmin || vtime != h->vtime) {
-    h->vmin  = h->new_tio.c_cc[VMIN]  = vmin;
-    h->vtime = h->new_tio.c_cc[VTIME] = vtime;
+  wait();
+  close(wake[0]);
+  close(wake[1]);
+}
 
-    /*printf("VMIN=%d, VTIME=%d\n", h->vmin, h->vtime);*/
+void gbser_reader::run()
+{
+  for (;;) {
+    {
+      QMutexLocker locker(&lock);
+      while (used == RINGSIZE && !stopping) {
+        space_ready.wait(&lock);
+      }
+      if (stopping) {
+        return;
+      }
+    }
 
-    return tcsetattr(h->fd, TCSANOW, &h->new_tio) ? gbser_ERROR : gbser_OK;
-  } else {
-    return 0;
+    fd_set rec;
+    FD_ZERO(&rec);
+    FD_SET(fd, &rec);
+    FD_SET(wake[0], &rec);
+    int nfds = ((fd > wake[0]) ? fd : wake[0]) + 1;
+    if (select(nfds, &rec, nullptr, nullptr, nullptr) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      QMutexLocker locker(&lock);
+      failed = true;
+      data_ready.wakeAll();
+      return;
+    }
+    if (FD_ISSET(wake[0], &rec)) {
+      return;
+    }
+    if (!FD_ISSET(fd, &rec)) {
+      continue;
+    }
+
+    /* The port is read without waiting (VMIN and VTIME are 0) and under
+     * the lock, so flush() can't miss bytes on their way into the ring.
+     */
+    QMutexLocker locker(&lock);
+    unsigned room = RINGSIZE - used;
+    unsigned char buf[BUFSIZE];
+    int rc = read(fd, buf, (room < sizeof(buf)) ? room : sizeof(buf));
+    if (rc < 0) {
+      if (errno == EINTR || errno == EAGAIN) {
+        continue;
+      }
+      failed = true;
+      data_ready.wakeAll();
+      return;
+    }
+    if (rc == 0) {
+      /* End of file or hangup, nothing more will arrive. */
+      finished = true;
+      data_ready.wakeAll();
+      return;
+    }
+    for (int i = 0; i < rc; i++) {
+      ring[(head + used++) % RINGSIZE] = buf[i];
+    }
+    data_ready.wakeAll();
+  }
+}
+
+/* Wait up to |ms| milliseconds until at least |want| bytes are buffered,
+ * then move at most |len| of them to |buf|.  Returns the number of bytes
+ * moved or gbser_ERROR if the reader failed and nothing is left.
+ */
+int gbser_reader::take(unsigned char* buf, unsigned len, unsigned want, unsigned ms)
+{
+  QMutexLocker locker(&lock);
+
+  if (ms != 0) {
+    QElapsedTimer timer;
+    timer.start();
+    while (used < want && !finished && !failed) {
+      qint64 left = ms - timer.elapsed();
+      if (left <= 0 || !data_ready.wait(&lock, (unsigned long) left)) {
+        break;
+      }
+    }
   }
+
+  if (used == 0 && failed) {
+    return gbser_ERROR;
+  }
+
+  unsigned count = (len < used) ? len : used;
+  for (unsigned i = 0; i < count; i++) {
+    buf[i] = ring[head];
+    head = (head + 1) % RINGSIZE;
+  }
+  used -= count;
+  if (count != 0) {
+    space_ready.wakeAll();
+  }
+  return count;
+}
+
+/* Discard what the port and the ring hold.  Both are emptied under the
+ * lock, so nothing read before the call can turn up afterwards.
+ */
+int gbser_reader::flush()
+{
+  QMutexLocker locker(&lock);
+  int rc = tcflush(fd, TCIFLUSH);
+  head = used = 0;
+  space_ready.wakeAll();
+  return rc;
 }
 
 /* Open a serial port. |port_name| is the (platform specific) name
@@ -141,6 +295,7 @@ void* gbser_init(const char* port_name)
 
   if (0 == strcmp(port_name, "-")) {
     h->fd = 0;
+    h->reader = new gbser_reader(h->fd);
     return h;
   } else if (h->fd = open(port_name, O_RDWR | O_NOCTTY), h->fd == -1) {
     warning("Failed to open port (%s)\n", strerror(errno));
@@ -157,6 +312,7 @@ void* gbser_init(const char* port_name)
     goto failed;
   }
 
+  h->reader = new gbser_reader(h->fd);
   return h;
 
 failed:
@@ -175,6 +331,7 @@ void gbser_deinit(void* handle)
 {
   gbser_handle* h = gbser__get_handle(handle);
 
+  delete h->reader;
   tcsetattr(h->fd, TCSAFLUSH, &h->old_tio);
   close(h->fd);
 
@@ -278,7 +435,6 @@ unsigned gbser__read_buffer(void* handle, void** buf, unsigned* len)
  */
 int gbser__fill_buffer(void* handle, unsigned want, unsigned* ms)
 {
-  int rc;
   gbser_handle* h = gbser__get_handle(handle);
 
   if (want > BUFSIZE) {
@@ -290,68 +446,19 @@ int gbser__fill_buffer(void* handle, unsigned want, unsigned* ms)
     return h->inbuf_used;
   }
 
-  if (nullptr == ms || 0 == *ms) {
-    if ((rc = set_rx_timeout(h, 0, 0), rc < 0) ||
-        (rc = read(h->fd, h->inbuf + h->inbuf_used,
-                   want - h->inbuf_used), rc < 0)) {
-      return gbser_ERROR;
-    }
-    h->inbuf_used += rc;
-    /*printf("Got %d bytes\n", rc);*/
-  } else {
-    double time_left = *ms;
-    hp_time tv;
-    get_time(&tv);
-
-    for (;;) {
-      fd_set rec;
-      struct timeval t;
-
-      time_left = *ms - elapsed(&tv);
-      if (time_left <= 0 || h->inbuf_used >= want) {
-        break;
-      }
-
-      FD_ZERO(&rec);
-      FD_SET(h->fd, &rec);
-
-      t.tv_sec  = (time_t) time_left / 1000;
-      t.tv_usec = ((unsigned) time_left % 1000) * 1000;
-
-      if (select(h->fd + 1, &rec, nullptr, nullptr, &t) < 0) {
-        return gbser_ERROR;
-      }
-
-      time_left = *ms - elapsed(&tv);
+  unsigned wait_ms = (nullptr == ms) ? 0 : *ms;
+  hp_time tv;
+  get_time(&tv);
 
-      if (FD_ISSET(h->fd, &rec)) {
-#if 0
-        // See below comment.
+  int rc = h->reader->take(h->inbuf + h->inbuf_used, want - h->inbuf_used,
+                           want - h->inbuf_used, wait_ms);
+  if (rc < 0) {
+    return gbser_ERROR;
+  }
+  h->inbuf_used += rc;
 
-        unsigned vmin = 0, vtime = 0;
-        if (time_left >= 100) {
-          vmin  = want - h->inbuf_used;
-          vtime = (unsigned) time_left / 100;
-        }
-#endif
-        // The commented out call to set_rx_timeout here is totally
-        // legal by POSIX standards but does result in a flurry of
-        // of tcsetattrs that slightly tweak VMIN/VTIME while there
-        // is incoming data.   This has been shown to trigger driver
-        // bugs in the Prolific drivers for Mac and in certain Linux
-        // kernels, thought the latter has since been fixed.
-        // So althogh removing this means that the timeout behaviour
-        // is actually different on POSIX and WIN32, it triggers
-        // fewer buts this way.  2/12/2008 RJL
-        if (/* (rc = set_rx_timeout(h, vmin, vtime), rc < 0) || */
-          (rc = read(h->fd, h->inbuf + h->inbuf_used,
-                     want - h->inbuf_used), rc < 0)) {
-          return gbser_ERROR;
-        }
-        h->inbuf_used += rc;
-        /*printf("Got %d bytes\n", rc);*/
-      }
-    }
+  if (nullptr != ms && 0 != *ms) {
+    double time_left = *ms - elapsed(&tv);
     *ms = (time_left < 0) ? 0 : time_left;
   }
 
@@ -364,7 +471,7 @@ int gbser_flush(void* handle)
 {
   gbser_handle* h = gbser__get_handle(handle);
   h->inbuf_used = 0;
-  if (tcflush(h->fd, TCIFLUSH)) {
+  if (h->reader->flush()) {
     return gbser_ERROR;
   }
 
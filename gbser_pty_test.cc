@@ -0,0 +1,162 @@
+/*
+    Test of the POSIX serial port reader on a pseudo terminal.
+
+    Copyright (C) 2019 Robert Lipe, gpsbabel.org
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111 USA
+
+ */
+
+/*
+ * Plays the device on the master side of a pty while gbser talks to the
+ * slave side, and checks that the background reader neither loses, nor
+ * reorders, nor keeps flushed data.
+ *
+ * usage: gbser_pty_test
+ */
+
+#include "gbser.h"
+
+#include <QtCore/QThread>  // for QThread
+
+#include <cerrno>          // for errno
+#include <cstdio>          // for fprintf, stderr
+#include <cstdlib>         // for exit, posix_openpt, grantpt, unlockpt, ptsname
+#include <cstring>         // for memcmp, strerror
+#include <fcntl.h>         // for O_RDWR, O_NOCTTY
+#include <unistd.h>        // for read, write, close, usleep
+
+/* More than the reader's ring holds, so it has to wait for room. */
+#define BULK_SIZE (200 * 1024)
+
+static int master = -1;
+
+static void
+fail(const char* what)
+{
+  fprintf(stderr, "gbser_pty_test: %s\n", what);
+  exit(1);
+}
+
+static void
+device_send(const void* buf, size_t len)
+{
+  const char* p = (const char*) buf;
+  while (len > 0) {
+    ssize_t rc = write(master, p, len);
+    if (rc < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fail(strerror(errno));
+    }
+    p += rc;
+    len -= rc;
+  }
+}
+
+/* The device side of the bulk transfer, sent while the test reads. */
+class BulkSender : public QThread
+{
+protected:
+  void run() override
+  {
+    unsigned char buf[1024];
+    for (int sent = 0; sent < BULK_SIZE; sent += sizeof(buf)) {
+      for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = (sent + i) % 251;
+      }
+      device_send(buf, sizeof(buf));
+    }
+  }
+};
+
+int
+main()
+{
+  master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+    /* Nothing to test on a system without ptys. */
+    fprintf(stderr, "gbser_pty_test: no pty available, skipped.\n");
+    return 0;
+  }
+
+  void* h = gbser_init(ptsname(master));
+  if (h == nullptr) {
+    fail("cannot open the pty slave");
+  }
+
+  /* Nothing sent, nothing received. */
+  if (gbser_readc_wait(h, 100) != gbser_NOTHING) {
+    fail("read something that wasn't sent");
+  }
+
+  /* Device to host. */
+  char buf[64];
+  device_send("hello", 5);
+  if (gbser_read_wait(h, buf, 5, 1000) != 5 || memcmp(buf, "hello", 5) != 0) {
+    fail("short or wrong read");
+  }
+
+  /* Host to device. */
+  if (gbser_write(h, "ping", 4) != gbser_OK) {
+    fail("write failed");
+  }
+  int got = 0;
+  while (got < 4) {
+    ssize_t rc = read(master, buf + got, 4 - got);
+    if (rc <= 0) {
+      fail("device didn't receive the write");
+    }
+    got += rc;
+  }
+  if (memcmp(buf, "ping", 4) != 0) {
+    fail("device received the wrong data");
+  }
+
+  /* Flushed data must not come back, later data must. */
+  device_send("stale", 5);
+  usleep(100000);	/* let the reader move it into its ring */
+  if (gbser_flush(h) != gbser_OK) {
+    fail("flush failed");
+  }
+  if (gbser_readc_wait(h, 100) != gbser_NOTHING) {
+    fail("flushed data was read");
+  }
+  device_send("fresh", 5);
+  if (gbser_read_wait(h, buf, 5, 1000) != 5 || memcmp(buf, "fresh", 5) != 0) {
+    fail("data sent after the flush was lost");
+  }
+
+  /* A transfer bigger than the ring, read in small pieces. */
+  BulkSender sender;
+  sender.start();
+  usleep(500000);	/* let the ring fill up first */
+  for (int n = 0; n < BULK_SIZE; n += sizeof(buf)) {
+    if (gbser_read_wait(h, buf, sizeof(buf), 5000) != (int) sizeof(buf)) {
+      fail("bulk transfer stalled");
+    }
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+      if ((unsigned char) buf[i] != (n + i) % 251) {
+        fail("bulk transfer lost or reordered data");
+      }
+    }
+  }
+  sender.wait();
+
+  gbser_deinit(h);
+  close(master);
+  return 0;
+}
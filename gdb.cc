@@ -29,6 +29,8 @@
 #include "garmin_tables.h"
 #include "grtcirc.h"
 #include "jeeps/gpsmath.h"
+#include <QtCore/QHash>
+#include <QtCore/QList>
 #include <cmath>
 #include <cstdlib>
 
@@ -71,6 +73,8 @@ static gbfile* fin, *fout, *ftmp;
 static int gdb_ver, gdb_category, gdb_via, gdb_roadbook;
 
 static queue wayptq_in, wayptq_out, wayptq_in_hidden;
+/* Case folded shortname -> members of each of the above queues, in queue order. */
+static QHash<const queue*, QHash<QString, QList<Waypoint*>>> wayptq_index;
 static short_handle short_h;
 
 static char* gdb_opt_category;
@@ -94,11 +98,20 @@ static int trk_ct;	/* informational: total number of tracks in/out */
 #define ELEMENTS(a) a->rte_waypt_ct
 #define NOT_EMPTY(a) (a && *a)
 
+static void
+gdb_enqueue_waypt(queue* Q, Waypoint* wpt)
+{
+  ENQUEUE_TAIL(Q, &wpt->Q);
+  wayptq_index[Q][wpt->shortname.toCaseFolded()].append(wpt);
+}
+
 static void
 gdb_flush_waypt_queue(queue* Q)
 {
   queue* elem, *tmp;
 
+  wayptq_index.remove(Q);
+
   QUEUE_FOR_EACH(Q, elem, tmp) {
     Waypoint* wpt = reinterpret_cast<Waypoint *>(elem);
     dequeue(elem);
@@ -282,23 +295,33 @@ gdb_fread_strlist()
   return qres;
 }
 
+/*
+ * Route points are linked to their waypoints by name, so look the name up
+ * in the index rather than walking the whole queue for every route point.
+ */
 static Waypoint*
 gdb_find_wayptq(const queue* Q, const Waypoint* wpt, const char exact)
 {
-  queue* elem, *tmp;
-  QString name = wpt->shortname;
+  const auto qidx = wayptq_index.constFind(Q);
+  if (qidx == wayptq_index.constEnd()) {
+    return nullptr;
+  }
+  const auto candidates = qidx->constFind(wpt->shortname.toCaseFolded());
+  if (candidates == qidx->constEnd()) {
+    return nullptr;
+  }
 
-  QUEUE_FOR_EACH(Q, elem, tmp) {
-    Waypoint* tmp = reinterpret_cast<Waypoint *>(elem);
-    if (name.compare(tmp->shortname,Qt::CaseInsensitive) == 0) {
-      if (! exact) {
-        return tmp;
-      }
+  for (Waypoint* tmp : *candidates) {
+    if (wpt->shortname.compare(tmp->shortname, Qt::CaseInsensitive) != 0) {
+      continue;
+    }
+    if (! exact) {
+      return tmp;
+    }
 
-      if ((tmp->latitude == wpt->latitude) &&
-          (tmp->longitude == wpt->longitude)) {
-        return tmp;
-      }
+    if ((tmp->latitude == wpt->latitude) &&
+        (tmp->longitude == wpt->longitude)) {
+      return tmp;
     }
   }
   return nullptr;
@@ -342,7 +365,7 @@ gdb_add_route_waypt(route_head* rte, Waypoint* ref, const int wpt_class)
     }
   }
   Waypoint* res = nullptr;
-  int turn_point = (gdb_roadbook && (wpt_class > gt_waypt_class_map_point) && !tmp->description.isEmpty());
+  int turn_point = (gdb_roadbook && (wpt_class > gt_waypt_class_map_point) && !tmp->GetDescription().isEmpty());
   if (turn_point || (gdb_via == 0) || (wpt_class < gt_waypt_class_map_point)) {
     res = new Waypoint(*tmp);
     route_add_wpt(rte, res);
@@ -534,10 +557,10 @@ read_waypoint(gt_waypt_classes_e* waypt_class_out)
          res->latitude < 0 ? 'S' : 'N', res->latitude,
          res->longitude < 0 ? 'W' : 'E', res->longitude);
 #endif
-  res->notes = fread_cstr();
+  res->SetNotes(fread_cstr());
 #if GDB_DEBUG
-  DBG(GDB_DBG_WPTe, res->notes) {
-    char* str = gstrsub(res->notes, "\r\n", ", ");
+  DBG(GDB_DBG_WPTe, res->GetNotes()) {
+    char* str = gstrsub(res->GetNotes(), "\r\n", ", ");
     printf(MYNAME "-wpt \"%s\" (%d): notes = %s\n",
            sn, wpt_class, nice(str));
     xfree(str);
@@ -616,7 +639,7 @@ read_waypoint(gt_waypt_classes_e* waypt_class_out)
       res->AddUrlLink(l);
     }
     if (wpt_class != 0) {
-      res->description = l.url_;
+      res->SetDescription(l.url_);
     }
   } else { // if (gdb_ver >= GDB_VER_3)
 
@@ -626,7 +649,7 @@ read_waypoint(gt_waypt_classes_e* waypt_class_out)
     GMSD_SETSTR(addr, bufp);
 
     FREAD(buf, 5);				/* instruction depended */
-    res->description = FREAD_CSTR_AS_QSTR;	/* instruction */
+    res->SetDescription(FREAD_CSTR_AS_QSTR);	/* instruction */
     int url_ct = FREAD_i32;
     for (int i = url_ct; (i); i--) {
       QString str = FREAD_CSTR_AS_QSTR;
@@ -642,9 +665,9 @@ read_waypoint(gt_waypt_classes_e* waypt_class_out)
   }
 
 #if GDB_DEBUG
-  DBG(GDB_DBG_WPTe, res->description)
+  DBG(GDB_DBG_WPTe, res->GetDescription())
   printf(MYNAME "-wpt \"%s\" (%d): description = %s\n",
-         sn, wpt_class, nice(res->description));
+         sn, wpt_class, nice(res->GetDescription()));
   DBG(GDB_DBG_WPTe, !res->url.isNull())
   printf(MYNAME "-wpt \"%s\" (%d): url = %s\n",
          sn, wpt_class, nice(qPrintable(res->url))); // FIXME: qPrintable and nice probably are fighting.
@@ -691,19 +714,19 @@ read_waypoint(gt_waypt_classes_e* waypt_class_out)
     GMSD_SETSTR(postal_code, bufp);
   }
 
-  res->icon_descr = gt_find_desc_from_icon_number(icon, GDB);
+  res->SetIconDescr(gt_find_desc_from_icon_number(icon, GDB));
 
 #if GDB_DEBUG
   DBG(GDB_DBG_WPTe, icon != GDB_DEF_ICON)
   printf(MYNAME "-wpt \"%s\" (%d): icon = \"%s\" (MapSource symbol %d)\n",
-         sn, wpt_class, nice(qPrintable(res->icon_descr)), icon); // FIXME: qPrintable and nice probably are fighting.
+         sn, wpt_class, nice(qPrintable(res->GetIconDescr())), icon); // FIXME: qPrintable and nice probably are fighting.
 #endif
   if ((str = GMSD_GET(cc, NULL))) {
     if (! GMSD_HAS(country)) {
       GMSD_SETSTR(country, gt_get_icao_country(str));
     }
   }
-  if (gdb_roadbook && (wpt_class > gt_waypt_class_map_point) && !res->description.isEmpty()) {
+  if (gdb_roadbook && (wpt_class > gt_waypt_class_map_point) && !res->GetDescription().isEmpty()) {
     wpt_class = gt_waypt_class_user_waypoint;
     GMSD_SET(wpt_class, wpt_class);
 #ifdef GMSD_EXPERIMENTAL
@@ -1059,9 +1082,9 @@ read_data()
       if ((gdb_via == 0) || (wpt_class == 0)) {
         waypt_add(wpt);
         Waypoint* dupe = new Waypoint(*wpt);
-        ENQUEUE_TAIL(&wayptq_in, &dupe->Q);
+        gdb_enqueue_waypt(&wayptq_in, dupe);
       } else {
-        ENQUEUE_TAIL(&wayptq_in_hidden, &wpt->Q);
+        gdb_enqueue_waypt(&wayptq_in_hidden, wpt);
       }
       break;
     case 'R':
@@ -1295,10 +1318,10 @@ write_waypoint(
   FWRITE_LATLON(wpt->latitude);		/* latitude */
   FWRITE_LATLON(wpt->longitude);		/* longitude */
   FWRITE_DBL(wpt->altitude, unknown_alt);	/* altitude */
-  if (!wpt->notes.isEmpty()) {
-    FWRITE_CSTR(wpt->notes);
+  if (!wpt->GetNotes().isEmpty()) {
+    FWRITE_CSTR(wpt->GetNotes());
   } else {
-    FWRITE_CSTR(wpt->description);
+    FWRITE_CSTR(wpt->GetDescription());
   }
   FWRITE_DBL(WAYPT_GET(wpt, proximity, unknown_alt), unknown_alt);	/* proximity */
   FWRITE_i32(display);			/* display */
@@ -1320,7 +1343,7 @@ write_waypoint(
       ld = l.url_;
     }
     QString descr = (wpt_class < gt_waypt_class_map_point) ?
-                      ld : wpt->description;
+                      ld : wpt->GetDescription();
     if ((descr != nullptr) && (wpt_class >= gt_waypt_class_map_point) && \
         descr == CSTRc(wpt->shortname)) {
       descr.clear();
@@ -1342,11 +1365,11 @@ write_waypoint(
     /* GBD doesn't have a native description field */
     /* here we misuse the instruction field */
 #if 1
-    QString d = wpt->description;
-    if (wpt->description == wpt->shortname) {
+    QString d = wpt->GetDescription();
+    if (wpt->GetDescription() == wpt->shortname) {
       d.clear();
     }
-    if (str == wpt->notes) {
+    if (str == wpt->GetNotes()) {
       d.clear();
     }
     FWRITE_CSTR(d);				/* instruction */
@@ -1361,8 +1384,8 @@ write_waypoint(
     FWRITE_CSTR(str);				/* instruction */
 #endif
 
-    FWRITE_i32(wpt->urls.size());
-    foreach(UrlLink l, wpt->urls) {
+    FWRITE_i32(wpt->GetUrlList().size());
+    foreach(UrlLink l, wpt->GetUrlList()) {
       FWRITE_CSTR(l.url_);
     }
   }
@@ -1620,7 +1643,7 @@ write_waypoint_cb(const Waypoint* refpt)
   }
 
   if ((test != nullptr) && (route_flag == 0)) {
-    if (test->notes != refpt->notes) {
+    if (test->GetNotes() != refpt->GetNotes()) {
       test = nullptr;
     }
   }
@@ -1630,7 +1653,7 @@ write_waypoint_cb(const Waypoint* refpt)
     Waypoint* wpt = new Waypoint(*refpt);
 
     gdb_check_waypt(wpt);
-    ENQUEUE_TAIL(&wayptq_out, &wpt->Q);
+    gdb_enqueue_waypt(&wayptq_out, wpt);
 
     gbfile* fsave = fout;
     fout = ftmp;
@@ -1646,10 +1669,10 @@ write_waypoint_cb(const Waypoint* refpt)
 
     int icon = GMSD_GET(icon, -1);
     if (icon < 0) {
-      if (wpt->icon_descr.isNull()) {
+      if (wpt->GetIconDescr().isNull()) {
         icon = GDB_DEF_ICON;
       } else {
-        icon = gt_find_icon_number_from_desc(wpt->icon_descr, GDB);
+        icon = gt_find_icon_number_from_desc(wpt->GetIconDescr(), GDB);
       }
     }
 
@@ -1675,9 +1698,9 @@ write_waypoint_cb(const Waypoint* refpt)
     QString name = wpt->shortname;
 
     if (global_opts.synthesize_shortnames || name.isEmpty()) {
-      name = wpt->notes;
+      name = wpt->GetNotes();
       if (name.isEmpty()) {
-        name = wpt->description;
+        name = wpt->GetDescription();
       }
       if (name.isEmpty()) {
         name = wpt->shortname;
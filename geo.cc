@@ -62,13 +62,13 @@ static void GeoReadLoc()
       } else if (current_tag == "/loc/waypoint/name") {
         QXmlStreamAttributes a = reader.attributes();
         wpt->shortname = a.value("id").toString();
-        wpt->description = reader.readElementText();
+        wpt->SetDescription(reader.readElementText());
       } else if (current_tag == "/loc/waypoint/coord") {
         QXmlStreamAttributes a = reader.attributes();
         wpt->latitude = a.value("lat").toString().toDouble();
         wpt->longitude = a.value("lon").toString().toDouble();
       } else if (current_tag == "/loc/waypoint/type") {
-        wpt->icon_descr = reader.readElementText();
+        wpt->SetIconDescr(reader.readElementText());
       } else if (current_tag == "/loc/waypoint/link") {
         QXmlStreamAttributes a = reader.attributes();
         waypt_add_url(wpt,
@@ -185,7 +185,7 @@ geo_waypt_pr(const Waypoint* waypointp)
   writer.writeAttribute(QStringLiteral("id"), waypointp->shortname);
   // TODO: this could be writeCharacters, but it's here for compat with pre
   // Qt writer.
-  writer.writeCDATA(waypointp->description);
+  writer.writeCDATA(waypointp->GetDescription());
   writer.writeEndElement();
 
   writer.writeStartElement(QStringLiteral("coord"));
@@ -193,7 +193,7 @@ geo_waypt_pr(const Waypoint* waypointp)
   writer.writeAttribute(QStringLiteral("lon"), QString::number(waypointp->longitude, 'f'));
   writer.writeEndElement();
 
-  writer.writeTextElement(QStringLiteral("type"), deficon ? deficon : waypointp->icon_descr);
+  writer.writeTextElement(QStringLiteral("type"), deficon ? deficon : waypointp->GetIconDescr());
 
   if (waypointp->HasUrlLink()) {
     writer.writeStartElement(QStringLiteral("link"));
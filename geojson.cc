@@ -87,8 +87,8 @@ geojson_waypt_pr(const Waypoint* waypoint) {
   if (!waypoint->shortname.isEmpty()) {
     properties[NAME] = waypoint->shortname;
   }
-  if (!waypoint->description.isEmpty()) {
-    properties[DESCRIPTION] = waypoint->description;
+  if (!waypoint->GetDescription().isEmpty()) {
+    properties[DESCRIPTION] = waypoint->GetDescription();
   }
   if (waypoint->HasUrlLink()) {
     UrlLink link = waypoint->GetUrlLink();
@@ -198,7 +198,7 @@ geojson_read() {
 			QJsonArray coordinates = geometry.value(COORDINATES).toArray();
 			auto waypoint = waypoint_from_coordinates(coordinates);
 			waypoint->shortname = name;
-			waypoint->description = description;
+			waypoint->SetDescription(description);
 			if (properties.contains(URL))
 			{
 				QString url = properties[URL].toString();
@@ -159,7 +159,7 @@ ggv_bin_read_v2(QDataStream& stream)
       wpt = new Waypoint;
       wpt->longitude = lon;
       wpt->latitude = lat;
-      wpt->description = waypt_name;
+      wpt->SetDescription(waypt_name);
       waypt_add(wpt);
       break;
     case 0x03:
@@ -319,7 +319,7 @@ ggv_bin_read_v34_record(QDataStream& stream)
     wpt = new Waypoint;
     wpt->longitude = lon;
     wpt->latitude = lat;
-    wpt->description = QString::fromLatin1(buf.constData()).simplified();
+    wpt->SetDescription(QString::fromLatin1(buf.constData()).simplified());
     waypt_add(wpt);
     break;
   case 0x03:
@@ -351,7 +351,7 @@ gopal_write_waypt(const Waypoint* wpt)
   int fix=fix_unknown;
   //TICK;    TIME;   LONG;     LAT;       HEIGHT; SPEED;  UN; HDOP;     SAT
   //3801444, 080558, 2.944362, 43.262117, 295.28, 0.12964, 2, 2.900000, 3
-  snprintf(tbuffer, sizeof(tbuffer), "%06d", wpt->creation_time.hms());
+  snprintf(tbuffer, sizeof(tbuffer), "%06d", wpt->GetCreationTime().hms());
   if (wpt->fix!=fix_unknown) {
     switch (wpt->fix) {
     case fix_none:
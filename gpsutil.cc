@@ -114,7 +114,7 @@ data_read()
     wpt_tmp->altitude = alt;
     wpt_tmp->shortname = sn;
     xfree(sn);
-    wpt_tmp->description = desc;
+    wpt_tmp->SetDescription(desc);
     wpt_tmp->SetCreationTime(now);
 
     if (latdir == 'S') {
@@ -130,7 +130,7 @@ data_read()
     wpt_tmp->longitude = ilon + (lon - ilon)*(100.0/60.0);
     int ilat = (int)(lat);
     wpt_tmp->latitude = ilat + (lat - ilat) * (100.0/60.0);
-    wpt_tmp->icon_descr = mag_find_descr_from_token(icon);
+    wpt_tmp->SetIconDescr(mag_find_descr_from_token(icon));
     waypt_add(wpt_tmp);
   }
 }
@@ -138,9 +138,9 @@ data_read()
 static void
 gpsutil_disp(const Waypoint* wpt)
 {
-  char* tdesc = xstrdup(wpt->description);
+  char* tdesc = xstrdup(wpt->GetDescription());
 
-  QString icon_token = mag_find_token_from_descr(wpt->icon_descr);
+  QString icon_token = mag_find_token_from_descr(wpt->GetIconDescr());
 
   double lon = degrees2ddmm(wpt->longitude);
   double lat = degrees2ddmm(wpt->latitude);
@@ -156,7 +156,7 @@ gpsutil_disp(const Waypoint* wpt)
             ((wpt->altitude == unknown_alt) ||
              (wpt->altitude < 0.0)) ? 0 : wpt->altitude,
             'm',
-            CSTRc(wpt->description) ? tdesc : "",
+            CSTRc(wpt->GetDescription()) ? tdesc : "",
             CSTR(icon_token));
 
   xfree(tdesc);
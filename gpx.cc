@@ -44,48 +44,48 @@
 #include <cstring>                     // for strchr
 
 
-static QXmlStreamReader* reader;
-static xml_tag* cur_tag;
-static QString cdatastr;
-static char* opt_logpoint = nullptr;
-static char* opt_humminbirdext = nullptr;
-static char* opt_garminext = nullptr;
-static char* opt_elevation_precision = nullptr;
-static int logpoint_ct = 0;
-static int elevation_precision;
+static thread_local QXmlStreamReader* reader;
+static thread_local xml_tag* cur_tag;
+static thread_local QString cdatastr;
+static thread_local char* opt_logpoint = nullptr;
+static thread_local char* opt_humminbirdext = nullptr;
+static thread_local char* opt_garminext = nullptr;
+static thread_local char* opt_elevation_precision = nullptr;
+static thread_local int logpoint_ct = 0;
+static thread_local int elevation_precision;
 
 // static char* gpx_version = NULL;
-static QString gpx_version;
-static char* gpx_wversion;
-static int gpx_wversion_num;
-static QXmlStreamAttributes gpx_namespace_attribute;
-
-static QString current_tag;
-
-static Waypoint* wpt_tmp;
-static UrlLink* link_;
-static UrlLink* rh_link_;
-static bool cache_descr_is_html;
-static gpsbabel::File* iqfile;
-static gpsbabel::File* oqfile;
-static gpsbabel::XmlStreamWriter* writer;
-static short_handle mkshort_handle;
-static QString link_url;
-static QString link_text;
-static QString link_type;
-
-
-static char* snlen = nullptr;
-static char* suppresswhite = nullptr;
-static char* urlbase = nullptr;
-static route_head* trk_head;
-static route_head* rte_head;
-static const route_head* current_trk_head;		// Output.
+static thread_local QString gpx_version;
+static thread_local char* gpx_wversion;
+static thread_local int gpx_wversion_num;
+static thread_local QXmlStreamAttributes gpx_namespace_attribute;
+
+static thread_local QString current_tag;
+
+static thread_local Waypoint* wpt_tmp;
+static thread_local UrlLink* link_;
+static thread_local UrlLink* rh_link_;
+static thread_local bool cache_descr_is_html;
+static thread_local gpsbabel::File* iqfile;
+static thread_local gpsbabel::File* oqfile;
+static thread_local gpsbabel::XmlStreamWriter* writer;
+static thread_local short_handle mkshort_handle;
+static thread_local QString link_url;
+static thread_local QString link_text;
+static thread_local QString link_type;
+
+
+static thread_local char* snlen = nullptr;
+static thread_local char* suppresswhite = nullptr;
+static thread_local char* urlbase = nullptr;
+static thread_local route_head* trk_head;
+static thread_local route_head* rte_head;
+static thread_local const route_head* current_trk_head;		// Output.
 /* used for bounds calculation on output */
-static bounds all_bounds;
-static int next_trkpt_is_new_seg;
+static thread_local bounds all_bounds;
+static thread_local int next_trkpt_is_new_seg;
 
-static format_specific_data** fs_ptr;
+static thread_local format_specific_data** fs_ptr;
 static void gpx_write_bounds();
 
 
@@ -222,7 +222,7 @@ struct GpxGlobal {
   UrlList link;
   /* time and bounds aren't here; they're recomputed. */
 };
-static GpxGlobal* gpx_global = nullptr;
+static thread_local GpxGlobal* gpx_global = nullptr;
 
 static void
 gpx_add_to_global(QStringList& ge, const QString& s)
@@ -439,7 +439,7 @@ static tag_mapping tag_path_map[] = {
 };
 
 // Maintain a fast mapping from full tag names to the struct above.
-static QHash<QString, tag_mapping*> hash;
+static thread_local QHash<QString, tag_mapping*> hash;
 
 static tag_type
 get_tag(const QString& t, int* passthrough)
@@ -896,7 +896,7 @@ gpx_end(const QString&)
 {
   float x;
   int passthrough;
-  static QDateTime gc_log_date;
+  static thread_local QDateTime gc_log_date;
 
   // Remove leading, trailing whitespace.
   cdatastr = cdatastr.trimmed();
@@ -958,7 +958,7 @@ gpx_end(const QString&)
     wpt_tmp = nullptr;
     break;
   case tt_cache_name:
-    wpt_tmp->notes = cdatastr;
+    wpt_tmp->SetNotes(cdatastr);
     break;
   case tt_cache_container:
     wpt_tmp->AllocGCData()->container = gs_mkcont(cdatastr);
@@ -1162,7 +1162,7 @@ gpx_end(const QString&)
     wpt_tmp->shortname = cdatastr;
     break;
   case tt_wpttype_sym:
-    wpt_tmp->icon_descr = cdatastr;
+    wpt_tmp->SetIconDescr(cdatastr);
     break;
   case tt_wpttype_time:
     wpt_tmp->SetCreationTime(xml_parse_time(cdatastr));
@@ -1171,10 +1171,10 @@ gpx_end(const QString&)
     WAYPT_SET(wpt_tmp, geoidheight, cdatastr.toDouble());
     break;
   case tt_wpttype_cmt:
-    wpt_tmp->description = cdatastr;
+    wpt_tmp->SetDescription(cdatastr);
     break;
   case tt_wpttype_desc:
-    wpt_tmp->notes = cdatastr;
+    wpt_tmp->SetNotes(cdatastr);
     break;
   case tt_wpttype_pdop:
     wpt_tmp->pdop = cdatastr.toDouble();
@@ -1314,7 +1314,7 @@ gpx_wr_init(const QString& fname)
       // data type (QString, int, char*).  This section needs a rethink. For
       // now, we stuff over the QString gpx_version into the global char *
       // gpx_wversion without making a malloc'ed copy.
-      static char tmp[16];
+      static thread_local char tmp[16];
       strncpy(tmp, CSTR(gpx_version), sizeof(tmp));
       gpx_wversion = tmp;
     }
@@ -1327,8 +1327,8 @@ gpx_wr_init(const QString& fname)
   gpx_wversion_num = strtod(gpx_wversion, nullptr) * 10;
 
   if (gpx_wversion_num <= 0) {
-    Fatal() << MYNAME << ": gpx version number of "
-            << gpx_wversion << "not valid.";
+    fatal(FatalMsg() << MYNAME << ": gpx version number of "
+            << gpx_wversion << "not valid.");
   }
 
   // FIXME: This write of a blank line is needed for Qt 4.6 (as on Centos 6.3)
@@ -1479,10 +1479,10 @@ gpx_read()
   }
 
   if (reader->hasError())  {
-    Fatal() << MYNAME << "Read error:" << reader->errorString()
+    fatal(FatalMsg() << MYNAME << "Read error:" << reader->errorString()
             << "File:" << iqfile->fileName()
             << "Line:" << reader->lineNumber()
-            << "Column:" << reader->columnNumber();
+            << "Column:" << reader->columnNumber());
   }
 }
 
@@ -1584,7 +1584,7 @@ static void
 write_gpx_url(const Waypoint* waypointp)
 {
   if (waypointp->HasUrlLink()) {
-    write_gpx_url(waypointp->urls);
+    write_gpx_url(waypointp->GetUrlList());
   }
 }
 
@@ -1744,15 +1744,15 @@ gpx_write_common_description(const Waypoint* waypointp, const QString& oname)
 {
   writer->writeOptionalTextElement(QStringLiteral("name"), oname);
 
-  writer->writeOptionalTextElement(QStringLiteral("cmt"), waypointp->description);
-  if (!waypointp->notes.isEmpty()) {
-    writer->writeTextElement(QStringLiteral("desc"), waypointp->notes);
+  writer->writeOptionalTextElement(QStringLiteral("cmt"), waypointp->GetDescription());
+  if (!waypointp->GetNotes().isEmpty()) {
+    writer->writeTextElement(QStringLiteral("desc"), waypointp->GetNotes());
   } else {
-    writer->writeOptionalTextElement(QStringLiteral("desc"), waypointp->description);
+    writer->writeOptionalTextElement(QStringLiteral("desc"), waypointp->GetDescription());
   }
   /* TODO: src should go here */
   write_gpx_url(waypointp);
-  writer->writeOptionalTextElement(QStringLiteral("sym"), waypointp->icon_descr);
+  writer->writeOptionalTextElement(QStringLiteral("sym"), waypointp->GetIconDescr());
   /* TODO: type should go here */
 }
 
@@ -2004,7 +2004,7 @@ gpx_exit()
   gpx_global = nullptr;
 }
 
-static
+static thread_local
 arglist_t gpx_args[] = {
   {
     "snlen", &snlen, "Length of generated shortnames",
@@ -2046,7 +2046,7 @@ arglist_t gpx_args[] = {
   ARG_TERMINATOR
 };
 
-ff_vecs_t gpx_vecs = {
+thread_local ff_vecs_t gpx_vecs = {
   ff_type_file,
   FF_CAP_RW_ALL,
   gpx_rd_init,
@@ -125,14 +125,14 @@ double linedistprj(double lat1, double lon1,
                    double* prjlat, double* prjlon,
                    double* frac)
 {
-  static double _lat1 = -9999;
-  static double _lat2 = -9999;
-  static double _lon1 = -9999;
-  static double _lon2 = -9999;
-
-  static double x1, y1, z1;
-  static double x2, y2, z2;
-  static double xa, ya, za, la;
+  static thread_local double _lat1 = -9999;
+  static thread_local double _lat2 = -9999;
+  static thread_local double _lon1 = -9999;
+  static thread_local double _lon2 = -9999;
+
+  static thread_local double x1, y1, z1;
+  static thread_local double x2, y2, z2;
+  static thread_local double xa, ya, za, la;
 
   double xa1, ya1, za1;
   double xa2, ya2, za2;
@@ -529,10 +529,10 @@ gtm_read()
     wpt->longitude = fread_double(file_in);
     convert_datum(&wpt->latitude, &wpt->longitude);
     wpt->shortname = fread_fixedstring(file_in, 10);
-    wpt->description = fread_string(file_in);
+    wpt->SetDescription(fread_string(file_in));
     icon = fread_integer(file_in);
     if (icon < sizeof(icon_descr)/sizeof(char*)) {
-      wpt->icon_descr = icon_descr[icon];
+      wpt->SetIconDescr(icon_descr[icon]);
     }
     fread_discard(file_in, 1);
     wpt->SetCreationTime(fread_long(file_in));
@@ -598,11 +598,11 @@ gtm_read()
     wpt->longitude = fread_double(file_in);
     convert_datum(&wpt->latitude, &wpt->longitude);
     wpt->shortname = fread_fixedstring(file_in, 10);
-    wpt->description = fread_string(file_in);
+    wpt->SetDescription(fread_string(file_in));
     QString route_name = fread_string(file_in);
     icon = fread_integer(file_in);
     if (icon < sizeof(icon_descr)/sizeof(char*)) {
-      wpt->icon_descr = icon_descr[icon];
+      wpt->SetIconDescr(icon_descr[icon]);
     }
     fread_discard(file_in, 1);
     start_new = fread_byte(file_in);
@@ -637,8 +637,8 @@ static void write_waypt(const Waypoint* wpt)
   fwrite_double(file_out, wpt->latitude);
   fwrite_double(file_out, wpt->longitude);
   fwrite_fixedstring(file_out, wpt->shortname, 10);
-  fwrite_string(file_out, wpt->description);
-  fwrite_integer(file_out, icon_from_descr(wpt->icon_descr));
+  fwrite_string(file_out, wpt->GetDescription());
+  fwrite_integer(file_out, icon_from_descr(wpt->GetIconDescr()));
   fwrite_byte(file_out, 3);
   if (wpt->creation_time.isValid()) {
     fwrite_long(file_out, wpt->GetCreationTime().toTime_t()-EPOCH89DIFF);
@@ -689,9 +689,9 @@ static void write_rte_waypt(const Waypoint* wpt)
   fwrite_double(file_out, wpt->latitude);
   fwrite_double(file_out, wpt->longitude);
   fwrite_fixedstring(file_out, wpt->shortname, 10);
-  fwrite_string(file_out, wpt->description);
+  fwrite_string(file_out, wpt->GetDescription());
   fwrite_string(file_out, rte_active->rte_name);
-  fwrite_integer(file_out, icon_from_descr(wpt->icon_descr));
+  fwrite_integer(file_out, icon_from_descr(wpt->GetIconDescr()));
   fwrite_byte(file_out, 3);
   fwrite_byte(file_out, start_new);
   fwrite_long(file_out, 0);
@@ -274,7 +274,7 @@ gtc_study_lap(const Waypoint* wpt)
     gtc_start_lat = wpt->latitude;
     gtc_start_long = wpt->longitude;
   }
-  if (wpt->creation_time > gtc_most_time)  {
+  if (wpt->GetCreationTime() > gtc_most_time)  {
     gtc_most_time = wpt->GetCreationTime();
     gtc_end_lat = wpt->latitude;
     gtc_end_long = wpt->longitude;
@@ -523,7 +523,7 @@ gtc_trk_pnt_e(xg_string, const QXmlStreamAttributes*)
 void
 gtc_trk_utc(xg_string args, const QXmlStreamAttributes*)
 {
-  wpt_tmp->creation_time = xml_parse_time(args);
+  wpt_tmp->SetCreationTime(xml_parse_time(args));
 }
 
 void
@@ -613,7 +613,7 @@ void gtc_wpt_ident(const QString& args, const QXmlStreamAttributes*)
 {
   wpt_tmp->shortname = (args);
   /* Set also as notes for compatibility with garmin usb format */
-  wpt_tmp->notes = (args);
+  wpt_tmp->SetNotes(args);
 }
 void gtc_wpt_lat(const QString& args, const QXmlStreamAttributes*)
 {
@@ -625,11 +625,11 @@ void gtc_wpt_long(const QString& args, const QXmlStreamAttributes*)
 }
 void gtc_wpt_icon(const QString& args, const QXmlStreamAttributes*)
 {
-  wpt_tmp->icon_descr = args;
+  wpt_tmp->SetIconDescr(args);
 }
 void gtc_wpt_notes(const QString& args, const QXmlStreamAttributes*)
 {
-  wpt_tmp->description = args;
+  wpt_tmp->SetDescription(args);
 }
 
 ff_vecs_t gtc_vecs = {
@@ -9,6 +9,7 @@ CONFIG(debug, debug|release) {
 ICON = images/appicon.icns
 
 QT += core \
+      concurrent \
       gui \
       network \
       xml
@@ -171,15 +171,12 @@ double PolylineEncoder::distance(const LatLng& p0, const LatLng& p1, const LatLn
 }
 
 //------------------------------------------------------------------------
-void PolylineEncoder::dpEncode(string& encPts, string& encLevels, const vector<LatLng>& points)
+// Douglas-Peucker: the distance of each point from the segment it was
+// split off, or -1 for points that are never needed.
+void PolylineEncoder::dpDistances(vector<double>& dists, const vector<LatLng>& points)
 {
-  if (points.size() < 2) {
-    encPts = encLevels = "";  // no solution here.
-    return;
-
-  }
   stack <IntervalPair> stk;
-  vector <double>  dists(points.size(), -1.0);
+  dists.assign(points.size(), -1.0);
 
   stk.push(IntervalPair(0, int(points.size())-1));
   while (!stk.empty()) {
@@ -202,6 +199,37 @@ void PolylineEncoder::dpEncode(string& encPts, string& encLevels, const vector<L
       stk.push(IntervalPair(maxLoc, current.i1));
     }
   }
+}
+
+//------------------------------------------------------------------------
+void PolylineEncoder::dpEncode(string& encPts, string& encLevels, const vector<LatLng>& points)
+{
+  if (points.size() < 2) {
+    encPts = encLevels = "";  // no solution here.
+    return;
+
+  }
+  vector <double>  dists;
+  dpDistances(dists, points);
   createEncodings(encPts, points, dists);
   encodeLevels(encLevels, points, dists);
 }
+
+//------------------------------------------------------------------------
+// Level 0 is the coarsest.  A point is needed from its level on, the
+// end points from level 0.
+void PolylineEncoder::dpLevels(vector<int>& levels, const vector<LatLng>& points)
+{
+  if (points.size() < 2) {
+    levels.assign(points.size(), 0);
+    return;
+  }
+  vector <double>  dists;
+  dpDistances(dists, points);
+  levels.resize(points.size());
+  for (unsigned int i = 0; i < points.size(); i++) {
+    levels[i] = (dists[i] >= 0.0) ? computeLevel(dists[i]) : -1;
+  }
+  levels.front() = 0;
+  levels.back() = 0;
+}
@@ -35,9 +35,13 @@ class PolylineEncoder
 public:
   PolylineEncoder(int numLevels=19, double zoomFactor=2.0, double verySmall = 0.00001);
   void dpEncode(string& encPts, string& encLevels, const vector<LatLng>& points);
+  // The level from which on each point is needed, -1 if never.
+  void dpLevels(vector<int>& levels, const vector<LatLng>& points);
 
 private:
 
+  void dpDistances(vector<double>& dists, const vector<LatLng>& points);
+
   int computeLevel(double dd);
   double distance(const LatLng&, const LatLng&, const LatLng&);
   void encodeLevels(string&, const vector<LatLng>& points, const vector<double>& dists);
@@ -25,9 +25,15 @@
 #include <QtCore/QChar>             // for operator==, QChar
 #include <QtCore/QCharRef>          // for QCharRef
 #include <QtCore/QCoreApplication>  // for QCoreApplication
+#include <QtCore/QDateTime>         // for QDateTime
+#include <QtCore/QDir>              // for QDir
+#include <QtCore/QFile>             // for QFile
+#include <QtCore/QFileInfo>         // for QFileInfo
 #include <QtCore/QObject>           // for QObject
 #include <QtCore/QProcess>          // for QProcess
 #include <QtCore/QRegExp>           // for QRegExp
+#include <QtCore/QSaveFile>         // for QSaveFile
+#include <QtCore/QStandardPaths>    // for QStandardPaths
 #include <QtCore/QString>           // for QString, operator+
 #include <QtCore/QTextStream>       // for QTextStream
 #include <QtCore/QVariant>          // for QVariant
@@ -131,12 +137,77 @@ bool FormatLoad::processFormat(Format& format)
 }
 
 //------------------------------------------------------------------------
-bool FormatLoad::getFormats(QList<Format>& formatList)
+// The output of "gpsbabel -^3" only changes when gpsbabel does, so it is
+// kept in the cache directory and reused as long as the binary it came
+// from has the same path, size and modification time.  The first line of
+// the cache file holds that key.
+static const char cacheVersion[] = "formats-3";
+
+static QString babelPath()
 {
-  formatList.clear();
+  return QApplication::applicationDirPath() + "/gpsbabel";
+}
+
+static QString cacheFileName()
+{
+  QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  if (dir.isEmpty()) {
+    return QString();
+  }
+  return dir + "/" + cacheVersion + ".txt";
+}
+
+static QByteArray cacheKey()
+{
+  QFileInfo babel(babelPath());
+#ifdef Q_OS_WIN
+  if (!babel.exists()) {
+    babel.setFile(babelPath() + ".exe");
+  }
+#endif
+  if (!babel.exists()) {
+    return QByteArray();
+  }
+  return QString("%1\t%2\t%3\t%4").arg(cacheVersion, babel.absoluteFilePath())
+         .arg(babel.size()).arg(babel.lastModified().toMSecsSinceEpoch()).toUtf8();
+}
+
+static bool readCache(const QByteArray& key, QByteArray& output)
+{
+  QString name = cacheFileName();
+  if (key.isEmpty() || name.isEmpty()) {
+    return false;
+  }
+  QFile file(name);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  if (file.readLine().trimmed() != key) {
+    return false;
+  }
+  output = file.readAll();
+  return !output.isEmpty();
+}
+
+static void writeCache(const QByteArray& key, const QByteArray& output)
+{
+  QString name = cacheFileName();
+  if (key.isEmpty() || name.isEmpty() || !QDir().mkpath(QFileInfo(name).path())) {
+    return;
+  }
+  QSaveFile file(name);
+  if (file.open(QIODevice::WriteOnly)) {
+    file.write(key + "\n");
+    file.write(output);
+    file.commit();
+  }
+}
 
+//------------------------------------------------------------------------
+static bool runBabel(QByteArray& output)
+{
   QProcess babel;
-  babel.start(QApplication::applicationDirPath() + "/gpsbabel", QStringList() << "-^3");
+  babel.start(babelPath(), QStringList() << "-^3");
   if (!babel.waitForStarted()) {
     return false;
   }
@@ -147,8 +218,25 @@ bool FormatLoad::getFormats(QList<Format>& formatList)
   if (babel.exitCode() != 0) {
     return false;
   }
+  output = babel.readAll();
+  return true;
+}
+
+//------------------------------------------------------------------------
+bool FormatLoad::getFormats(QList<Format>& formatList)
+{
+  formatList.clear();
+
+  QByteArray output;
+  QByteArray key = cacheKey();
+  if (!readCache(key, output)) {
+    if (!runBabel(output)) {
+      return false;
+    }
+    writeCache(key, output);
+  }
 
-  QTextStream tstream(babel.readAll());
+  QTextStream tstream(output);
   QList<int>lineList;
   int k=0;
   while (!tstream.atEnd()) {
@@ -895,7 +895,8 @@ bool MainWindow::runGpsbabel(const QStringList& args, QString& errorString,
 {
   QProcess* proc = new QProcess(nullptr);
   QString name = "gpsbabel";
-  proc->start(QApplication::applicationDirPath() + '/' + name, args);
+  // -vp has gpsbabel report its progress for the wait dialog.
+  proc->start(QApplication::applicationDirPath() + '/' + name, QStringList("-vp") + args);
   ProcessWaitDialog* waitDlg = new ProcessWaitDialog(nullptr, proc);
 
   if (proc->state() == QProcess::NotRunning) {
@@ -38,11 +38,14 @@
 #include <QCursor>
 #include <QFile>
 #include <QTextStream>
+#include <QtConcurrentRun>
 
+#include <algorithm>
 #include <math.h>
 #include <string>
 #include <vector>
 #include "appname.h"
+#include "dpencode.h"
 
 using std::string;
 using std::vector;
@@ -70,7 +73,10 @@ Map::Map(QWidget* parent,
   gpx_(gpx),
   mapPresent_(false),
   busyCursor_(false),
-  textEdit_(te)
+  textEdit_(te),
+  viewKnown_(false),
+  viewZoom_(0),
+  viewSouth_(0), viewWest_(0), viewNorth_(0), viewEast_(0)
 {
   busyCursor_ = true;
   stopWatch_.start();
@@ -78,6 +84,8 @@ Map::Map(QWidget* parent,
   manager_ = new QNetworkAccessManager(this);
   connect(this,SIGNAL(loadFinished(bool)),
           this,SLOT(loadFinishedX(bool)));
+  connect(&levelWatcher_, SIGNAL(finished()),
+          this, SLOT(levelsComputed()));
   this->logTime("Start map constuctor");
 
 #if HAVE_WEBENGINE
@@ -88,6 +96,8 @@ Map::Map(QWidget* parent,
   channel->registerObject(QStringLiteral("mclicker"), mclicker);
   connect(mclicker, SIGNAL(markerClicked(int,int)), this, SLOT(markerClicked(int,int)));
   connect(mclicker, SIGNAL(logTime(QString)), this, SLOT(logTime(QString)));
+  connect(mclicker, SIGNAL(viewChanged(int,double,double,double,double)),
+          this, SLOT(viewChanged(int,double,double,double,double)));
 #endif
 
   QString baseFile =  QApplication::applicationDirPath() + "/gmapbase.html";
@@ -111,6 +121,7 @@ Map::Map(QWidget* parent,
 //------------------------------------------------------------------------
 Map::~Map()
 {
+  levelWatcher_.waitForFinished();
   if (busyCursor_) {
     QApplication::restoreOverrideCursor();
   }
@@ -169,6 +180,141 @@ static QString makePath(const vector <LatLng>& pts)
   return path;
 }
 
+//------------------------------------------------------------------------
+// Google maps zoom levels run from 0 to 21.  At zoom z one pixel covers
+// about degreesPerPixel(z) degrees, and a point whose Douglas-Peucker
+// distance is less than that makes no visible difference.
+static const int mapLevels = 22;
+
+// The most points sent for one track or route.  Beyond that only the
+// part of the path near the view is sent.
+static const unsigned int maxViewPoints = 10000;
+
+static double degreesPerPixel(int zoom)
+{
+  return 360.0 / (256.0 * pow(2.0, zoom));
+}
+
+//------------------------------------------------------------------------
+static MapPath makeMapPath(const vector <LatLng>& pts)
+{
+  MapPath path;
+  path.points = pts;
+  path.south = path.west = 180.0;
+  path.north = path.east = -180.0;
+  foreach (const LatLng ll, pts) {
+    path.south = std::min(path.south, ll.lat());
+    path.north = std::max(path.north, ll.lat());
+    path.west = std::min(path.west, ll.lng());
+    path.east = std::max(path.east, ll.lng());
+  }
+  return path;
+}
+
+//------------------------------------------------------------------------
+static QString fmtBounds(const MapPath& path)
+{
+  return QString("new google.maps.LatLngBounds(%1, %2)")
+         .arg(fmtLatLng(LatLng(path.south, path.west)), fmtLatLng(LatLng(path.north, path.east)));
+}
+
+//------------------------------------------------------------------------
+// Runs in a worker thread; the paths are left alone until it is done.
+static void computeLevels(std::vector<MapPath>* trks, std::vector<MapPath>* rtes)
+{
+  PolylineEncoder encoder(mapLevels, 2.0, degreesPerPixel(mapLevels - 1));
+  for (auto& path : *trks) {
+    encoder.dpLevels(path.levels, path.points);
+  }
+  for (auto& path : *rtes) {
+    encoder.dpLevels(path.levels, path.points);
+  }
+}
+
+//------------------------------------------------------------------------
+static bool inBounds(const LatLng& ll, double south, double west, double north, double east)
+{
+  if (ll.lat() < south || ll.lat() > north) {
+    return false;
+  }
+  if (west <= east) {
+    return ll.lng() >= west && ll.lng() <= east;
+  }
+  return ll.lng() >= west || ll.lng() <= east;  // across the antimeridian
+}
+
+//------------------------------------------------------------------------
+QString Map::pathsForView(const MapPath& path, bool simplified) const
+{
+  const vector <LatLng>& pts = path.points;
+  vector <vector <LatLng> > runs(1);
+
+  if (!simplified || path.levels.size() != pts.size()) {
+    // Still being simplified; make do with every n-th point.
+    unsigned int stride = pts.size() / maxViewPoints + 1;
+    for (unsigned int i = 0; i < pts.size(); i += stride) {
+      runs.back().push_back(pts[i]);
+    }
+    if (!pts.empty() && (pts.size() - 1) % stride != 0) {
+      runs.back().push_back(pts.back());
+    }
+  } else {
+    vector <unsigned int> sel;
+    for (unsigned int i = 0; i < pts.size(); i++) {
+      if (path.levels[i] >= 0 && path.levels[i] <= viewZoom_) {
+        sel.push_back(i);
+      }
+    }
+    if (sel.size() <= maxViewPoints) {
+      foreach (unsigned int i, sel) {
+        runs.back().push_back(pts[i]);
+      }
+    } else {
+      // Keep what lies within half a screen of the view, and the point
+      // on either side of it so the lines leave the view where they should.
+      double latMargin = (viewNorth_ - viewSouth_) / 2.0;
+      double width = viewEast_ - viewWest_;
+      if (width < 0.0) {
+        width += 360.0;
+      }
+      double south = viewSouth_ - latMargin;
+      double north = viewNorth_ + latMargin;
+      double west = viewWest_ - width / 2.0;
+      double east = viewEast_ + width / 2.0;
+      if (width * 2.0 >= 360.0) {
+        west = -180.0;
+        east = 180.0;
+      } else {
+        if (west < -180.0) {
+          west += 360.0;
+        }
+        if (east > 180.0) {
+          east -= 360.0;
+        }
+      }
+      vector <bool> inside(sel.size());
+      for (unsigned int k = 0; k < sel.size(); k++) {
+        inside[k] = inBounds(pts[sel[k]], south, west, north, east);
+      }
+      for (unsigned int k = 0; k < sel.size(); k++) {
+        if (inside[k] || (k > 0 && inside[k-1]) || (k + 1 < sel.size() && inside[k+1])) {
+          runs.back().push_back(pts[sel[k]]);
+        } else if (!runs.back().empty()) {
+          runs.push_back(vector <LatLng>());
+        }
+      }
+    }
+  }
+
+  QStringList paths;
+  foreach (const vector <LatLng>& run, runs) {
+    if (run.size() >= 2) {
+      paths << QString("[%1\n        ]").arg(makePath(run));
+    }
+  }
+  return QString("[%1]").arg(paths.join(", "));
+}
+
 //------------------------------------------------------------------------
 void Map::showGpxData()
 {
@@ -179,8 +325,15 @@ void Map::showGpxData()
   this->page()->mainFrame()->addToJavaScriptWindowObject("mclicker", mclicker);
   connect(mclicker, SIGNAL(markerClicked(int,int)), this, SLOT(markerClicked(int,int)));
   connect(mclicker, SIGNAL(logTime(QString)), this, SLOT(logTime(QString)));
+  connect(mclicker, SIGNAL(viewChanged(int,double,double,double,double)),
+          this, SLOT(viewChanged(int,double,double,double,double)));
 #endif
 
+  // The paths are filled in once the map knows its view, see viewChanged().
+  levelWatcher_.waitForFinished();
+  trkPaths_.clear();
+  rtePaths_.clear();
+
   this->logTime("Start defining JS string");
   QStringList scriptStr;
   scriptStr
@@ -219,23 +372,23 @@ void Map::showGpxData()
   num = 0;
   foreach (const GpxTrack& trk, gpx_.getTracks()) {
     vector <LatLng> pts;
-    QString path;
     foreach (const GpxTrackSegment seg, trk.getTrackSegments()) {
       foreach (const GpxTrackPoint pt, seg.getTrackPoints()) {
         pts.push_back(pt.getLocation());
       }
     }
-    path = makePath(pts);
+    trkPaths_.push_back(makeMapPath(pts));
 
     scriptStr
         << QString("trks[%1] = new RTPolyline(\n"
                    "    map,\n"
-                   "    new google.maps.Polyline({\n        map: map,\n        strokeColor: \"#0000E0\",\n        strokeWeight: 2,\n        strokeOpacity: 0.6,\n        path: [%2\n        ]\n    }),\n"
+                   "    {strokeColor: \"#0000E0\", strokeWeight: 2, strokeOpacity: 0.6},\n"
+                   "    new google.maps.LatLng(%2),\n"
                    "    new google.maps.LatLng(%3),\n"
-                   "    new google.maps.LatLng(%4),\n"
+                   "    %4,\n"
                    "    \"%5\",\n"
                    "    new MarkerHandler(1, %1)\n);"
-                  ).arg(num).arg(path, fmtLatLng(pts.front()), fmtLatLng(pts.back()), stripDoubleQuotes(trk.getName()))
+                  ).arg(num).arg(fmtLatLng(pts.front()), fmtLatLng(pts.back()), fmtBounds(trkPaths_.back()), stripDoubleQuotes(trk.getName()))
         << QString("bounds.union(trks[%1].getBounds());").arg(num)
         ;
     num++;
@@ -249,21 +402,21 @@ void Map::showGpxData()
   num = 0;
   foreach (const GpxRoute& rte, gpx_.getRoutes()) {
     vector <LatLng> pts;
-    QString path;
     foreach (const GpxRoutePoint& pt, rte.getRoutePoints()) {
       pts.push_back(pt.getLocation());
     }
-    path = makePath(pts);
+    rtePaths_.push_back(makeMapPath(pts));
 
     scriptStr
         << QString("rtes[%1] = new RTPolyline(\n"
                    "    map,\n"
-                   "    new google.maps.Polyline({\n        map: map,\n        strokeColor: \"#8000B0\",\n        strokeWeight: 2,\n        strokeOpacity: 0.6,\n        path: [%2\n        ]\n    }),\n"
+                   "    {strokeColor: \"#8000B0\", strokeWeight: 2, strokeOpacity: 0.6},\n"
+                   "    new google.maps.LatLng(%2),\n"
                    "    new google.maps.LatLng(%3),\n"
-                   "    new google.maps.LatLng(%4),\n"
+                   "    %4,\n"
                    "    \"%5\",\n"
                    "    new MarkerHandler(2, %1)\n);"
-                  ).arg(num).arg(path, fmtLatLng(pts.front()), fmtLatLng(pts.back()), stripDoubleQuotes(rte.getName()))
+                  ).arg(num).arg(fmtLatLng(pts.front()), fmtLatLng(pts.back()), fmtBounds(rtePaths_.back()), stripDoubleQuotes(rte.getName()))
         << QString("bounds.union(rtes[%1].getBounds());").arg(num)
         ;
     num++;
@@ -274,6 +427,7 @@ void Map::showGpxData()
       ;
 
   scriptStr
+      << "reportView(map);"
       << "map.setCenter(bounds.getCenter());"
       << "map.fitBounds(bounds);"
       << "mclicker.logTimeX(\"Done setCenter\");"
@@ -282,6 +436,44 @@ void Map::showGpxData()
   this->logTime("Done defining JS string");
   evaluateJS(scriptStr);
   this->logTime("Done JS evaluation");
+
+  levelWatcher_.setFuture(QtConcurrent::run(computeLevels, &trkPaths_, &rtePaths_));
+}
+
+//------------------------------------------------------------------------
+void Map::viewChanged(int zoom, double south, double west, double north, double east)
+{
+  viewKnown_ = true;
+  viewZoom_ = zoom;
+  viewSouth_ = south;
+  viewWest_ = west;
+  viewNorth_ = north;
+  viewEast_ = east;
+  updatePaths();
+}
+
+//------------------------------------------------------------------------
+void Map::levelsComputed()
+{
+  this->logTime("Done simplifying paths");
+  if (viewKnown_) {
+    updatePaths();
+  }
+}
+
+//------------------------------------------------------------------------
+void Map::updatePaths()
+{
+  // The levels may only be looked at once the worker is done with them.
+  bool simplified = levelWatcher_.isFinished();
+  QStringList scriptStr;
+  for (unsigned int i = 0; i < trkPaths_.size(); i++) {
+    scriptStr << QString("trks[%1].setPaths(%2);").arg(i).arg(pathsForView(trkPaths_[i], simplified));
+  }
+  for (unsigned int i = 0; i < rtePaths_.size(); i++) {
+    scriptStr << QString("rtes[%1].setPaths(%2);").arg(i).arg(pathsForView(rtePaths_[i], simplified));
+  }
+  evaluateJS(scriptStr);
 }
 
 //------------------------------------------------------------------------
@@ -30,8 +30,11 @@
 #include <QPlainTextEdit>
 #include <QTime>
 #include <QFile>
+#include <QFutureWatcher>
 #include <QTextStream>
+#include <vector>
 #include "gpx.h"
+#include "latlng.h"
 
 //#define DEBUG_JS_GENERATION
 
@@ -54,10 +57,28 @@ public slots:
   {
     emit logTime(s);
   }
+  void viewChangedX(int zoom, double south, double west, double north, double east)
+  {
+    emit viewChanged(zoom, south, west, north, east);
+  }
 
 signals:
   void markerClicked(int t, int i);
   void logTime(const QString& s);
+  void viewChanged(int zoom, double south, double west, double north, double east);
+};
+
+
+//------------------------------------------------------------------------
+// A track or route as drawn on the map.  Once levels is computed the map
+// only gets the points that matter at its zoom, and when zoomed in only
+// those near the view.
+class MapPath
+{
+public:
+  std::vector<LatLng> points;
+  std::vector<int> levels;
+  double south, west, north, east;
 };
 
 
@@ -98,6 +119,10 @@ public slots:
   void frameRoute(int i);
 
   void logTime(const QString&);
+  void viewChanged(int zoom, double south, double west, double north, double east);
+
+private slots:
+  void levelsComputed();
 
 signals:
   void waypointClicked(int i);
@@ -115,9 +140,17 @@ private:
   bool busyCursor_;
   QTime stopWatch_;
   QPlainTextEdit* textEdit_;
+  std::vector<MapPath> trkPaths_;
+  std::vector<MapPath> rtePaths_;
+  QFutureWatcher<void> levelWatcher_;
+  bool viewKnown_;
+  int viewZoom_;
+  double viewSouth_, viewWest_, viewNorth_, viewEast_;
 
   void evaluateJS(const QString& s, bool update = true);
   void evaluateJS(const QStringList& s, bool update = true);
+  QString pathsForView(const MapPath& path, bool simplified) const;
+  void updatePaths();
 
 
 protected:
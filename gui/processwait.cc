@@ -26,6 +26,8 @@
 #include <QDialogButtonBox>
 #include <QVBoxLayout>
 #include <QDialog>
+#include <QLabel>
+#include <QLocale>
 #include <QProgressBar>
 #include <QPushButton>
 #include <QTimer>
@@ -71,6 +73,9 @@ ProcessWaitDialog::ProcessWaitDialog(QWidget* parent, QProcess* process):
   textEdit_->setReadOnly(true);
   layout->addWidget(textEdit_);
 
+  statusLabel_ = new QLabel(this);
+  layout->addWidget(statusLabel_);
+
   progressBar_ = new QProgressBar(this);
   progressBar_->setTextVisible(false);
   layout->addWidget(progressBar_);
@@ -104,6 +109,7 @@ ProcessWaitDialog::ProcessWaitDialog(QWidget* parent, QProcess* process):
     progressVals_.push_back(i);
   }
   progressIndex_ = progressVals_.size()/2;
+  progressKnown_ = false;
 
   timer_ = new QTimer(this);
   timer_->setInterval(100);
@@ -145,9 +151,11 @@ void ProcessWaitDialog::stopClickedX()
 //------------------------------------------------------------------------
 void ProcessWaitDialog::timeoutX()
 {
-  progressIndex_++;
-  int idx = progressIndex_ % progressVals_.size();
-  progressBar_->setValue(progressVals_[idx]);
+  if (!progressKnown_) {
+    progressIndex_++;
+    int idx = progressIndex_ % progressVals_.size();
+    progressBar_->setValue(progressVals_[idx]);
+  }
   if (stopCount_ >=0) {
     stopCount_++;
   }
@@ -170,6 +178,9 @@ void ProcessWaitDialog::errorX(QProcess::ProcessError err)
 //------------------------------------------------------------------------
 void ProcessWaitDialog::finishedX(int exitCode, QProcess::ExitStatus es)
 {
+  // Whatever is left of stderr didn't end in a newline.
+  QByteArray rest = process_->readAllStandardError();
+  appendToText(rest.data());
   ecode_ = exitCode;
   if (es == QProcess::CrashExit) {
     errorString_ = QString(tr("Process crashed whle running"));
@@ -201,12 +212,74 @@ void ProcessWaitDialog::appendToText(const char* ptr)
 
 
 //------------------------------------------------------------------------
+// gpsbabel -vp mixes lines like
+//   progress<TAB>stage<TAB>bytes done<TAB>bytes total<TAB>points<TAB>name
+// into its messages on stderr; see progress.h in the gpsbabel sources.
 void ProcessWaitDialog::readyReadStandardErrorX()
 {
-  QByteArray d = process_->readAllStandardError();
-  appendToText(d.data());
+  process_->setReadChannel(QProcess::StandardError);
+  while (process_->canReadLine()) {
+    QByteArray line = process_->readLine();
+    if (line.startsWith("progress\t")) {
+      showProgress(line.trimmed());
+    } else {
+      appendToText(line.data());
+    }
+  }
+  process_->setReadChannel(QProcess::StandardOutput);
 };
 
+//------------------------------------------------------------------------
+static QString dataSize(qint64 bytes)
+{
+  QLocale locale;
+  if (bytes < 1024 * 1024) {
+    return QObject::tr("%1 KB").arg(locale.toString(bytes / 1024));
+  }
+  return QObject::tr("%1 MB").arg(locale.toString(double(bytes) / (1024 * 1024), 'f', 1));
+}
+
+//------------------------------------------------------------------------
+void ProcessWaitDialog::showProgress(const QByteArray& line)
+{
+  QList<QByteArray> fields = line.split('\t');
+  if (fields.size() < 5) {
+    return;
+  }
+  QString stage = QString::fromUtf8(fields[1]);
+  qint64 done = fields[2].toLongLong();
+  qint64 total = fields[3].toLongLong();
+  qlonglong points = fields[4].toLongLong();
+  QString name = (fields.size() > 5) ? QString::fromUtf8(fields[5]) : QString();
+
+  QString what;
+  if (stage == "read") {
+    what = tr("Reading %1").arg(name);
+  } else if (stage == "filter") {
+    what = tr("Filtering (%1)").arg(name);
+  } else if (stage == "write") {
+    what = tr("Writing %1").arg(name);
+  } else {
+    what = tr("Finishing");
+  }
+
+  QString status = what;
+  if (total > 0) {
+    status += tr(": %1 of %2").arg(dataSize(done), dataSize(total));
+  } else if (done > 0) {
+    status += tr(": %1").arg(dataSize(done));
+  }
+  if (points > 0) {
+    status += tr(", %1 points").arg(QLocale().toString(points));
+  }
+  statusLabel_->setText(status);
+
+  progressKnown_ = (total > 0);
+  if (progressKnown_) {
+    progressBar_->setValue(int(qMin(done, total) * 100 / total));
+  }
+}
+
 //------------------------------------------------------------------------
 void ProcessWaitDialog::readyReadStandardOutputX()
 {
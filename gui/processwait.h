@@ -31,6 +31,7 @@
 using std::string;
 using std::vector;
 
+class QLabel;
 class QProgressBar;
 class QPlainTextEdit;
 class QDialogButtonBox;
@@ -57,6 +58,7 @@ public:
 protected:
   void closeEvent(QCloseEvent* event);
   void appendToText(const char*);
+  void showProgress(const QByteArray& line);
   QString processErrorString(QProcess::ProcessError err);
 
 
@@ -71,11 +73,13 @@ private slots:
 private:
   vector <int> progressVals_;
   int          progressIndex_;
+  bool         progressKnown_;
   int          stopCount_;
   string       bufferedOut_;
   QProcess::ExitStatus exitStatus_;
   int                  ecode_;
   QProcess*     process_;
+  QLabel*       statusLabel_;
   QProgressBar* progressBar_;
   QPlainTextEdit* textEdit_;
   QDialogButtonBox* buttonBox_;
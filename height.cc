@@ -25,6 +25,11 @@
 #include "defs.h"
 #include "filterdefs.h"
 #include "height.h"
+#include <QtCore/QByteArray>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QList>
+#include <QtCore/QString>
 #include <cmath>
 #include <cstdlib>
 
@@ -49,6 +54,106 @@ double HeightFilter::bilinear(double x1, double y1, double x2, double y2, double
   return (z22*(y-y1)*(x-x1)+z12*(y2-y)*(x-x1)+z21*(y-y1)*(x2-x)+z11*(y2-y)*(x2-x))/delta;
 }
 
+/*
+ * Map the data of a GeographicLib geoid file, e.g. egm96-5.pgm or
+ * egm2008-2_5.pgm.  The header looks like
+ *   P5
+ *   # Offset -108
+ *   # Scale 0.003
+ *   4320 2161
+ *   65535
+ * followed by the samples.
+ */
+void HeightFilter::geoid_load(const char* fname)
+{
+  geoid_file = new QFile(QString::fromUtf8(fname));
+  if (!geoid_file->open(QIODevice::ReadOnly)) {
+    fatal(MYNAME ": Cannot open geoid file \"%s\".\n", fname);
+  }
+
+  if (geoid_file->readLine().trimmed() != "P5") {
+    fatal(MYNAME ": \"%s\" is not a binary PGM geoid file.\n", fname);
+  }
+
+  bool have_offset = false;
+  bool have_scale = false;
+  QByteArray line;
+  for (line = geoid_file->readLine(); line.startsWith('#'); line = geoid_file->readLine()) {
+    QList<QByteArray> words = line.mid(1).simplified().split(' ');
+    if (words.size() == 2 && words.at(0) == "Offset") {
+      geoid_offset = words.at(1).toDouble(&have_offset);
+    } else if (words.size() == 2 && words.at(0) == "Scale") {
+      geoid_scale = words.at(1).toDouble(&have_scale);
+    }
+  }
+  QList<QByteArray> dims = line.simplified().split(' ');
+  if (dims.size() == 2) {
+    geoid_width = dims.at(0).toInt();
+    geoid_height = dims.at(1).toInt();
+  }
+  QByteArray maxval = geoid_file->readLine().trimmed();
+
+  qint64 start = geoid_file->pos();
+  if (!have_offset || !have_scale || maxval != "65535" ||
+      geoid_width < 2 || geoid_height < 2 ||
+      geoid_file->size() - start != (qint64) geoid_width * geoid_height * 2) {
+    fatal(MYNAME ": Invalid or unsupported geoid file \"%s\".\n", fname);
+  }
+
+  geoid_data = geoid_file->map(start, geoid_file->size() - start);
+  if (geoid_data == nullptr) {
+    fatal(MYNAME ": Cannot map geoid file \"%s\".\n", fname);
+  }
+}
+
+/* return the geoid height at a grid node, wrapping around in longitude */
+double HeightFilter::geoid_sample(int row, int col) const
+{
+  row = qBound(0, row, geoid_height - 1);
+  col %= geoid_width;
+  if (col < 0) {
+    col += geoid_width;
+  }
+  return geoid_offset + geoid_scale * be_readu16(geoid_data + 2 * ((qint64) row * geoid_width + col));
+}
+
+/* return geoid separation (MSL - WGS84) in meters from the loaded grid */
+double HeightFilter::geoid_separation(double lat, double lon) const
+{
+  /* The grid spans the whole globe, rows 90 .. -90, columns 0 .. 360 - step. */
+  double step = 360.0 / geoid_width;
+  double x = (lon < 0.0 ? lon + 360.0 : lon) / step;
+  double y = (90.0 - lat) / step;
+  int col = (int)floor(x);
+  int row = qMin((int)floor(y), geoid_height - 2);
+  double fx = x - col;
+  double fy = y - row;
+
+  if (!bicubicopt) {
+    return (1.0 - fy) * ((1.0 - fx) * geoid_sample(row, col) + fx * geoid_sample(row, col + 1)) +
+           fy * ((1.0 - fx) * geoid_sample(row + 1, col) + fx * geoid_sample(row + 1, col + 1));
+  }
+
+  /* Cubic convolution (Keys, a = -0.5) over the surrounding 4x4 nodes. */
+  double wx[4];
+  double wy[4];
+  for (int i = 0; i < 4; i++) {
+    double dx = fabs(fx - (i - 1));
+    double dy = fabs(fy - (i - 1));
+    wx[i] = (dx <= 1.0) ? (1.5 * dx - 2.5) * dx * dx + 1.0 : ((-0.5 * dx + 2.5) * dx - 4.0) * dx + 2.0;
+    wy[i] = (dy <= 1.0) ? (1.5 * dy - 2.5) * dy * dy + 1.0 : ((-0.5 * dy + 2.5) * dy - 4.0) * dy + 2.0;
+  }
+  double sum = 0.0;
+  for (int j = 0; j < 4; j++) {
+    double rowsum = 0.0;
+    for (int i = 0; i < 4; i++) {
+      rowsum += wx[i] * geoid_sample(row + j - 1, col + i - 1);
+    }
+    sum += wy[j] * rowsum;
+  }
+  return sum;
+}
+
 /* return geoid separation (MSL - WGS84) in meters, given a lat/lot in degrees */
 double HeightFilter::wgs84_separation(double lat, double lon)
 {
@@ -63,6 +168,10 @@ double HeightFilter::wgs84_separation(double lat, double lon)
     fatal(MYNAME ": Invalid longitude value (%f)\n", lon);
   }
 
+  if (geoid_data != nullptr) {
+    return geoid_separation(lat, lon);
+  }
+
   int ilat = (int)floor((90.0+lat)/GEOID_GRID_DEG);
   int ilon = (int)floor((180.0+lon)/GEOID_GRID_DEG);
 
@@ -82,6 +191,97 @@ double HeightFilter::wgs84_separation(double lat, double lon)
          );
 }
 
+/*
+ * Return the tile covering the cell with south west corner lat/lon,
+ * mapping it from the dem directory if it isn't in the cache yet.
+ * Returns nullptr if there is no usable tile for that cell.
+ */
+const HeightFilter::DemTile* HeightFilter::dem_find_tile(int lat, int lon)
+{
+  for (int i = 0; i < dem_tiles.size(); i++) {
+    if ((dem_tiles.at(i).lat == lat) && (dem_tiles.at(i).lon == lon)) {
+      if (i != 0) {
+        dem_tiles.move(i, 0);
+      }
+      return (dem_tiles.first().file != nullptr) ? &dem_tiles.first() : nullptr;
+    }
+  }
+
+  if (dem_tiles.size() >= kMaxDemTiles) {
+    dem_close_tile(dem_tiles.takeLast());
+  }
+
+  DemTile tile = { lat, lon, nullptr, nullptr, 0 };
+  QString name = QString("%1%2%3%4.hgt")
+                 .arg((lat < 0) ? 'S' : 'N')
+                 .arg(abs(lat), 2, 10, QChar('0'))
+                 .arg((lon < 0) ? 'W' : 'E')
+                 .arg(abs(lon), 3, 10, QChar('0'));
+  QDir dir(QString::fromUtf8(demopt));
+
+  for (const auto& candidate : {name, name.toLower()}) {
+    auto* file = new QFile(dir.filePath(candidate));
+    if (file->open(QIODevice::ReadOnly)) {
+      qint64 bytes = file->size();
+      int size = lround(sqrt(bytes / 2.0));
+      const uchar* data = (size >= 2) && ((qint64) size * size * 2 == bytes) ?
+                          file->map(0, bytes) : nullptr;
+      if (data != nullptr) {
+        tile.file = file;
+        tile.data = data;
+        tile.size = size;
+        break;
+      }
+      warning(MYNAME ": Ignoring %s, it is not a valid .hgt tile.\n", qPrintable(file->fileName()));
+    }
+    delete file;
+  }
+
+  dem_tiles.prepend(tile);
+  return (tile.file != nullptr) ? &dem_tiles.first() : nullptr;
+}
+
+void HeightFilter::dem_close_tile(const DemTile& tile)
+{
+  if (tile.file != nullptr) {
+    tile.file->unmap(const_cast<uchar*>(tile.data));
+    tile.file->close();
+    delete tile.file;
+  }
+}
+
+/* return the terrain height above MSL in meters, or unknown_alt */
+double HeightFilter::dem_elevation(double lat, double lon)
+{
+  int tlat = (int)floor(lat);
+  int tlon = (int)floor(lon);
+  const DemTile* tile = dem_find_tile(tlat, tlon);
+  if (tile == nullptr) {
+    return unknown_alt;
+  }
+
+  int last = tile->size - 1;
+  /* fractional sample position, rows counted southward from the north edge */
+  double x = (lon - tlon) * last;
+  double y = (tlat + 1 - lat) * last;
+  int col1 = qBound(0, (int)floor(x), last);
+  int row1 = qBound(0, (int)floor(y), last);
+  int col2 = (col1 < last) ? col1 + 1 : col1;
+  int row2 = (row1 < last) ? row1 + 1 : row1;
+
+  int z[4];
+  const int rows[4] = { row1, row1, row2, row2 };
+  const int cols[4] = { col1, col2, col1, col2 };
+  for (int i = 0; i < 4; i++) {
+    z[i] = (int16_t) be_readu16(tile->data + 2 * ((qint64) rows[i] * tile->size + cols[i]));
+    if (z[i] == -32768) {	/* void in the source data */
+      return unknown_alt;
+    }
+  }
+
+  return bilinear(col1, row1, col2, row2, x, y, z[0], z[1], z[2], z[3]);
+}
+
 void HeightFilter::correct_height(const Waypoint* wpt)
 {
   Waypoint* waypointp = const_cast<Waypoint*>(wpt);
@@ -94,6 +294,9 @@ void HeightFilter::correct_height(const Waypoint* wpt)
     if (wgs84tomslopt) {
       waypointp->altitude -= wgs84_separation(waypointp->latitude, waypointp->longitude);
     }
+  } else if (demopt) {
+    /* .hgt heights are already relative to MSL, so no correction applies. */
+    waypointp->altitude = dem_elevation(waypointp->latitude, waypointp->longitude);
   }
 }
 
@@ -112,6 +315,14 @@ void HeightFilter::init()
   } else {
     addf = 0.0;
   }
+
+  if (geoidopt) {
+    geoid_load(geoidopt);
+  }
+
+  if (demopt && !QDir(QString::fromUtf8(demopt)).exists()) {
+    fatal(MYNAME ": DEM directory \"%s\" does not exist.\n", demopt);
+  }
 }
 
 void HeightFilter::process()
@@ -123,4 +334,19 @@ void HeightFilter::process()
   track_disp_all(nullptr, nullptr, correct_height_f);
 }
 
+void HeightFilter::deinit()
+{
+  while (!dem_tiles.isEmpty()) {
+    dem_close_tile(dem_tiles.takeFirst());
+  }
+
+  if (geoid_file != nullptr) {
+    geoid_file->unmap(const_cast<uchar*>(geoid_data));
+    geoid_file->close();
+    delete geoid_file;
+    geoid_file = nullptr;
+    geoid_data = nullptr;
+  }
+}
+
 #endif // FILTERS_ENABLED
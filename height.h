@@ -24,6 +24,9 @@
 #ifndef HEIGHT_H_INCLUDED_
 #define HEIGHT_H_INCLUDED_
 
+#include <QtCore/QFile>  // for QFile
+#include <QtCore/QList>  // for QList
+#include <QtCore/QString>  // for QString
 #include "defs.h"    // for ARG_NOMINMAX, Waypoint (ptr only), arglist_t
 #include "filter.h"  // for Filter
 
@@ -38,26 +41,77 @@ public:
   }
   void init() override;
   void process() override;
+  void deinit() override;
 
 private:
+  /*
+   * One SRTM .hgt tile covering the 1x1 degree cell whose south west
+   * corner is lat/lon.  A tile we looked for but could not find is
+   * remembered with a null file so we don't search for it again.
+   */
+  struct DemTile {
+    int lat;
+    int lon;
+    QFile* file;
+    const uchar* data;	/* big endian int16 samples, north row first */
+    int size;		/* samples per row and column, 1201 or 3601 */
+  };
+
+  /* Number of tiles kept mapped at the same time. */
+  static const int kMaxDemTiles = 16;
+
   char* addopt        = nullptr;
+  char* demopt        = nullptr;
   char* wgs84tomslopt = nullptr;
+  char* geoidopt      = nullptr;
+  char* bicubicopt    = nullptr;
   double addf;
+  QList<DemTile> dem_tiles;	/* most recently used first */
 
-  arglist_t args[3] = {
+  /*
+   * Geoid grid loaded from a GeographicLib .pgm file: big endian
+   * uint16 samples, north row first, columns starting at 0 degrees
+   * east.  The height is geoid_offset + geoid_scale * sample.
+   */
+  QFile* geoid_file = nullptr;
+  const uchar* geoid_data = nullptr;
+  int geoid_width = 0;
+  int geoid_height = 0;
+  double geoid_offset = 0.0;
+  double geoid_scale = 0.0;
+
+  arglist_t args[6] = {
     {
       "add", &addopt, "Adds a constant value to every altitude (meter, append \"f\" (x.xxf) for feet)",
       nullptr, ARGTYPE_BEGIN_REQ | ARGTYPE_FLOAT, ARG_NOMINMAX, nullptr
     },
+    {
+      "dem", &demopt, "Fills unknown altitudes from the SRTM .hgt tiles in this directory",
+      nullptr, ARGTYPE_STRING, ARG_NOMINMAX, nullptr
+    },
     {
       "wgs84tomsl", &wgs84tomslopt, "Converts WGS84 ellipsoidal height to orthometric height (MSL)",
       nullptr, ARGTYPE_END_REQ | ARGTYPE_BOOL, ARG_NOMINMAX, nullptr
     },
+    {
+      "geoid", &geoidopt, "Geoid grid file (GeographicLib .pgm) used by wgs84tomsl",
+      nullptr, ARGTYPE_FILE, ARG_NOMINMAX, nullptr
+    },
+    {
+      "bicubic", &bicubicopt, "Use bicubic instead of bilinear interpolation of the geoid file",
+      nullptr, ARGTYPE_BOOL, ARG_NOMINMAX, nullptr
+    },
     ARG_TERMINATOR
   };
 
   double bilinear(double x1, double y1, double x2, double y2, double x, double y, double z11, double z12, double z21, double z22);
   double wgs84_separation(double lat, double lon);
+  void geoid_load(const char* fname);
+  double geoid_sample(int row, int col) const;
+  double geoid_separation(double lat, double lon) const;
+  const DemTile* dem_find_tile(int lat, int lon);
+  void dem_close_tile(const DemTile& tile);
+  double dem_elevation(double lat, double lon);
   void correct_height(const Waypoint* wpt);
 
 };
@@ -164,7 +164,7 @@ hiketech_waypt_pr(const Waypoint* wpt)
   writer.writeStartElement(QStringLiteral("wpt")); 
   writer.setAutoFormattingIndent(-1);
   writer.writeTextElement(QStringLiteral("ident"), wpt->shortname);
-  writer.writeTextElement(QStringLiteral("sym"), wpt->icon_descr);
+  writer.writeTextElement(QStringLiteral("sym"), wpt->GetIconDescr());
   writer.writeTextElement(QStringLiteral("lat"), QString::number(wpt->latitude, 'f', 6));
   writer.writeTextElement(QStringLiteral("long"), QString::number(wpt->longitude, 'f', 6));
   writer.writeStartElement(QStringLiteral("color")); 
@@ -205,7 +205,7 @@ void  	ht_ident(xg_string args, const QXmlStreamAttributes*)
 static
 void 	ht_sym(xg_string args, const QXmlStreamAttributes*)
 {
-  wpt_tmp->icon_descr = args;
+  wpt_tmp->SetIconDescr(args);
 }
 
 static
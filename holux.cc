@@ -110,7 +110,7 @@ static void data_read()
     desc[sizeof(pWptHxTmp->comment)]=0;
 
     wpt_tmp->shortname = name;
-    wpt_tmp->description = desc;
+    wpt_tmp->SetDescription(desc);
 
     wpt_tmp->SetCreationTime(0);
     if (pWptHxTmp->date.year) {
@@ -207,8 +207,8 @@ static void holux_disp(const Waypoint* wpt)
   }
 
   memset(pWptHxTmp->comment,0x20,sizeof(pWptHxTmp->comment));
-  if (wpt->description != nullptr) {
-    strncpy(pWptHxTmp->comment, mknshort(CSTRc(wpt->description),sizeof(pWptHxTmp->comment)),sizeof(pWptHxTmp->comment));
+  if (wpt->GetDescription() != nullptr) {
+    strncpy(pWptHxTmp->comment, mknshort(CSTRc(wpt->GetDescription()),sizeof(pWptHxTmp->comment)),sizeof(pWptHxTmp->comment));
   }
 
   /*set the time */
@@ -100,14 +100,14 @@ html_disp(const Waypoint* wpt)
     gbfprintf(file_out, " alt:%d", (int)((altunits[0]=='f')?METERS_TO_FEET(wpt->altitude):wpt->altitude));
   }
   gbfprintf(file_out, "<br>\n");
-  if (wpt->description != wpt->shortname) {
+  if (wpt->GetDescription() != wpt->shortname) {
     if (wpt->HasUrlLink()) {
-      char* d = html_entitize(CSTRc(wpt->description));
+      char* d = html_entitize(CSTRc(wpt->GetDescription()));
       UrlLink link = wpt->GetUrlLink();
       gbfprintf(file_out, "<a href=\"%s\">%s</a>", CSTR(link.url_), d);
       xfree(d);
     } else {
-      gbfprintf(file_out, "%s", CSTRc(wpt->description));
+      gbfprintf(file_out, "%s", CSTRc(wpt->GetDescription()));
     }
     if (!wpt->gc_data->placer.isEmpty()) {
       gbfprintf(file_out, " by %s", CSTR(wpt->gc_data->placer));
@@ -146,8 +146,8 @@ html_disp(const Waypoint* wpt)
       hint = wpt->gc_data->hint;
     }
     gbfprintf(file_out, "<p class=\"gpsbabelhint\"><strong>Hint:</strong> %s</p>\n", CSTR(hint));
-  } else if (!wpt->notes.isEmpty() && (wpt->description.isEmpty() || wpt->notes != wpt->description)) {
-    gbfprintf(file_out, "<p class=\"gpsbabelnotes\">%s</p>\n", CSTRc(wpt->notes));
+  } else if (!wpt->GetNotes().isEmpty() && (wpt->GetDescription().isEmpty() || wpt->GetNotes() != wpt->GetDescription())) {
+    gbfprintf(file_out, "<p class=\"gpsbabelnotes\">%s</p>\n", CSTRc(wpt->GetNotes()));
   }
 
   fs_xml* fs_gpx = nullptr;
@@ -233,7 +233,7 @@ static void
 html_index(const Waypoint* wpt)
 {
   char* sn = html_entitize(wpt->shortname);
-  char* d = html_entitize(wpt->description);
+  char* d = html_entitize(wpt->GetDescription());
 
   gbfprintf(file_out, "<a href=\"#%s\">%s - %s</a><br>\n", sn, sn, d);
 
@@ -301,7 +301,7 @@ humminbird_read_wpt(gbfile* fin)
 
   int num_icons = sizeof(humminbird_icons) / sizeof(humminbird_icons[0]);
   if (w.icon < num_icons) {
-    wpt->icon_descr = humminbird_icons[w.icon];
+    wpt->SetIconDescr(humminbird_icons[w.icon]);
   }
 
   // In newer versions, this is an enum (though it looks like a bitfield)
@@ -672,9 +672,9 @@ humminbird_write_waypoint(const Waypoint* wpt)
   hum.icon   = 255;
 
   // Icon....
-  if (!wpt->icon_descr.isNull()) {
+  if (!wpt->GetIconDescr().isNull()) {
     for (int i = 0; i < num_icons; i++) {
-      if (!wpt->icon_descr.compare(humminbird_icons[i], Qt::CaseInsensitive)) {
+      if (!wpt->GetIconDescr().compare(humminbird_icons[i], Qt::CaseInsensitive)) {
         hum.icon = i;
         break;
       }
@@ -684,7 +684,7 @@ humminbird_write_waypoint(const Waypoint* wpt)
       for (int i = 0; i < num_icons; i++) {
         char* match;
         xasprintf(&match, "*%s*", humminbird_icons[i]);
-        int j = wpt->icon_descr.compare(match, Qt::CaseInsensitive);
+        int j = wpt->GetIconDescr().compare(match, Qt::CaseInsensitive);
         xfree(match);
         if (j != 0) {
           hum.icon = i;
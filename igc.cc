@@ -25,6 +25,7 @@
 
 #include "defs.h"
 #include "cet_util.h"
+#include "src/core/timeindex.h"
 #include <cerrno>
 #include <cmath>
 #include <cstdio>
@@ -210,7 +211,7 @@ static void igc_task_rec(const char* rec)
                    (lon_deg + (lon_min * 1000 + lon_frac) / 1000.0 / 60);
 
   wpt->SetCreationTime(creation);
-  wpt->description = tmp_str;
+  wpt->SetDescription(tmp_str);
 
   // Name the waypoint according to the order of the task record
   switch (state) {
@@ -619,9 +620,9 @@ static void wr_header()
 // FIXME: This almost certainly introduces a memory leak because str
 // is a c string that's used for totally too many things.  Just let it
 // leak for now. 2013-12-31 robertl
-    if (nullptr != (wpt = find_waypt_by_name("PILOT")) && !wpt->description.isEmpty()) {
+    if (nullptr != (wpt = find_waypt_by_name("PILOT")) && !wpt->GetDescription().isEmpty()) {
       xfree(str);
-      str = xstrdup(CSTRc(wpt->description));
+      str = xstrdup(CSTRc(wpt->GetDescription()));
 #else
     if (NULL != (wpt = find_waypt_by_name("PILOT")) && wpt->description) {
       str = CSTRc(wpt->description);
@@ -644,7 +645,7 @@ static void wr_header()
 static void wr_task_wpt_name(const Waypoint* wpt, const char* alt_name)
 {
   gbfprintf(file_out, "C%s%s\r\n", latlon2str(wpt),
-            !wpt->description.isEmpty() ? CSTR(wpt->description) : !wpt->shortname.isEmpty() ? CSTR(wpt->shortname) : alt_name);
+            !wpt->GetDescription().isEmpty() ? CSTR(wpt->GetDescription()) : !wpt->shortname.isEmpty() ? CSTR(wpt->shortname) : alt_name);
 }
 
 static void wr_task_hdr(const route_head* rte)
@@ -806,53 +807,6 @@ static int correlate_tracks(const route_head* pres_track, const route_head* gnss
   return time_diff;
 }
 
-/**
- * Interpolate altitude from a track at a given time.
- * @param  track  The track containing altitude data.
- * @param  time   The time that we are interested in.
- * @return  The altitude interpolated from the track.
- */
-static double interpolate_alt(const route_head* track, time_t time)
-{
-  static const queue* prev_elem = nullptr;
-  static const queue* curr_elem = nullptr;
-  int time_diff;
-
-  // Start search at the beginning of the track
-  if (!prev_elem) {
-    curr_elem = prev_elem = QUEUE_FIRST(&track->waypoint_list);
-  }
-  // Find the track points either side of the requested time
-  while ((reinterpret_cast<const Waypoint *>(curr_elem))->GetCreationTime().toTime_t() < time) {
-    if (QUEUE_LAST(&track->waypoint_list) == curr_elem) {
-      // Requested time later than all track points, we can't interpolate
-      return unknown_alt;
-    }
-    prev_elem = curr_elem;
-    curr_elem = QUEUE_NEXT(prev_elem);
-  }
-
-  const Waypoint* prev_wpt = reinterpret_cast<const Waypoint *>(prev_elem);
-  const Waypoint* curr_wpt = reinterpret_cast<const Waypoint *>(curr_elem);
-
-  if (QUEUE_FIRST(&track->waypoint_list) == curr_elem) {
-    if (curr_wpt->GetCreationTime().toTime_t() == time) {
-      // First point's creation time is an exact match so use it's altitude
-      return curr_wpt->altitude;
-    } else {
-      // Requested time is prior to any track points, we can't interpolate
-      return unknown_alt;
-    }
-  }
-  // Interpolate
-  if (0 == (time_diff = curr_wpt->GetCreationTime().toTime_t() - prev_wpt->GetCreationTime().toTime_t())) {
-    // Avoid divide by zero
-    return curr_wpt->altitude;
-  }
-  double alt_diff = curr_wpt->altitude - prev_wpt->altitude;
-  return prev_wpt->altitude + (alt_diff / time_diff) * (time - prev_wpt->GetCreationTime().toTime_t());
-}
-
 /*
  * Pressure altitude and GNSS altitude may be provided in two separate
  * tracks.  This function attempts to merge them into one.
@@ -880,13 +834,15 @@ static void wr_track()
     if (global_opts.debug_level >= 1) {
       printf(MYNAME ": adjusting time by %ds\n", time_adj);
     }
-    // Iterate through waypoints in both tracks simultaneously
+    // Interpolate the pressure altitude for each GNSS point
+    const gpsbabel::TimeIndex pres_index(pres_track);
     const queue* elem;
     const queue* tmp;
     QUEUE_FOR_EACH(&gnss_track->waypoint_list, elem, tmp) {
       // FIXME(NEW_Q): the excessive casting of the iterators is gross. Rethink.
       const Waypoint* wpt = reinterpret_cast<const Waypoint*>(elem);
-      double pres_alt = interpolate_alt(pres_track, wpt->GetCreationTime().toTime_t() + time_adj);
+      qint64 time = wpt->GetCreationTime().toMSecsSinceEpoch() + time_adj * 1000LL;
+      double pres_alt = pres_index.interpolate_altitude(time);
       wr_fix_record(wpt, pres_alt, wpt->altitude);
     }
   } else {
@@ -61,7 +61,7 @@ ikt_object_end()
     track_add_head(track);
   } else if (waypt) {
     waypt->shortname = name;
-    waypt->description = text;
+    waypt->SetDescription(text);
     waypt_add(waypt);
   }
 
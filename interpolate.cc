@@ -77,7 +77,7 @@ void InterpolateFilter::process()
             Waypoint* wpt_new = new Waypoint(*wpt);
             wpt_new->SetCreationTime(timen);
             wpt_new->shortname = QString();
-            wpt_new->description = QString();
+            wpt_new->SetDescription(QString());
 
             frac = (double)(timen - time1) / (double)(wpt->creation_time.toTime_t() - time1);
             linepart(lat1, lon1,
@@ -109,7 +109,7 @@ void InterpolateFilter::process()
               frac = distn / curdist;
               wpt_new->SetCreationTime(frac * (wpt->creation_time.toTime_t() - time1) + time1);
               wpt_new->shortname = QString();
-              wpt_new->description = QString();
+              wpt_new->SetDescription(QString());
               linepart(lat1, lon1,
                        wpt->latitude, wpt->longitude,
                        frac,
@@ -46,46 +46,46 @@
 #include <tuple>
 
 // options
-static char* opt_deficon = nullptr;
-static char* opt_export_lines = nullptr;
-static char* opt_export_points = nullptr;
-static char* opt_export_track = nullptr;
-static char* opt_line_width = nullptr;
-static char* opt_line_color = nullptr;
-static char* opt_floating = nullptr;
-static char* opt_extrude = nullptr;
-static char* opt_trackdata = nullptr;
-static char* opt_trackdirection = nullptr;
-static char* opt_units = nullptr;
-static char* opt_labels = nullptr;
-static char* opt_max_position_points = nullptr;
-static char* opt_rotate_colors = nullptr;
-static char* opt_precision = nullptr;
-
-static int export_lines;
-static int export_points;
-static int export_track;
-static int floating;
-static int extrude;
-static int trackdata;
-static int trackdirection;
-static int max_position_points;
-static int rotate_colors;
-static int line_width;
-static int html_encrypt;
-static int precision;
-
-static Waypoint* wpt_tmp;
-static int wpt_tmp_queued;
-static QString posnfilename;
-static QString posnfilenametmp;
-
-static route_head* gx_trk_head;
-static QList<gpsbabel::DateTime>* gx_trk_times;
-static QList<std::tuple<int, double, double, double>>* gx_trk_coords;
-
-static gpsbabel::File* oqfile;
-static gpsbabel::XmlStreamWriter* writer;
+static thread_local char* opt_deficon = nullptr;
+static thread_local char* opt_export_lines = nullptr;
+static thread_local char* opt_export_points = nullptr;
+static thread_local char* opt_export_track = nullptr;
+static thread_local char* opt_line_width = nullptr;
+static thread_local char* opt_line_color = nullptr;
+static thread_local char* opt_floating = nullptr;
+static thread_local char* opt_extrude = nullptr;
+static thread_local char* opt_trackdata = nullptr;
+static thread_local char* opt_trackdirection = nullptr;
+static thread_local char* opt_units = nullptr;
+static thread_local char* opt_labels = nullptr;
+static thread_local char* opt_max_position_points = nullptr;
+static thread_local char* opt_rotate_colors = nullptr;
+static thread_local char* opt_precision = nullptr;
+
+static thread_local int export_lines;
+static thread_local int export_points;
+static thread_local int export_track;
+static thread_local int floating;
+static thread_local int extrude;
+static thread_local int trackdata;
+static thread_local int trackdirection;
+static thread_local int max_position_points;
+static thread_local int rotate_colors;
+static thread_local int line_width;
+static thread_local int html_encrypt;
+static thread_local int precision;
+
+static thread_local Waypoint* wpt_tmp;
+static thread_local int wpt_tmp_queued;
+static thread_local QString posnfilename;
+static thread_local QString posnfilenametmp;
+
+static thread_local route_head* gx_trk_head;
+static thread_local QList<gpsbabel::DateTime>* gx_trk_times;
+static thread_local QList<std::tuple<int, double, double, double>>* gx_trk_coords;
+
+static thread_local gpsbabel::File* oqfile;
+static thread_local gpsbabel::XmlStreamWriter* writer;
 
 typedef enum  {
   kmlpt_unknown,
@@ -96,10 +96,10 @@ typedef enum  {
   kmlpt_other
 } kml_point_type;
 
-static int realtime_positioning;
-static bounds kml_bounds;
-static gpsbabel::DateTime kml_time_min;
-static gpsbabel::DateTime kml_time_max;
+static thread_local int realtime_positioning;
+static thread_local bounds kml_bounds;
+static thread_local gpsbabel::DateTime kml_time_min;
+static thread_local gpsbabel::DateTime kml_time_max;
 
 #define DEFAULT_PRECISION "6"
 
@@ -114,7 +114,7 @@ static const char kmt_depth[] = "depth";
 static const char kmt_power[] = "power";
 
 
-static
+static thread_local
 arglist_t kml_args[] = {
   {"deficon", &opt_deficon, "Default icon name", nullptr, ARGTYPE_STRING, ARG_NOMINMAX, nullptr },
   {
@@ -207,7 +207,7 @@ struct {
 #define ICON_MULTI_TRK ICON_BASE "track-directional/track-0.png"
 #define ICON_DIR ICON_BASE "track-directional/track-%1.png" // format string where next arg is rotational degrees.
 
-static struct {
+static thread_local struct {
   float seq{0.0f};
   float step{0.0f};
   gb_color color;
@@ -306,7 +306,7 @@ const char* kml_tags_to_ignore[] = {
 };
 
 // The TimeSpan/begin and TimeSpan/end DateTimes:
-static gpsbabel::DateTime wpt_timespan_begin, wpt_timespan_end;
+static thread_local gpsbabel::DateTime wpt_timespan_begin, wpt_timespan_end;
 
 void wpt_s(xg_string, const QXmlStreamAttributes*)
 {
@@ -350,7 +350,7 @@ void wpt_desc(const QString& args, const QXmlStreamAttributes*)
   if (!wpt_tmp) {
     fatal(MYNAME ": wpt_desc: invalid kml file\n");
   }
-  wpt_tmp->description += args.trimmed();
+  wpt_tmp->SetDescription(wpt_tmp->GetDescription() + args.trimmed());
 }
 
 void wpt_time(xg_string args, const QXmlStreamAttributes*)
@@ -392,7 +392,7 @@ void wpt_coord(const QString& args, const QXmlStreamAttributes*)
 void wpt_icon(xg_string args, const QXmlStreamAttributes*)
 {
   if (wpt_tmp)  {
-    wpt_tmp->icon_descr = args;
+    wpt_tmp->SetIconDescr(args);
   }
 }
 
@@ -460,8 +460,8 @@ void gx_trk_s(xg_string, const QXmlStreamAttributes*)
   if (wpt_tmp && !wpt_tmp->shortname.isEmpty()) {
     gx_trk_head->rte_name  = wpt_tmp->shortname;
   }
-  if (wpt_tmp && !wpt_tmp->description.isEmpty()) {
-    gx_trk_head->rte_desc  = wpt_tmp->description;
+  if (wpt_tmp && !wpt_tmp->GetDescription().isEmpty()) {
+    gx_trk_head->rte_desc  = wpt_tmp->GetDescription();
   }
   track_add_head(gx_trk_head);
   delete gx_trk_times;
@@ -1642,8 +1642,8 @@ static void kml_waypt_pr(const Waypoint* waypointp)
       writer->writeTextElement(QStringLiteral("description"), link.url_);
     }
   } else {
-    if (waypointp->shortname != waypointp->description) {
-      writer->writeOptionalTextElement(QStringLiteral("description"), waypointp->description);
+    if (waypointp->shortname != waypointp->GetDescription()) {
+      writer->writeOptionalTextElement(QStringLiteral("description"), waypointp->GetDescription());
     }
   }
 
@@ -1651,7 +1651,7 @@ static void kml_waypt_pr(const Waypoint* waypointp)
   kml_output_timestamp(waypointp);
 
   // Icon - but only if it looks like a URL.
-  icon = opt_deficon ? opt_deficon : waypointp->icon_descr;
+  icon = opt_deficon ? opt_deficon : waypointp->GetIconDescr();
   if (icon.contains("://")) {
     writer->writeStartElement(QStringLiteral("Style"));
     writer->writeStartElement(QStringLiteral("IconStyle"));
@@ -2148,12 +2148,12 @@ kml_get_posn_icon(int freshness)
 }
 
 
-static route_head* posn_trk_head = nullptr;
+static thread_local route_head* posn_trk_head = nullptr;
 
 static void
 kml_wr_position(Waypoint* wpt)
 {
-  static gpsbabel::DateTime last_valid_fix;
+  static thread_local gpsbabel::DateTime last_valid_fix;
 
   kml_wr_init(posnfilenametmp);
 
@@ -2185,7 +2185,7 @@ kml_wr_position(Waypoint* wpt)
     last_valid_fix = wpt->GetCreationTime();
   }
 
-  wpt->icon_descr = kml_get_posn_icon(wpt->GetCreationTime().toTime_t() - last_valid_fix.toTime_t());
+  wpt->SetIconDescr(kml_get_posn_icon(wpt->GetCreationTime().toTime_t() - last_valid_fix.toTime_t()));
 
 
   /* In order to avoid clutter while we're sitting still, don't add
@@ -2224,7 +2224,7 @@ kml_wr_position(Waypoint* wpt)
   kml_wr_deinit();
 }
 
-ff_vecs_t kml_vecs = {
+thread_local ff_vecs_t kml_vecs = {
   ff_type_file,
   FF_CAP_RW_ALL, /* Format can do RW_ALL */
   kml_rd_init,
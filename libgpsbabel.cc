@@ -0,0 +1,271 @@
+/*
+    In-process conversion API.
+
+    Copyright (C) 2019 Robert Lipe, gpsbabel.org
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111 USA
+
+ */
+
+#include "libgpsbabel.h"
+
+#include "defs.h"
+#include "cet_util.h"               // for cet_convert_init, cet_convert_strings, cet_convert_deinit, cet_register
+#include "context.h"                // for ConversionContext
+#include "filter.h"                 // for Filter
+#include "filterdefs.h"             // for find_filter_vec, free_filter_vec, init_filter_vecs
+#include "inifile.h"                // for inifile_init
+#include "session.h"                // for start_session
+#include "src/core/usasciicodec.h"  // for UsAsciiCodec
+
+#include <QtCore/QAtomicInt>        // for QAtomicInt
+#include <QtCore/QMutex>            // for QMutex
+#include <QtCore/QMutexLocker>      // for QMutexLocker
+#include <QtCore/QReadWriteLock>    // for QReadWriteLock
+
+#include <ctime>                    // for time
+#include <functional>               // for function
+#include <utility>                  // for move
+
+#define MYNAME "libgpsbabel"
+
+namespace gpsbabel
+{
+
+/*
+ * Conversions that only use reentrant formats hold this for reading and
+ * run side by side, any other conversion holds it for writing.
+ */
+static QReadWriteLock convert_lock;
+static QMutex init_mutex;
+static bool initialized = false;
+static QAtomicInt serial;
+/* The options every conversion starts with. */
+static global_options library_opts;
+
+/* The setup main() does for the gpsbabel program that all threads share. */
+static void
+library_init()
+{
+  QMutexLocker locker(&init_mutex);
+
+  if (initialized) {
+    return;
+  }
+
+  (void) new gpsbabel::UsAsciiCodec(); /* make sure a US-ASCII codec is available */
+
+  library_opts.objective = wptdata;
+  library_opts.masked_objective = NOTHINGMASK;
+  library_opts.inifile = nullptr;
+
+  gpsbabel_now = time(nullptr);
+  gpsbabel_time = current_time().toTime_t();
+  if (gpsbabel_time != 0) {	/* within testo ? */
+    library_opts.inifile = inifile_init(QString(), MYNAME);
+  }
+
+  init_filter_vecs();
+  /* cet_find_cs_by_name() would do this on first use, but not safely from several threads. */
+  cet_register();
+
+  initialized = true;
+}
+
+/*
+ * Undoes a stage of a conversion that fatal() left half way, so the
+ * format or filter doesn't keep files and buffers open into the next
+ * conversion on this thread.  A finished stage dismisses its guard and
+ * cleans up as usual.
+ */
+class StageGuard
+{
+public:
+  explicit StageGuard(std::function<void()> cleanup) : cleanup_(std::move(cleanup)) {}
+  StageGuard(const StageGuard&) = delete;
+  StageGuard& operator=(const StageGuard&) = delete;
+  ~StageGuard()
+  {
+    if (cleanup_) {
+      try {
+        cleanup_();
+      } catch (const FatalError&) {
+        /* Already failing, the first error is the one to report. */
+      }
+    }
+  }
+
+  void dismiss()
+  {
+    cleanup_ = nullptr;
+  }
+
+private:
+  std::function<void()> cleanup_;
+};
+
+/* "name,opt=val,..." as find_vec() and find_filter_vec() expect it. */
+static QByteArray
+spec_string(const FormatSpec& spec)
+{
+  QString s = spec.name;
+
+  for (const auto& opt : spec.options) {
+    if (opt.first.contains(',') || opt.second.contains(',')) {
+      fatal(MYNAME ": The option '%s' of '%s' contains a comma.\n",
+            qPrintable(opt.first), qPrintable(spec.name));
+    }
+    s.append(',');
+    s.append(opt.first);
+    if (!opt.second.isEmpty()) {
+      s.append('=');
+      s.append(opt.second);
+    }
+  }
+  return s.toUtf8();
+}
+
+static void
+convert_one(const ConversionRequest& request, const QString& fname, const QString& ofname)
+{
+  const char* ivec_opts = nullptr;
+  const char* ovec_opts = nullptr;
+  const char* fvec_opts = nullptr;
+
+  global_opts.objective = wptdata;
+  global_opts.masked_objective = NOTHINGMASK;
+  if (request.tracks) {
+    global_opts.objective = trkdata;
+    global_opts.masked_objective |= TRKDATAMASK;
+  }
+  if (request.routes) {
+    global_opts.objective = rtedata;
+    global_opts.masked_objective |= RTEDATAMASK;
+  }
+  if (request.waypoints || doing_nothing) {
+    global_opts.objective = wptdata;
+    global_opts.masked_objective |= WPTDATAMASK;
+  }
+  global_opts.synthesize_shortnames = request.synthesize_shortnames;
+
+  /* find_vec() keeps pointers into the spec, so it has to outlive the conversion. */
+  QByteArray ispec = spec_string(request.input);
+  QByteArray ospec = spec_string(request.output);
+
+  ff_vecs_t* ivecs = find_vec(ispec.constData(), &ivec_opts);
+  if (ivecs == nullptr) {
+    fatal("Input type '%s' not recognized\n", qPrintable(request.input.name));
+  }
+  if (ivecs->rd_init == nullptr) {
+    fatal("Format does not support reading.\n");
+  }
+
+  cet_convert_init(ivecs->encode, ivecs->fixed_encode);	/* init by module vec */
+
+  start_session(ivecs->name, fname);
+  ivecs->rd_init(fname);
+  StageGuard reading([ivecs] { ivecs->rd_deinit(); });
+  ivecs->read();
+  reading.dismiss();
+  ivecs->rd_deinit();
+  track_recompute_invalidate();
+
+  cet_convert_strings(global_opts.charset, nullptr, nullptr);
+  cet_convert_deinit();
+
+  for (const auto& fspec : request.filters) {
+    QByteArray spec = spec_string(fspec);
+    Filter* filter = find_filter_vec(spec.constData(), &fvec_opts);
+    if (filter == nullptr) {
+      fatal("Unknown filter '%s'\n", qPrintable(fspec.name));
+    }
+    StageGuard allocated([filter] { free_filter_vec(filter); });
+    filter->init();
+    StageGuard filtering([filter] { filter->deinit(); });
+    filter->process();
+    filtering.dismiss();
+    filter->deinit();
+    track_recompute_invalidate();
+    allocated.dismiss();
+    free_filter_vec(filter);
+  }
+
+  ff_vecs_t* ovecs = find_vec(ospec.constData(), &ovec_opts);
+  if (ovecs == nullptr) {
+    fatal("Output type '%s' not recognized\n", qPrintable(request.output.name));
+  }
+  if (ovecs->wr_init == nullptr) {
+    fatal("Format does not support writing.\n");
+  }
+
+  cet_convert_init(ovecs->encode, ovecs->fixed_encode);
+  cet_convert_strings(nullptr, global_opts.charset, nullptr);
+
+  ovecs->wr_init(ofname);
+  StageGuard writing([ovecs] { ovecs->wr_deinit(); });
+  ovecs->write();
+  writing.dismiss();
+  ovecs->wr_deinit();
+
+  cet_convert_deinit();
+}
+
+ConversionResult
+convert(const ConversionRequest& request)
+{
+  ConversionResult result;
+
+  library_init();
+
+  if (ConversionContext::is_reentrant(request.input.name) &&
+      ConversionContext::is_reentrant(request.output.name)) {
+    convert_lock.lockForRead();
+  } else {
+    convert_lock.lockForWrite();
+  }
+
+  {
+    ConversionContext context(library_opts);
+
+    /* Names no real file is likely to have; gbfopen() serves them from memory. */
+    int n = serial.fetchAndAddRelaxed(1) + 1;
+    QString fname = QString("[gpsbabel memory input %1]").arg(n);
+    QString ofname = QString("[gpsbabel memory output %1]").arg(n);
+    gbfmem_register(fname, request.input_data);
+    gbfmem_register(ofname, QByteArray());
+
+    fatal_capture(&result.warnings);
+    try {
+      convert_one(request, fname, ofname);
+      result.ok = true;
+    } catch (const FatalError& e) {
+      result.error = e.message;
+      cet_convert_deinit();
+    }
+    fatal_capture(nullptr);
+
+    gbfmem_take(fname);
+    if (result.ok) {
+      result.output_data = gbfmem_take(ofname);
+    } else {
+      gbfmem_take(ofname);
+    }
+  }
+
+  convert_lock.unlock();
+  return result;
+}
+
+} // namespace gpsbabel
@@ -0,0 +1,82 @@
+/*
+    In-process conversion API.
+
+    Copyright (C) 2019 Robert Lipe, gpsbabel.org
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111 USA
+
+ */
+
+#ifndef LIBGPSBABEL_H_INCLUDED_
+#define LIBGPSBABEL_H_INCLUDED_
+
+#include <QtCore/QByteArray>  // for QByteArray
+#include <QtCore/QList>       // for QList
+#include <QtCore/QPair>       // for QPair
+#include <QtCore/QString>     // for QString
+
+namespace gpsbabel
+{
+
+/*
+ * A format or filter and its options, e.g. {"gpx", {{"snlen", "10"}}}.
+ * An option without a value is given an empty one.  Option values may
+ * not contain commas.
+ */
+struct FormatSpec {
+  QString name;
+  QList<QPair<QString, QString>> options;
+};
+
+struct ConversionRequest {
+  FormatSpec input;
+  QByteArray input_data;
+  QList<FormatSpec> filters;
+  FormatSpec output;
+
+  /* The -w, -r and -t options.  With none of them set waypoints are converted. */
+  bool waypoints{false};
+  bool routes{false};
+  bool tracks{false};
+  /* The -s option. */
+  bool synthesize_shortnames{false};
+};
+
+struct ConversionResult {
+  bool ok{false};
+  QByteArray output_data;
+  /* The message of the fatal error that stopped the conversion. */
+  QString error;
+  /* Any warnings, in the order they were issued. */
+  QString warnings;
+};
+
+/*
+ * Run one conversion from memory to memory, as
+ *   gpsbabel -i input -f in [-x filter...] -o output -F out
+ * would.  Formats that read and write through gbfile or gpsbabel::File
+ * are supported; the latter go through a temporary file.
+ *
+ * Errors are reported in the result instead of ending the process.
+ * Calls from different threads run concurrently when both formats are
+ * reentrant (see context.h), otherwise they wait for each other.  Like the
+ * gpsbabel program, the library expects the
+ * C locale for LC_NUMERIC and LC_TIME.
+ */
+ConversionResult convert(const ConversionRequest& request);
+
+} // namespace gpsbabel
+
+#endif // LIBGPSBABEL_H_INCLUDED_
@@ -0,0 +1,12 @@
+# The conversion engine for use in other programs, see libgpsbabel.h.
+include(GPSBabel.pro)
+
+TEMPLATE = lib
+CONFIG += staticlib
+CONFIG -= console
+TARGET = gpsbabel
+
+SOURCES -= main.cc server.cc
+SOURCES += libgpsbabel.cc
+HEADERS += libgpsbabel.h
+QMAKE_EXTRA_TARGETS -= check compile_command_database
@@ -0,0 +1,152 @@
+/*
+    Stress test for concurrent conversions through libgpsbabel.
+
+    Copyright (C) 2019 Robert Lipe, gpsbabel.org
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111 USA
+
+ */
+
+/*
+ * Runs a mix of conversions one by one, and then many times over from
+ * several threads at once.  Every concurrent run has to give the same
+ * output as the sequential one.
+ *
+ * usage: libgpsbabel_stress reference_dir [threads [rounds]]
+ */
+
+#include "libgpsbabel.h"
+
+#include <QtCore/QAtomicInt>   // for QAtomicInt
+#include <QtCore/QByteArray>   // for QByteArray
+#include <QtCore/QFile>        // for QFile
+#include <QtCore/QList>        // for QList
+#include <QtCore/QRunnable>    // for QRunnable
+#include <QtCore/QString>      // for QString
+#include <QtCore/QThreadPool>  // for QThreadPool
+
+#include <cstdio>              // for fprintf, stderr
+#include <cstdlib>             // for atoi, exit
+
+using gpsbabel::ConversionRequest;
+using gpsbabel::ConversionResult;
+using gpsbabel::FormatSpec;
+
+struct StressJob {
+  QString label;
+  ConversionRequest request;
+  QByteArray expected;
+};
+
+static QList<StressJob> jobs;
+static QAtomicInt failures;
+
+static void
+add_job(const QString& dir, const QString& file, const FormatSpec& input,
+        const QList<FormatSpec>& filters, const FormatSpec& output, bool tracks)
+{
+  QFile f(dir + "/" + file);
+  if (!f.open(QIODevice::ReadOnly)) {
+    fprintf(stderr, "Cannot read %s.\n", qPrintable(f.fileName()));
+    exit(1);
+  }
+
+  StressJob job;
+  job.label = QString("%1 to %2").arg(file, output.name);
+  job.request.input = input;
+  job.request.input_data = f.readAll();
+  job.request.filters = filters;
+  job.request.output = output;
+  job.request.tracks = tracks;
+  jobs.append(job);
+}
+
+/* One thread's share: all jobs, starting at a different one each time. */
+class StressRunnable : public QRunnable
+{
+public:
+  explicit StressRunnable(int first) : first_(first) {}
+
+  void run() override
+  {
+    for (int i = 0; i < jobs.size(); i++) {
+      const StressJob& job = jobs.at((first_ + i) % jobs.size());
+      ConversionResult result = gpsbabel::convert(job.request);
+      if (!result.ok) {
+        fprintf(stderr, "%s: %s", qPrintable(job.label), qPrintable(result.error));
+        failures.ref();
+      } else if (result.output_data != job.expected) {
+        fprintf(stderr, "%s: output differs from the sequential run.\n", qPrintable(job.label));
+        failures.ref();
+      }
+    }
+  }
+
+private:
+  int first_;
+};
+
+int
+main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s reference_dir [threads [rounds]]\n", argv[0]);
+    return 1;
+  }
+  QString dir = QString::fromLocal8Bit(argv[1]);
+  int threads = (argc > 2) ? atoi(argv[2]) : 8;
+  int rounds = (argc > 3) ? atoi(argv[3]) : 25;
+
+  add_job(dir, "bounds-test.gpx", {"gpx", {}}, {}, {"kml", {}}, false);
+  add_job(dir, "track/nmea+ms.txt", {"nmea", {}},
+          {{"position", {{"distance", "5m"}}}}, {"gpx", {}}, true);
+  add_job(dir, "IMG_2065_retag.csv", {"unicsv", {}}, {}, {"gpx", {}}, false);
+  add_job(dir, "bounds-test.gpx", {"gpx", {}},
+          {{"sort", {{"shortname", ""}}}}, {"csv", {}}, false);
+  add_job(dir, "track/Placemark-Track-1.kml", {"kml", {}}, {}, {"unicsv", {}}, true);
+  /* The same formats with different options, so option lookups run side by side. */
+  add_job(dir, "bounds-test.gpx", {"gpx", {}}, {},
+          {"kml", {{"units", "m"}, {"prec", "3"}}}, false);
+  add_job(dir, "bounds-test.gpx", {"gpx", {}}, {},
+          {"gpx", {{"gpxver", "1.0"}, {"suppresswhite", ""}}}, false);
+  add_job(dir, "IMG_2065_retag.csv", {"unicsv", {{"datum", "WGS 84"}}}, {},
+          {"unicsv", {{"prec", "3"}, {"format", ""}}}, false);
+  add_job(dir, "IMG_2065_retag.csv", {"unicsv", {}}, {},
+          {"unicsv", {{"prec", "9"}}}, false);
+
+  for (auto& job : jobs) {
+    ConversionResult result = gpsbabel::convert(job.request);
+    if (!result.ok) {
+      fprintf(stderr, "%s: %s", qPrintable(job.label), qPrintable(result.error));
+      return 1;
+    }
+    job.expected = result.output_data;
+  }
+
+  QThreadPool pool;
+  pool.setMaxThreadCount(threads);
+  for (int r = 0; r < rounds; r++) {
+    for (int t = 0; t < threads; t++) {
+      pool.start(new StressRunnable(r + t));
+    }
+  }
+  pool.waitForDone();
+
+  if (failures.load() != 0) {
+    fprintf(stderr, "%d concurrent conversions failed.\n", failures.load());
+    return 1;
+  }
+  return 0;
+}
@@ -198,9 +198,9 @@ lmx_print(const Waypoint* wpt)
   /*
    * Desparation time, try very hard to get a good shortname
    */
-  QString odesc = wpt->notes;
+  QString odesc = wpt->GetNotes();
   if (odesc.isEmpty()) {
-    odesc = wpt->description;
+    odesc = wpt->GetDescription();
   }
   if (odesc.isEmpty()) {
     odesc = wpt->shortname;
@@ -215,8 +215,8 @@ lmx_print(const Waypoint* wpt)
   if (!oname.isEmpty()) {
     lmx_write_xml(0x48, oname, 3); // name
   }
-  if (!wpt->description.isEmpty()) {
-    lmx_write_xml(0x49, wpt->description, 3); // description
+  if (!wpt->GetDescription().isEmpty()) {
+    lmx_write_xml(0x49, wpt->GetDescription(), 3); // description
   }
   lmx_start_tag(0x4A, 3); // coordinates
   if (!binary) {
@@ -370,7 +370,7 @@ lmx_lm_name(xg_string args, const QXmlStreamAttributes*)
 static void
 lmx_lm_desc(xg_string args, const QXmlStreamAttributes*)
 {
-  wpt_tmp->description = args;
+  wpt_tmp->SetDescription(args);
 }
 
 static void
@@ -333,9 +333,9 @@ static int            waypt_table_ct;
 
 /* from waypt.c, we need to iterate over waypoints when extracting routes */
 #if NEWQ
-extern QList<Waypoint*> waypt_list;
+extern thread_local QList<Waypoint*> waypt_list;
 #else
-extern queue          waypt_head;
+extern thread_local queue          waypt_head;
 #endif
 
 static unsigned short waypt_out_count;
@@ -458,7 +458,7 @@ register_waypt(const Waypoint* ref)
 
   if (global_opts.debug_level >= 2) {
     printf(MYNAME " adding waypt %s (%s) to table at index %d\n",
-           qPrintable(wpt->shortname), qPrintable(wpt->description), waypt_table_ct);
+           qPrintable(wpt->shortname), qPrintable(wpt->GetDescription()), waypt_table_ct);
   }
 
   waypt_table[waypt_table_ct] = wpt;
@@ -898,7 +898,7 @@ lowranceusr_parse_waypt(Waypoint* wpt_tmp, int object_num_present)
   /* Description; input is 1 byte per char */
   QString description = lowranceusr4_readstr(file_in, 1);
   if (!description.isEmpty()) {
-    wpt_tmp->description = description;
+    wpt_tmp->SetDescription(description);
   }
 
   /* Input is the number of seconds since Jan. 1, 2000 */
@@ -926,7 +926,7 @@ lowranceusr_parse_waypt(Waypoint* wpt_tmp, int object_num_present)
   if (global_opts.debug_level == 99) {
     printf(" %08x (%d)", icon_number, icon_number);
   }
-  wpt_tmp->icon_descr = lowranceusr_find_desc_from_icon_number(icon_number);
+  wpt_tmp->SetIconDescr(lowranceusr_find_desc_from_icon_number(icon_number));
 
   /* Waypoint Type (USER, TEMPORARY, POINT_OF_INTEREST) */
   short waypt_type = gbfgetint16(file_in);
@@ -1005,7 +1005,7 @@ lowranceusr4_parse_waypt(Waypoint* wpt_tmp)
 
   /* Icon ID */
   fsdata->icon_num = gbfgetint16(file_in);
-  wpt_tmp->icon_descr = lowranceusr4_find_desc_from_icon_number(fsdata->icon_num);
+  wpt_tmp->SetIconDescr(lowranceusr4_find_desc_from_icon_number(fsdata->icon_num));
 
   /* Color ID */
   fsdata->color = gbfgetint16(file_in);
@@ -1014,7 +1014,7 @@ lowranceusr4_parse_waypt(Waypoint* wpt_tmp)
   /* Waypoint descr; input is 2 bytes per char, we convert to 1 */
   QString desc = lowranceusr4_readstr(file_in, 2);
   if (!desc.isEmpty()) {
-    wpt_tmp->description = desc;
+    wpt_tmp->SetDescription(desc);
   }
 
   /* Alarm radius; XXX: I'm not sure what the units are here,
@@ -1368,11 +1368,11 @@ lowranceusr_parse_icons()
       wpt_tmp->shortname = name;
 
       /* symbol */
-      wpt_tmp->icon_descr = lowranceusr_find_desc_from_icon_number(icon_number);
+      wpt_tmp->SetIconDescr(lowranceusr_find_desc_from_icon_number(icon_number));
 
       if (global_opts.debug_level > 1) {
         printf(MYNAME " parse_icons: '%s' %d %16.16s %+15.10f %+15.10f\n",
-               qPrintable(wpt_tmp->shortname), icon_number, qPrintable(wpt_tmp->icon_descr), wpt_tmp->latitude, wpt_tmp->longitude);
+               qPrintable(wpt_tmp->shortname), icon_number, qPrintable(wpt_tmp->GetIconDescr()), wpt_tmp->latitude, wpt_tmp->longitude);
       }
       waypt_add(wpt_tmp);
     }
@@ -1728,12 +1728,12 @@ lowranceusr_waypt_disp(const Waypoint* wpt)
 // ...
   QString name;
   if ((wpt->shortname.isEmpty()) || global_opts.synthesize_shortnames) {
-    if (!wpt->description.isEmpty() && global_opts.synthesize_shortnames) {
+    if (!wpt->GetDescription().isEmpty() && global_opts.synthesize_shortnames) {
       name = mkshort_from_wpt(mkshort_handle, wpt);
     } else if (!wpt->shortname.isEmpty()) {
       name = wpt->shortname;
-    } else if (!wpt->description.isEmpty()) {
-      name = wpt->description;
+    } else if (!wpt->GetDescription().isEmpty()) {
+      name = wpt->GetDescription();
     }
   } else {
     name = wpt->shortname;
@@ -1760,8 +1760,8 @@ lowranceusr_waypt_disp(const Waypoint* wpt)
   /**
    * Comments are now used by the iFinder (Expedition C supports them)
    */
-  if (wpt->description != wpt->shortname) {
-    QString comment = wpt->description;
+  if (wpt->GetDescription() != wpt->shortname) {
+    QString comment = wpt->GetDescription();
     text_len = comment.length();
     if (text_len > MAXUSRSTRINGSIZE) {
       text_len = MAXUSRSTRINGSIZE;
@@ -1791,10 +1791,10 @@ lowranceusr_waypt_disp(const Waypoint* wpt)
 
   gbfputint32(Time, file_out);
 
-  if (get_cache_icon(wpt) && wpt->icon_descr.compare(QLatin1String("Geocache Found")) == 0) {
+  if (get_cache_icon(wpt) && wpt->GetIconDescr().compare(QLatin1String("Geocache Found")) == 0) {
     SymbolId = lowranceusr_find_icon_number_from_desc(get_cache_icon(wpt));
   } else {
-    SymbolId = lowranceusr_find_icon_number_from_desc(wpt->icon_descr);
+    SymbolId = lowranceusr_find_icon_number_from_desc(wpt->GetIconDescr());
   }
   /* If the waypoint is archived or disabled, use a "disabled" icon instead. */
   if ((wpt->gc_data->is_archived==status_true) || (wpt->gc_data->is_available==status_false)) {
@@ -1850,17 +1850,17 @@ lowranceusr4_waypt_disp(const Waypoint* wpt)
   gbfputint32(2, file_out);
 
   int SymbolId, ColorId;
-  if (get_cache_icon(wpt) && wpt->icon_descr.compare(QLatin1String("Geocache Found")) == 0) {
+  if (get_cache_icon(wpt) && wpt->GetIconDescr().compare(QLatin1String("Geocache Found")) == 0) {
     if(writing_version == 4) {
-      SymbolId = lowranceusr4_find_icon_number_from_desc(wpt->icon_descr);
+      SymbolId = lowranceusr4_find_icon_number_from_desc(wpt->GetIconDescr());
     } else {
       SymbolId = lowranceusr_find_icon_number_from_desc(get_cache_icon(wpt));
     }
     ColorId = 0; // default
   } else {
-    SymbolId = lowranceusr4_find_icon_number_from_desc(wpt->icon_descr);
+    SymbolId = lowranceusr4_find_icon_number_from_desc(wpt->GetIconDescr());
     if (wpt->fs != nullptr) {
-      ColorId = lowranceusr4_find_index_from_icon_desc_and_color_desc(wpt->icon_descr, ((lowranceusr4_fsdata*)(wpt->fs))->color_desc);
+      ColorId = lowranceusr4_find_index_from_icon_desc_and_color_desc(wpt->GetIconDescr(), ((lowranceusr4_fsdata*)(wpt->fs))->color_desc);
     } else {
       ColorId = DEF_USR4_COLOR; // default
     }
@@ -1874,7 +1874,7 @@ lowranceusr4_waypt_disp(const Waypoint* wpt)
   gbfputint16(ColorId, file_out);
 
   /* Waypt description */
-  lowranceusr4_writestr(wpt->description, file_out, 2);
+  lowranceusr4_writestr(wpt->GetDescription(), file_out, 2);
 
   /* Alarm radius */
   gbfputflt(WAYPT_GET(wpt, proximity, 0.0), file_out);
@@ -1937,7 +1937,7 @@ lowranceusr4_write_waypoints()
   for (int i = 0; i < waypt_table_ct; ++i) {
     if (global_opts.debug_level >= 2) {
       printf(MYNAME " writing out waypt %d (%s - %s)\n",
-             i, qPrintable(waypt_table[i]->shortname), qPrintable(waypt_table[i]->description));
+             i, qPrintable(waypt_table[i]->shortname), qPrintable(waypt_table[i]->GetDescription()));
     }
     lowranceusr4_waypt_disp((static_cast<const Waypoint*>(waypt_table[i])));
   }
@@ -1957,8 +1957,8 @@ lowranceusr_write_icon(const Waypoint* wpt)
 {
   int latmm = lat_deg_to_mm(wpt->latitude);
   int lonmm = lon_deg_to_mm(wpt->longitude);
-  int icon = !wpt->icon_descr.isNull() ?
-             lowranceusr_find_icon_number_from_desc(wpt->icon_descr) :
+  int icon = !wpt->GetIconDescr().isNull() ?
+             lowranceusr_find_icon_number_from_desc(wpt->GetIconDescr()) :
              X_1_ICON;
 
   gbfputint32(latmm, file_out);
@@ -137,7 +137,7 @@ maggeo_read()
         wpt_tmp->shortname = s;
         break;
       case 9:
-        wpt_tmp->description = s;
+        wpt_tmp->SetDescription(s);
         break;
       case 10:
         gcdata->placer = s;
@@ -153,7 +153,7 @@ maggeo_read()
         }
         break;
       case 13:
-        wpt_tmp->creation_time = maggeo_parsedate(s);
+        wpt_tmp->SetCreationTime(maggeo_parsedate(s));
         break;
       case 14: // last found date was ignored.  Implemented 2013-02-27.
         gcdata->last_found = maggeo_parsedate(s);
@@ -261,10 +261,10 @@ maggeo_waypt_pr(const Waypoint* waypointp)
   } else {
     ctype = gs_get_cachetype(waypointp->gc_data->type);
   }
-  QString placeddate = maggeo_fmtdate(waypointp->creation_time);
+  QString placeddate = maggeo_fmtdate(waypointp->GetCreationTime());
   QString lfounddate = maggeo_fmtdate(waypointp->gc_data->last_found);
   QString cname = mkshort(desc_handle,
-                  waypointp->notes.isEmpty() ? waypointp->description : waypointp->notes);
+                  waypointp->GetNotes().isEmpty() ? waypointp->GetDescription() : waypointp->GetNotes());
   QString placer = waypointp->gc_data->placer;
 
   /*
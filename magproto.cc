@@ -1231,8 +1231,8 @@ mag_wptparse(char* trkmsg)
 
   waypt->altitude = alt;
   waypt->shortname = shortname;
-  waypt->description = descr;
-  waypt->icon_descr = mag_find_descr_from_token(icon_token);
+  waypt->SetDescription(descr);
+  waypt->SetIconDescr(mag_find_descr_from_token(icon_token));
 
   return waypt;
 }
@@ -1347,14 +1347,14 @@ mag_waypt_pr(const Waypoint* waypointp)
   if (deficon)  {
     icon_token = mag_find_token_from_descr(deficon);
   } else {
-    icon_token = mag_find_token_from_descr(waypointp->icon_descr);
+    icon_token = mag_find_token_from_descr(waypointp->GetIconDescr());
   }
 
   if (get_cache_icon(waypointp)) {
     icon_token = mag_find_token_from_descr(get_cache_icon(waypointp));
   }
 
-  QString isrc = waypointp->notes.isEmpty() ? waypointp->description : waypointp->notes;
+  QString isrc = waypointp->GetNotes().isEmpty() ? waypointp->GetDescription() : waypointp->GetNotes();
   QString owpt = global_opts.synthesize_shortnames ?
          mkshort_from_wpt(mkshort_handle, waypointp) : waypointp->shortname;
   QString odesc = isrc;
@@ -1495,7 +1495,7 @@ mag_route_trl(const route_head* rte)
     if (deficon) {
       icon_token = mag_find_token_from_descr(deficon);
     } else {
-      icon_token = mag_find_token_from_descr(waypointp->icon_descr);
+      icon_token = mag_find_token_from_descr(waypointp->GetIconDescr());
     }
 
     if (i == 1) {
@@ -20,9 +20,10 @@
 #include <clocale>                  // for setlocale, LC_NUMERIC, LC_TIME
 #include <csignal>                  // for signal, SIGINT, SIG_ERR
 #include <cstdio>                   // for printf, fgetc, stdin
-#include <cstdlib>                  // for exit
+#include <cstdlib>                  // for exit, malloc, free
 #include <cstring>                  // for strcmp
 #include <ctime>                    // for time
+#include <new>                      // for bad_alloc
 
 #include <QtCore/QByteArray>        // for QByteArray
 #include <QtCore/QChar>             // for QChar
@@ -44,18 +45,43 @@
 #endif
 
 #include "defs.h"
-#include "cet_util.h"               // for cet_convert_init, cet_convert_strings, cet_convert_deinit, cet_deregister, cet_register, cet_cs_vec_utf8
+#include "cet_util.h"               // for cet_convert_init, cet_convert_strings, cet_convert_deinit, cet_cs_vec_utf8
 #include "csv_util.h"               // for csv_lineparse
 #include "filter.h"                 // for Filter
 #include "filterdefs.h"             // for disp_filter_vec, disp_filter_vecs, disp_filters, exit_filter_vecs, find_filter_vec, free_filter_vec, init_filter_vecs
 #include "inifile.h"                // for inifile_done, inifile_init
+#include "progress.h"               // for progress_stage, progress_step, progress_done, progress_allocations, progress_count_allocations
 #include "queue.h"                  // for queue
+#include "server.h"                 // for server_run, server_client
 #include "session.h"                // for start_session, session_exit, session_init
 #include "src/core/datetime.h"      // for DateTime
 #include "src/core/file.h"          // for File
 #include "src/core/usasciicodec.h"  // for UsAsciiCodec
 
 #define MYNAME "main"
+
+/*
+ * Count allocations for --profile.  Only the program replaces these,
+ * libgpsbabel leaves operator new to the program using it.
+ */
+void*
+operator new(std::size_t size)
+{
+  if (progress_count_allocations) {
+    progress_allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  void* p = malloc((size != 0) ? size : 1);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  free(p);
+}
 // be careful not to advance argn passed the end of the list, i.e. ensure argn < qargs.size()
 #define FETCH_OPTARG qargs.at(argn).size() > 2 ? QString(qargs.at(argn)).remove(0,2) : qargs.size()>(argn+1) ? qargs.at(++argn) : QString()
 
@@ -157,6 +183,11 @@ usage(const char* pname, int shorter)
     "    -D level         Set debug level [%d]\n"
     "    -h, -?           Print detailed help and exit\n"
     "    -V               Print GPSBabel version and exit\n"
+    "    --server[=sock]  Serve conversion requests (JSON lines) on stdin\n"
+    "                     or on the Unix domain socket sock\n"
+    "    --client=sock    Run the rest of the command line on a server\n"
+    "    --profile[=json] Print the time and memory each stage used to\n"
+    "                     stderr; must come first\n"
     "\n"
     , pname
     , pname
@@ -214,7 +245,7 @@ signal_handler(int sig)
 }
 
 static int
-run(const char* prog_name)
+run(const char* prog_name, QStringList qargs)
 {
   int c;
   int argn;
@@ -232,9 +263,6 @@ run(const char* prog_name)
   signed int wpt_ct_bak, rte_ct_bak, trk_ct_bak;	/* #ifdef UTF8_SUPPORT */
   QStack<QargStackElement> qargs_stack;
 
-  // Use QCoreApplication::arguments() to process the command line.
-  QStringList qargs = QCoreApplication::arguments();
-
   if (qargs.size() < 2) {
     usage(prog_name,1);
     return 0;
@@ -320,11 +348,14 @@ run(const char* prog_name)
 
       cet_convert_init(ivecs->encode, ivecs->fixed_encode);	/* init by module vec */
 
+      progress_stage("read", fname);
       start_session(ivecs->name, fname);
       ivecs->rd_init(fname);
       ivecs->read();
       ivecs->rd_deinit();
+      track_recompute_invalidate();
 
+      progress_step("charset");
       cet_convert_strings(global_opts.charset, nullptr, nullptr);
       cet_convert_deinit();
 
@@ -352,6 +383,7 @@ run(const char* prog_name)
         trk_ct_bak = -1;
         rte_head_bak = trk_head_bak = nullptr;
 
+        progress_stage("write", ofname);
         ovecs->wr_init(ofname);
 
         if (global_opts.charset != &cet_cs_vec_utf8) {
@@ -363,12 +395,15 @@ run(const char* prog_name)
            */
           int saved_status = global_opts.verbose_status;
           global_opts.verbose_status = 0;
+          progress_step("backup");
           waypt_backup(&wpt_ct_bak, &wpt_head_bak);
           route_backup(&rte_ct_bak, &rte_head_bak);
           track_backup(&trk_ct_bak, &trk_head_bak);
 
+          progress_step("charset");
           cet_convert_strings(nullptr, global_opts.charset, nullptr);
           global_opts.verbose_status = saved_status;
+          progress_step("write");
         }
 
         ovecs->write();
@@ -376,6 +411,7 @@ run(const char* prog_name)
 
         cet_convert_deinit();
 
+        progress_step("restore");
         if (wpt_ct_bak != -1) {
           waypt_restore(wpt_ct_bak, wpt_head_bak);
         }
@@ -427,9 +463,11 @@ run(const char* prog_name)
       filter = find_filter_vec(CSTR(optarg), &fvec_opts);
 
       if (filter) {
+        progress_stage("filter", optarg);
         filter->init();
         filter->process();
         filter->deinit();
+        track_recompute_invalidate();
         free_filter_vec(filter);
       }  else {
         fatal("Unknown filter '%s'\n",qPrintable(optarg));
@@ -464,7 +502,7 @@ run(const char* prog_name)
 
       break;
     /*
-     * Undocumented '-vs' option for GUI wrappers.
+     * Undocumented '-vs' and '-vp' options for GUI wrappers.
      */
     case 'v':
       switch (qargs.at(argn).size() > 2 ? qargs.at(argn).at(2).toLatin1() : '\0') {
@@ -474,6 +512,9 @@ run(const char* prog_name)
       case 'S':
         global_opts.verbose_status = 2;
         break;
+      case 'p':
+        global_opts.progress = 1;
+        break;
       }
       break;
 
@@ -544,6 +585,7 @@ run(const char* prog_name)
 
     cet_convert_init(ivecs->encode, 1);
 
+    progress_stage("read", qargs.at(0));
     start_session(ivecs->name, qargs.at(0));
     if (ivecs->rd_init == nullptr) {
       fatal("Format does not support reading.\n");
@@ -551,11 +593,15 @@ run(const char* prog_name)
     ivecs->rd_init(qargs.at(0));
     ivecs->read();
     ivecs->rd_deinit();
+    track_recompute_invalidate();
 
+    progress_step("charset");
     cet_convert_strings(global_opts.charset, nullptr, nullptr);
     cet_convert_deinit();
 
     if (qargs.size() == 2 && ovecs) {
+      progress_stage("write", qargs.at(1));
+      progress_step("charset");
       cet_convert_init(ovecs->encode, 1);
       cet_convert_strings(nullptr, global_opts.charset, nullptr);
 
@@ -563,6 +609,7 @@ run(const char* prog_name)
         fatal("Format does not support writing.\n");
       }
 
+      progress_step("write");
       ovecs->wr_init(qargs.at(1));
       ovecs->write();
       ovecs->wr_deinit();
@@ -664,9 +711,17 @@ run(const char* prog_name)
     fatal("Nothing to do!  Use '%s -h' for command-line options.\n", prog_name);
   }
 
+  progress_done();
   return 0;
 }
 
+/* A conversion requested by a client of the --server mode. */
+static int
+run_job(const QStringList& args)
+{
+  return run(qPrintable(args.at(0)), args);
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -727,6 +782,26 @@ main(int argc, char* argv[])
 
   (void) new gpsbabel::UsAsciiCodec(); /* make sure a US-ASCII codec is available */
 
+  // Use QCoreApplication::arguments() to process the command line.
+  QStringList qargs = QCoreApplication::arguments();
+
+  /* The client doesn't convert anything itself, so skip the setup. */
+  if ((qargs.size() > 1) && qargs.at(1).startsWith("--client=")) {
+    exit(server_client(qargs.at(1).mid(9), qargs.mid(2)));
+  }
+
+  if ((qargs.size() > 1) && qargs.at(1).startsWith("--profile")) {
+    if ((qargs.at(1) == "--profile") || (qargs.at(1) == "--profile=text")) {
+      global_opts.profile = 1;
+    } else if (qargs.at(1) == "--profile=json") {
+      global_opts.profile = 2;
+    } else {
+      fatal("Unknown option '%s'.\n", qPrintable(qargs.at(1)));
+    }
+    progress_count_allocations = true;
+    qargs.removeAt(1);
+  }
+
   global_opts.objective = wptdata;
   global_opts.masked_objective = NOTHINGMASK;	/* this makes the default mask behaviour slightly different */
   global_opts.charset_name.clear();
@@ -739,16 +814,21 @@ main(int argc, char* argv[])
     global_opts.inifile = inifile_init(QString(), MYNAME);
   }
 
-  init_vecs();
   init_filter_vecs();
-  cet_register();
   session_init();
   waypt_init();
   route_init();
 
-  rc = run(prog_name);
+  if ((qargs.size() > 1) &&
+      ((qargs.at(1) == "--server") || qargs.at(1).startsWith("--server="))) {
+    if (qargs.size() > 2) {
+      fatal("Extra arguments on command line\n");
+    }
+    rc = server_run(qargs.at(0), qargs.at(1).mid(9), run_job);
+  } else {
+    rc = run(prog_name, qargs);
+  }
 
-  cet_deregister();
   waypt_flush_all();
   route_flush_all();
   session_exit();
@@ -117,7 +117,7 @@ mapsend_wpt_read()
     wpt_tmp = new Waypoint;
 
     wpt_tmp->shortname = gbfgetpstr(mapsend_file_in);
-    wpt_tmp->description = gbfgetpstr(mapsend_file_in);
+    wpt_tmp->SetDescription(gbfgetpstr(mapsend_file_in));
 
     int wpt_number = gbfgetint32(mapsend_file_in);
     (void) wpt_number; // hush warning.
@@ -134,7 +134,7 @@ mapsend_wpt_read()
     } else {
       sprintf(tbuf, "a%c", wpt_icon - 26 + 'a');
     }
-    wpt_tmp->icon_descr = mag_find_descr_from_token(tbuf);
+    wpt_tmp->SetIconDescr(mag_find_descr_from_token(tbuf));
 
     waypt_add(wpt_tmp);
   }
@@ -175,7 +175,7 @@ mapsend_wpt_read()
       } else {
         sprintf(tbuf, "a%c", wpt_icon - 26 + 'a');
       }
-      wpt_tmp->icon_descr = mag_find_descr_from_token(tbuf);
+      wpt_tmp->SetIconDescr(mag_find_descr_from_token(tbuf));
 
       route_add_wpt(rte_head, wpt_tmp);
     }
@@ -288,20 +288,20 @@ mapsend_waypt_pr(const Waypoint* waypointp)
 
   // This is funny looking to ensure that no more than 30 bytes
   // get written to the file.
-  unsigned int c = waypointp->description.length();
+  unsigned int c = waypointp->GetDescription().length();
   if (c > 30) {
     c = 30;
   }
   gbfputc(c, mapsend_file_out);
-  gbfwrite(CSTR(waypointp->description), 1, c, mapsend_file_out);
+  gbfwrite(CSTR(waypointp->GetDescription()), 1, c, mapsend_file_out);
 
   /* #, icon, status */
   gbfputint32(++cnt, mapsend_file_out);
 
 
   QString iconp;
-  if (!waypointp->icon_descr.isNull()) {
-    iconp = mag_find_token_from_descr(waypointp->icon_descr);
+  if (!waypointp->GetIconDescr().isNull()) {
+    iconp = mag_find_token_from_descr(waypointp->GetIconDescr());
     if (1 == iconp.size()) {
       c = iconp[0].toLatin1() - 'a';
     } else {
@@ -375,8 +375,8 @@ mapsend_route_disp(const Waypoint* waypointp)
   gbfputdbl(waypointp->longitude, mapsend_file_out);
   gbfputdbl(-waypointp->latitude, mapsend_file_out);
 
-  if (!waypointp->icon_descr.isNull()) {
-    QString iconp = mag_find_token_from_descr(waypointp->icon_descr);
+  if (!waypointp->GetIconDescr().isNull()) {
+    QString iconp = mag_find_token_from_descr(waypointp->GetIconDescr());
     if (1 == iconp.size()) {
       c = iconp[0].toLatin1() - 'a';
     } else {
@@ -25,6 +25,7 @@
 #include "garmin_tables.h"
 #include "jeeps/gpsmath.h"
 #include <QtCore/QFile>
+#include <QtCore/QHash>
 #include <cstdio>
 #include <cstdlib>
 
@@ -51,6 +52,9 @@ static short_handle written_wpt_mkshort_handle;
 static queue read_route_wpt_head;
 static short_handle read_route_wpt_mkshort_handle;
 
+/* Shortname -> first waypoint of that name in each of the private queues */
+static QHash<const queue*, QHash<QString, Waypoint*>> mps_wpt_q_index;
+
 #define MPSDEFAULTWPTCLASS		0
 #define MPSHIDDENROUTEWPTCLASS	8
 
@@ -123,6 +127,7 @@ mps_wpt_q_deinit(queue* whichQueue)
 {
   queue* elem, *tmp;
 
+  mps_wpt_q_index.remove(whichQueue);
   QUEUE_FOR_EACH(whichQueue, elem, tmp) {
     Waypoint* q = reinterpret_cast<Waypoint *>(dequeue(elem));
     delete q;
@@ -136,15 +141,7 @@ mps_wpt_q_deinit(queue* whichQueue)
 static Waypoint*
 mps_find_wpt_q_by_name(const queue* whichQueue, const QString& name)
 {
-  queue* elem, *tmp;
-
-  QUEUE_FOR_EACH(whichQueue, elem, tmp) {
-    Waypoint* waypointp = reinterpret_cast<Waypoint*>(elem);
-    if (waypointp->shortname == name) {
-      return waypointp;
-    }
-  }
-  return nullptr;
+  return mps_wpt_q_index.value(whichQueue).value(name, nullptr);
 }
 
 /*
@@ -156,6 +153,11 @@ mps_wpt_q_add(const queue* whichQueue, const Waypoint* wpt)
 {
   Waypoint* written_wpt = new Waypoint(*wpt);
   ENQUEUE_TAIL(whichQueue, &written_wpt->Q);
+
+  QHash<QString, Waypoint*>& index = mps_wpt_q_index[whichQueue];
+  if (!index.contains(written_wpt->shortname)) {
+    index.insert(written_wpt->shortname, written_wpt);
+  }
 }
 
 static int
@@ -564,13 +566,13 @@ mps_waypoint_r(gbfile* mps_file, int mps_ver, Waypoint** wpt, unsigned int* mpsc
 
   if ((mps_ver == 4) || (mps_ver == 5)) {
     gbfread(tbuf, 6, 1, mps_file);				/* unknown */
-    thisWaypoint->notes = gbfgetcstr(mps_file);
+    thisWaypoint->SetNotes(gbfgetcstr(mps_file));
   } else {
     gbfread(tbuf, 2, 1, mps_file);				/* unknown */
   }
 
   thisWaypoint->shortname = wptname;
-  thisWaypoint->description = wptdesc;
+  thisWaypoint->SetDescription(wptdesc);
   thisWaypoint->latitude = GPS_Math_Semi_To_Deg(lat);
   thisWaypoint->longitude = GPS_Math_Semi_To_Deg(lon);
   thisWaypoint->altitude = mps_altitude;
@@ -582,7 +584,7 @@ mps_waypoint_r(gbfile* mps_file, int mps_ver, Waypoint** wpt, unsigned int* mpsc
   }
 
   /* might need to change this to handle version dependent icon handling */
-  thisWaypoint->icon_descr = gt_find_desc_from_icon_number(icon, MAPSOURCE);
+  thisWaypoint->SetIconDescr(gt_find_desc_from_icon_number(icon, MAPSOURCE));
 }
 
 /*
@@ -607,11 +609,11 @@ mps_waypoint_w(gbfile* mps_file, int mps_ver, const Waypoint* wpt, const bool is
     mps_depth = wpt->depth;
   }
   QString src;
-  if (!wpt->description.isEmpty()) {
-    src = wpt->description;
+  if (!wpt->GetDescription().isEmpty()) {
+    src = wpt->GetDescription();
   }
-  if (!wpt->notes.isEmpty()) {
-    src = wpt->notes;
+  if (!wpt->GetNotes().isEmpty()) {
+    src = wpt->GetNotes();
   }
   QString ident = global_opts.synthesize_shortnames ?
           mkshort(mkshort_handle, src) :
@@ -621,7 +623,7 @@ mps_waypoint_w(gbfile* mps_file, int mps_ver, const Waypoint* wpt, const bool is
   memset(ffbuf, 0xff, sizeof(ffbuf));
 
   /* might need to change this to handle version dependent icon handling */
-  int icon = gt_find_icon_number_from_desc(wpt->icon_descr, MAPSOURCE);
+  int icon = gt_find_icon_number_from_desc(wpt->GetIconDescr(), MAPSOURCE);
   if (get_cache_icon(wpt)) {
     icon = gt_find_icon_number_from_desc(get_cache_icon(wpt), MAPSOURCE);
   }
@@ -629,7 +631,7 @@ mps_waypoint_w(gbfile* mps_file, int mps_ver, const Waypoint* wpt, const bool is
   icon = mps_converted_icon_number(icon, mps_ver, MAPSOURCE);
 
   /* two NULL (0x0) bytes at end of each string */
-  char* ascii_description = xstrdup(wpt->description);
+  char* ascii_description = xstrdup(wpt->GetDescription());
   int reclen = ident.length() + strlen(ascii_description) + 2;
   if ((mps_ver == 4) || (mps_ver == 5)) {
     /* v4.06 & V5.0*/
@@ -638,8 +640,8 @@ mps_waypoint_w(gbfile* mps_file, int mps_ver, const Waypoint* wpt, const bool is
 										+ NULL (1) + prox(9) + display(4) + colour(4) + symbol(4) + city(sz) +
 										state(sz) + facility(sz) + unknown2(1) + depth(9) + unknown3(7) */
     /* -1 as reclen is interpreted from zero meaning a reclength of one */
-    if (!wpt->notes.isEmpty()) {
-      reclen += strlen(CSTRc(wpt->notes));
+    if (!wpt->GetNotes().isEmpty()) {
+      reclen += strlen(CSTRc(wpt->GetNotes()));
     }
   } else {
     /* v3.02 */
@@ -686,7 +688,7 @@ mps_waypoint_w(gbfile* mps_file, int mps_ver, const Waypoint* wpt, const bool is
     gbfputc(1, mps_file);
     gbfputdbl(mps_altitude, mps_file);
   }
-  if (!wpt->description.isEmpty()) {
+  if (!wpt->GetDescription().isEmpty()) {
     gbfputs(ascii_description, mps_file);
   }
   gbfwrite(zbuf, 1, 1, mps_file);	/* NULL termination */
@@ -718,8 +720,8 @@ mps_waypoint_w(gbfile* mps_file, int mps_ver, const Waypoint* wpt, const bool is
   gbfwrite(zbuf, 2, 1, mps_file);		/* unknown */
   if ((mps_ver == 4) || (mps_ver == 5)) {
     gbfwrite(zbuf, 4, 1, mps_file);	/* unknown */
-    if (!wpt->notes.isEmpty()) {
-      gbfputs(wpt->notes, mps_file);
+    if (!wpt->GetNotes().isEmpty()) {
+      gbfputs(wpt->GetNotes(), mps_file);
     }
     gbfwrite(zbuf, 1, 1, mps_file);	/* string termination */
   }
@@ -1136,11 +1138,11 @@ mps_routehdr_w(gbfile* mps_file, int mps_ver, const route_head* rte)
       }
 
       QString src;
-      if (!testwpt->description.isEmpty()) {
-        src = testwpt->description;
+      if (!testwpt->GetDescription().isEmpty()) {
+        src = testwpt->GetDescription();
       }
-      if (!testwpt->notes.isEmpty()) {
-        src = testwpt->notes;
+      if (!testwpt->GetNotes().isEmpty()) {
+        src = testwpt->GetNotes();
       }
       QString ident = global_opts.synthesize_shortnames ?
               mkshort(mkshort_handle, src) :
@@ -1348,11 +1350,11 @@ mps_routedatapoint_w(gbfile* mps_file, int mps_ver, const Waypoint* rtewpt)
   }
 
   QString src;
-  if (!rtewpt->description.isEmpty()) {
-    src = rtewpt->description;
+  if (!rtewpt->GetDescription().isEmpty()) {
+    src = rtewpt->GetDescription();
   }
-  if (!rtewpt->notes.isEmpty()) {
-    src = rtewpt->notes;
+  if (!rtewpt->GetNotes().isEmpty()) {
+    src = rtewpt->GetNotes();
   }
   QString ident = global_opts.synthesize_shortnames ?
           mkshort(mkshort_handle, src) :
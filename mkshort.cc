@@ -23,6 +23,8 @@
 #include "cet.h"
 #include "cet_util.h"
 
+#include <QtCore/QHash>
+
 #include <cctype>
 #include <cstdio>
 #include <cstdlib>
@@ -37,18 +39,15 @@ static const char vowels[] = "aeiouAEIOU";
 static const char* DEFAULT_BADCHARS = "\"$.,'!-";
 
 /*
- * Hash table tunings.   The reality is that our hash doesn't have to be
- * terribly complex; our strings are short (typically 8-20 bytes) and the
- * string hash mixes things up enough that strcmp can generally bail on the
- * first byte or two for a mismatch.
+ * The names a handle has already handed out.  Names are compared without
+ * regard to case, so they are keyed by their case folded form.  The value
+ * is the number of times the name has been asked for again, which seeds
+ * the ".N" suffix of the next conflicting name.  QHash grows as needed, so
+ * lookups stay cheap no matter how many names a handle has seen.
  */
-#define PRIME 37
-
-typedef struct {
-  queue list;
-  char* orig_shortname;
-  int conflictctr;
-} uniq_shortname;
+struct mkshort_namelist {
+  QHash<QString, int> names;
+};
 
 static struct replacements {
   const char* orig;
@@ -67,28 +66,12 @@ static struct replacements {
   {nullptr, 		nullptr}
 };
 
-/*
- * We hash all strings as upper case.
- */
-unsigned int hash_string(const char* key)
-{
-  unsigned int hash = 0;
-  while (*key) {
-    hash = ((hash<<5) ^ (hash>>27)) ^ toupper(*key++);
-  }
-  hash = hash % PRIME;
-  return hash;
-}
-
 short_handle
 mkshort_new_handle()
 {
   mkshort_handle_imp* h = (mkshort_handle_imp*) xcalloc(sizeof *h, 1);
 
-  for (auto &i : h->namelist) {
-    QUEUE_INIT(&i);
-  }
-
+  h->namelist = new mkshort_namelist;
   h->whitespaceok = 1;
   h->badchars = xstrdup(DEFAULT_BADCHARS);
   h->target_len = DEFAULT_TARGET_LEN;
@@ -99,45 +82,23 @@ mkshort_new_handle()
   return h;
 }
 
-static
-uniq_shortname*
-is_unique(mkshort_handle_imp* h, char* name)
-{
-  queue* e, *t;
-
-  int hash = hash_string(name);
-  QUEUE_FOR_EACH(&h->namelist[hash], e, t) {
-    uniq_shortname* z = reinterpret_cast<uniq_shortname *>(e);
-    if (0 == case_ignore_strcmp(z->orig_shortname, name)) {
-      return z;
-    }
-  }
-  return (uniq_shortname*) nullptr;
-}
-
-static
-void
-add_to_hashlist(mkshort_handle_imp* h, char* name)
-{
-  int hash = hash_string(name);
-  uniq_shortname* s = (uniq_shortname*) xcalloc(1, sizeof(uniq_shortname));
-
-  s->orig_shortname = xstrdup(name);
-  ENQUEUE_TAIL(&h->namelist[hash], &s->list);
-}
-
 char*
 mkshort_add_to_list(mkshort_handle_imp* h, char* name)
 {
-  uniq_shortname* s;
+  QHash<QString, int>& names = h->namelist->names;
+
+  for (;;) {
+    QString key = QString::fromUtf8(name).toCaseFolded();
+    auto it = names.find(key);
+    if (it == names.end()) {
+      names.insert(key, 0);
+      return name;
+    }
 
-  while ((s = is_unique(h, name))) {
     char tbuf[10];
     size_t l = strlen(name);
 
-    s->conflictctr++;
-
-    int dl = sprintf(tbuf, ".%d", s->conflictctr);
+    int dl = sprintf(tbuf, ".%d", ++it.value());
 
     if (l + dl < h->target_len) {
       name = (char*) xrealloc(name, l + dl + 1);
@@ -146,9 +107,6 @@ mkshort_add_to_list(mkshort_handle_imp* h, char* name)
       strcpy(&name[l-dl], tbuf);
     }
   }
-
-  add_to_hashlist(h, name);
-  return name;
 }
 
 void
@@ -160,21 +118,7 @@ mkshort_del_handle(short_handle* h)
     return;
   }
 
-  for (auto &i : hdr->namelist) {
-    queue* e, *t;
-    QUEUE_FOR_EACH(&i, e, t) {
-      uniq_shortname* s = reinterpret_cast<uniq_shortname *>(e);
-#if 0
-      if (global_opts.verbose_status >= 2 && s->conflictctr) {
-        fprintf(stderr, "%d Output name conflicts: '%s'\n",
-                s->conflictctr, s->orig_shortname);
-      }
-#endif
-      dequeue(e);
-      xfree(s->orig_shortname);
-      xfree(s);
-    }
-  }
+  delete hdr->namelist;
   /* setshort_badchars(*h, NULL); ! currently setshort_badchars() always allocates something ! */
   if (hdr->badchars != nullptr) {
     xfree(hdr->badchars);
@@ -192,30 +136,37 @@ mkshort_del_handle(short_handle* h)
  * This is the stuff that makes me ashamed to be a C programmer...
  */
 
-static
-char*
-delete_last_vowel(int start, char* istring, int* replaced)
+/*
+ * Delete vowels starting from the end until the string fits in target_len
+ * or we run out of vowels.  A vowel that starts a word is kept, as are the
+ * first 'start' characters.  Deleting a vowel never makes a character
+ * after it deletable, so a single sweep from the end does the same as
+ * repeatedly deleting the last deletable vowel.  Returns the new length.
+ */
+static size_t
+delete_vowels(size_t start, char* istring, size_t len, size_t target_len)
 {
-  /*
-   * Basically impelement strrchr.
-   */
-  *replaced = 0;
-  for (int l = strlen(istring); l > start; l--) {
-    if (strchr(vowels, istring[l-1])) {
-      /* If vowel is the first letter of a word, keep it.*/
-      if (istring[l-2] == ' ') {
-        continue;
-      }
-      char* ostring = xstrdup(istring);
-      strncpy(&ostring[l-1], &istring[l], 1+strlen(istring)-l);
-      ostring[strlen(istring)-1] = 0;
-      *replaced = 1;
-      strcpy(istring, ostring);
-      xfree(ostring);
-      break;
+  size_t excess = (len > target_len) ? len - target_len : 0;
+  size_t deleted = 0;
+
+  for (size_t l = len; (deleted < excess) && (l > start); l--) {
+    if (strchr(vowels, istring[l-1]) && (istring[l-2] != ' ')) {
+      istring[l-1] = '\0';	/* squeezed out below */
+      deleted++;
     }
   }
-  return istring;
+  if (deleted == 0) {
+    return len;
+  }
+
+  char* op = istring;
+  for (size_t i = 0; i < len; i++) {
+    if (istring[i] != '\0') {
+      *op++ = istring[i];
+    }
+  }
+  *op = '\0';
+  return len - deleted;
 }
 
 /*
@@ -234,8 +185,8 @@ replace_constants(char* s)
      * space, replace it.
      */
     if ((origslen - rl > 1) &&
-        (0 == case_ignore_strcmp(r->orig, &s[origslen - rl])) &&
-        (s[origslen - rl - 1] == ' ')) {
+        (s[origslen - rl - 1] == ' ') &&
+        (0 == case_ignore_strcmp(r->orig, &s[origslen - rl]))) {
       strcpy(&s[origslen - rl], r->replacement);
       return ;
     }
@@ -369,9 +320,7 @@ char*
 mkshort(short_handle h, const char* istring)
 {
   char* ostring;
-  char* tstring;
-  char* cp;
-  int i, l, replaced;
+  char* op;
   mkshort_handle_imp* hdl = (mkshort_handle_imp*) h;
 
   if (hdl->is_utf8) {
@@ -380,6 +329,14 @@ mkshort(short_handle h, const char* istring)
     ostring = xstrdup(istring);
   }
 
+  /*
+   * Everything up to the trailing number handling can only shorten the
+   * string, so it is done in place with a read and a write pointer
+   * instead of copying the string for every step.
+   */
+  const char* ip = ostring;
+  size_t len = strlen(ostring);
+
   /*
    * A rather horrible special case hack.
    * If the target length is "6" and the source length is "7" and
@@ -387,52 +344,36 @@ mkshort(short_handle h, const char* istring)
    * the new seven digit geocache numbers and special case whacking
    * the 'G' off the front.
    */
-  if ((hdl->target_len == 6) && (strlen(ostring) == 7) &&
-      (ostring[0] == 'G') && (ostring[1] == 'C')) {
-    memmove(&ostring[0], &ostring[1], strlen(ostring));
+  if ((hdl->target_len == 6) && (len == 7) &&
+      (ip[0] == 'G') && (ip[1] == 'C')) {
+    ip++;
+    len--;
   }
 
   /*
    * Whack leading "[Tt]he",
    */
-  if ((strlen(ostring) > hdl->target_len + 4) &&
-      (strncmp(ostring, "The ", 4) == 0 ||
-       strncmp(ostring, "the ", 4) == 0)) {
-    char* nstring = xstrdup(ostring + 4);
-    xfree(ostring);
-    ostring = nstring;
+  if ((len > hdl->target_len + 4) &&
+      (strncmp(ip, "The ", 4) == 0 ||
+       strncmp(ip, "the ", 4) == 0)) {
+    ip += 4;
   }
 
   /* Eliminate leading whitespace in all cases */
-  while (ostring[0] && isspace(ostring[0])) {
-    /* If orig string has N bytes, we want to copy N-1 bytes
-     * of the string itself plus the string terminator (which
-     * matters if the string consists of nothing but spaces)
-     */
-    memmove(&ostring[0], &ostring[1], strlen(ostring));
+  while (*ip && isspace(*ip)) {
+    ip++;
   }
 
-  if (!hdl->whitespaceok) {
-    /*
-     * Eliminate Whitespace
-     */
-    tstring = xstrdup(ostring);
-    l = strlen(tstring);
-    cp = ostring;
-    for (i=0; i<l; i++) {
-      if (!isspace(tstring[i])) {
-        *cp++ = tstring[i];
-      }
-    }
-    xfree(tstring);
-    *cp = 0;
-  }
-
-  if (hdl->mustupper) {
-    for (tstring = ostring; *tstring; tstring++) {
-      *tstring = toupper(*tstring);
+  /*
+   * Eliminate Whitespace if it isn't wanted and upcase if asked to.
+   */
+  for (op = ostring; *ip; ip++) {
+    if (!hdl->whitespaceok && isspace(*ip)) {
+      continue;
     }
+    *op++ = hdl->mustupper ? toupper(*ip) : *ip;
   }
+  *op = 0;
 
   /* Before we do any of the vowel or character removal, look for
    * constants to replace.
@@ -441,37 +382,33 @@ mkshort(short_handle h, const char* istring)
   replace_constants(ostring);
 
   /*
-   * Eliminate chars on the blacklist.
+   * Eliminate chars on the blacklist and repeated whitespace.
+   * Each pair of blanks used to be squeezed once, left to right,
+   * which keeps every other blank of a run.  Keep doing exactly that
+   * so existing names don't change.
    */
-  tstring = xstrdup(ostring);
-  l = strlen(tstring);
-  cp = ostring;
-  for (i=0; i<l; i++) {
-    if (strchr(hdl->badchars, tstring[i])) {
+  int blanks = 0;
+  for (ip = op = ostring; *ip; ip++) {
+    if (strchr(hdl->badchars, *ip)) {
       continue;
     }
-    if (hdl->goodchars && (!strchr(hdl->goodchars, tstring[i]))) {
+    if (hdl->goodchars && (!strchr(hdl->goodchars, *ip))) {
       continue;
     }
 // FIXME(robertl): we need a way to not return partial UTF-8, but this isn't it.
-//		if (!isascii(tstring[i]))
+//		if (!isascii(*ip))
 //			continue;
-    *cp++ = tstring[i];
-  }
-  *cp = 0;
-  xfree(tstring);
-
-  /*
-   * Eliminate repeated whitespace.  This can only shorten the string
-   * so we do it in place.
-   */
-  if (!hdl->repeating_whitespaceok) {
-    for (i = 0; i < l-1; i++) {
-      if (ostring[i] == ' ' && ostring[i+1] == ' ') {
-        memmove(&ostring[i], &ostring[i+1], l-i);
+    if (*ip == ' ') {
+      if (!hdl->repeating_whitespaceok && (blanks++ & 1)) {
+        continue;
       }
+    } else {
+      blanks = 0;
     }
+    *op++ = *ip;
   }
+  *op = 0;
+  len = op - ostring;
 
   /*
    * Toss vowels to approach target length, but don't toss them
@@ -495,13 +432,7 @@ mkshort(short_handle h, const char* istring)
    * It also helps units with speech synthesis.
    */
   if (hdl->target_len < 15) {
-    replaced = 1;
-  } else {
-    replaced = 0;
-  }
-
-  while (replaced && strlen(ostring) > hdl->target_len) {
-    ostring = delete_last_vowel(2, ostring, &replaced);
+    len = delete_vowels(2, ostring, len, hdl->target_len);
   }
 
   /*
@@ -511,11 +442,11 @@ mkshort(short_handle h, const char* istring)
    * Walk in the Woods 2.
    */
 
-  char* np = ostring + strlen(ostring);
+  char* np = ostring + len;
   while ((np != ostring) && *(np-1) && isdigit(*(np-1))) {
     np--;
   }
-  size_t nlen = strlen(np);
+  size_t nlen = len - (np - ostring);
 
   /*
    * Now brutally truncate the resulting string, preserve trailing
@@ -530,7 +461,7 @@ mkshort(short_handle h, const char* istring)
       xfree(ostring);
       ostring = tmp;
     }
-  } else if ((/*i = */strlen(ostring)) > hdl->target_len) {
+  } else if (len > hdl->target_len) {
     char* dp = &ostring[hdl->target_len] - nlen;
     if (dp < ostring) {
       dp = ostring;
@@ -577,16 +508,16 @@ mkshort_from_wpt(short_handle h, const Waypoint* wpt)
    * more stuff than should be in any one field...
    */
   if (wpt->gc_data->diff && wpt->gc_data->terr &&
-      !wpt->notes.isEmpty()) {
-    return mkshort(h, wpt->notes);
+      !wpt->GetNotes().isEmpty()) {
+    return mkshort(h, wpt->GetNotes());
   }
 
-  if (!wpt->description.isEmpty()) {
-    return mkshort(h, wpt->description);
+  if (!wpt->GetDescription().isEmpty()) {
+    return mkshort(h, wpt->GetDescription());
   }
 
-  if (!wpt->notes.isEmpty()) {
-    return mkshort(h, wpt->notes);
+  if (!wpt->GetNotes().isEmpty()) {
+    return mkshort(h, wpt->GetNotes());
   }
 
   /* Should probably never actually happen... */
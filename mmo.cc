@@ -485,26 +485,26 @@ mmo_read_CObjWaypoint(mmo_data_t* data)
     }
 
     if (*cend++) {
-      wpt->notes = QString::fromLatin1(cend);
+      wpt->SetNotes(QString::fromLatin1(cend));
     }
 
     if (wpt->HasUrlLink()) {
       DBG((sobj, "url = \"%s\"\n", wpt->url));
     }
   } else if (*str) {
-    wpt->notes = QString::fromLatin1(str);
+    wpt->SetNotes(QString::fromLatin1(str));
   }
   xfree(str);
-  if (!wpt->notes.isEmpty()) {
-    DBG((sobj, "notes = \"%s\"\n", wpt->notes));
+  if (!wpt->GetNotes().isEmpty()) {
+    DBG((sobj, "notes = \"%s\"\n", wpt->GetNotes()));
   }
 
   mmo_fillbuf(buf, 12, 1);
   i = le_read32(&buf[8]);		/* icon */
   if (i != -1) {
     if (icons.contains(i)) {
-      wpt->icon_descr = icons.value(i);
-      DBG((sobj, "icon = \"%s\"\n", qPrintable(wpt->icon_descr)));
+      wpt->SetIconDescr(icons.value(i));
+      DBG((sobj, "icon = \"%s\"\n", qPrintable(wpt->GetIconDescr())));
     }
 #ifdef MMO_DBG
     else {
@@ -521,7 +521,7 @@ mmo_read_CObjWaypoint(mmo_data_t* data)
 
   str = mmo_readstr();	/* name on gps ??? option ??? */
   if (*str) {
-    wpt->description = wpt->shortname;
+    wpt->SetDescription(wpt->shortname);
     wpt->shortname = str;
     DBG((sobj, "name on gps = %s\n", str));
   } else {
@@ -929,18 +929,18 @@ mmo_finalize_rtept_cb(const Waypoint* wptref)
     wpt->longitude = wpt2->longitude;
     wpt->shortname = wpt2->shortname;
 
-    wpt->description = wpt2->description;
-    wpt->notes = (wpt2->notes);
+    wpt->SetDescription(wpt2->GetDescription());
+    wpt->SetNotes(wpt2->GetNotes());
     if (wpt2->HasUrlLink()) {
       UrlLink l = wpt2->GetUrlLink();
-      wpt->notes = l.url_;
+      wpt->SetNotes(l.url_);
     }
 
     wpt->proximity = wpt2->proximity;
     wpt->wpt_flags.proximity = wpt2->wpt_flags.proximity;
 
-    if (!wpt2->icon_descr.isNull()) {
-      wpt->icon_descr = wpt2->icon_descr;
+    if (!wpt2->GetIconDescr().isNull()) {
+      wpt->SetIconDescr(wpt2->GetIconDescr());
     }
   }
 }
@@ -1224,9 +1224,9 @@ mmo_write_wpt_cb(const Waypoint* wpt)
     str += "\n";
   }
 
-  QString cx = wpt->notes;
+  QString cx = wpt->GetNotes();
   if (cx == nullptr) {
-    cx = wpt->description;
+    cx = wpt->GetDescription();
   }
   if (cx != nullptr) {
     char* kml = nullptr;
@@ -1249,11 +1249,11 @@ mmo_write_wpt_cb(const Waypoint* wpt)
     gbfputflt(0, fout);
   }
 
-  if (!wpt->icon_descr.isNull()) {
+  if (!wpt->GetIconDescr().isNull()) {
     int i = 0;
 
     while (mmo_icon_value_table[i].icon) {
-      if (wpt->icon_descr.compare(mmo_icon_value_table[i].icon, Qt::CaseInsensitive) == 0) {
+      if (wpt->GetIconDescr().compare(mmo_icon_value_table[i].icon, Qt::CaseInsensitive) == 0) {
         icon = mmo_icon_value_table[i].value;
         break;
       }
@@ -57,8 +57,10 @@
 #include "defs.h"
 #include "gbfile.h" /* used for csv output */
 #include "gbser.h"
+#include <QtCore/QByteArray>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
+#include <QtCore/QStringList>
 #include <QtCore/QThread>
 #include <cerrno>
 #include <cmath>
@@ -240,7 +242,9 @@ static char* OPT_erase_only;  /* erase_only ? command option */
 static char* OPT_log_enable;  /* enable ? command option */
 static char* csv_file; /* csv ? command option */
 static char* OPT_block_size_kb; /* block_size_kb ? command option */
+static char* OPT_cache; /* cache ? command option */
 static enum MTK_DEVICE_TYPE mtk_device = MTK_LOGGER;
+static QString mtk_firmware; /* firmware release reported by the device */
 
 static struct mtk_loginfo mtk_info;
 
@@ -284,6 +288,10 @@ static arglist_t mtk_sargs[] = {
     "block_size_kb", &OPT_block_size_kb, "Size of blocks in KB to request from device",
     "1", ARGTYPE_INT, "1", "64", nullptr
   },
+  {
+    "cache", &OPT_cache, "Keep downloaded data in this file and only fetch new data",
+    nullptr, ARGTYPE_FILE, ARG_NOMINMAX, nullptr
+  },
   ARG_TERMINATOR
 };
 
@@ -301,6 +309,8 @@ static void dbg(int l, const char* msg, ...)
 // Returns a fully qualified pathname to a temporary file that is a copy
 // of the data downloaded from the device. Only two copies are ever in play,
 // the primary (e.g. "/tmp/data.bin") and the backup ("/tmp/data_old.bin").
+// The cache option replaces the primary, so that each device can have a
+// copy of its own; the backup then gets an ".old" suffix.
 //
 // It returns a temporary C string - it's totally kludged in to replace
 // TEMP_DATA_BIN being string constants.
@@ -308,11 +318,52 @@ static const QString GetTempName(bool backup)
 {
   const char kData[]= "data.bin";
   const char kDataBackup[]= "data_old.bin";
+  if (OPT_cache) {
+    return backup ? QString(OPT_cache) + ".old" : QString(OPT_cache);
+  }
   return QDir::tempPath() + QDir::separator() + (backup ? kDataBackup : kData);
 }
 #define TEMP_DATA_BIN GetTempName(false)
 #define TEMP_DATA_BIN_OLD GetTempName(true)
 
+// The cache option keeps a key next to the data file that tells which
+// download the data belongs to: the firmware release the device reported
+// (MTK loggers have no serial number), the flash write pointer and the
+// CRC32 of the data, one per line.
+static const QString GetCacheKeyName()
+{
+  return QString(OPT_cache) + ".key";
+}
+
+static QStringList mtk_cache_key(unsigned int log_addr)
+{
+  QFile file(TEMP_DATA_BIN);
+  QByteArray data;
+  if (file.open(QIODevice::ReadOnly)) {
+    data = file.readAll();
+  }
+  return QStringList() << mtk_firmware << QString::number(log_addr, 16)
+         << QString::number(get_crc32(data.constData(), data.size()), 16);
+}
+
+static QStringList mtk_load_cache_key()
+{
+  QFile file(GetCacheKeyName());
+  if (!file.open(QIODevice::ReadOnly)) {
+    return QStringList();
+  }
+  return QString::fromUtf8(file.readAll()).split('\n');
+}
+
+static void mtk_save_cache_key(const QStringList& key)
+{
+  QFile file(GetCacheKeyName());
+  QByteArray data = key.join('\n').toUtf8();
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(data) != data.size()) {
+    warning(MYNAME ": Can't write cache key %s\n", qPrintable(GetCacheKeyName()));
+  }
+}
+
 static int do_send_cmd(const char* cmd, int cmdLen)
 {
   dbg(6, "Send %s ", cmd);
@@ -477,6 +528,7 @@ static void mtk_rd_init(const QString& fname)
       dbg(2, "Greeting not successfull.\n");
     }
   }
+  mtk_firmware = model;
   xfree(model);
 }
 
@@ -524,6 +576,9 @@ static int mtk_erase()
   // Erase log....
   do_cmd(CMD_LOG_ERASE, "PMTK001,182,6", nullptr, 30);
   QThread::usleep(100 * 1000);
+  if (OPT_cache) {
+    QFile::remove(GetCacheKeyName());  // the cached data is no longer on the device
+  }
 
   if ((log_status & 2)) {  // auto-log were enabled before..re-enable log.
     int err = do_cmd(CMD_LOG_ENABLE, "PMTK001,182,4,3", nullptr, 2);
@@ -585,10 +640,12 @@ static void mtk_read()
   QThread::usleep(100 * 1000);
 
   unsigned int addr_max = 0;
+  unsigned int log_addr = 0;  // write pointer as reported by the device
   // get flash usage, current log address..cmd only works if log disabled.
   do_cmd("$PMTK182,2,8*33\r\n", "PMTK182,3,8,", &fusage, 2);
   if (fusage) {
     addr_max = strtoul(fusage, nullptr, 16);
+    log_addr = addr_max;
     if (addr_max > 0) {
       addr_max =  addr_max - addr_max%65536 + 65535;
     }
@@ -601,8 +658,24 @@ static void mtk_read()
   }
   dbg(1, "Download %dkB from device\n", (addr_max+1) >> 10);
 
-  if (dsize > addr_max) {
-    dbg(1, "Temp %s file (%ld) is larger than data size %d. Data erased since last download !\n", qPrintable(TEMP_DATA_BIN), dsize, addr_max);
+  bool cache_ignored = false;
+  bool cache_current = false;
+  if (OPT_cache && dsize > 0) {
+    QStringList key = mtk_cache_key(log_addr);
+    QStringList cached = mtk_load_cache_key();
+    if (cached.size() != key.size() || cached[0] != key[0] || cached[2] != key[2]) {
+      dbg(1, "Cache %s is from another device or damaged, ignoring it\n", qPrintable(TEMP_DATA_BIN));
+      cache_ignored = true;
+    } else if (log_addr != 0 && cached[1] == key[1] && dsize <= addr_max) {
+      dbg(1, "Log write pointer hasn't moved, using %s as it is\n", qPrintable(TEMP_DATA_BIN));
+      cache_current = true;
+    }
+  }
+
+  if (cache_ignored || dsize > addr_max) {
+    if (!cache_ignored) {
+      dbg(1, "Temp %s file (%ld) is larger than data size %d. Data erased since last download !\n", qPrintable(TEMP_DATA_BIN), dsize, addr_max);
+    }
     fclose(dout);
     dsize = 0;
     init_scan = 0;
@@ -630,6 +703,10 @@ static void mtk_read()
     bsize = read_bsize;
   }
   unsigned int addr = 0x0000;
+  if (cache_current) {
+    init_scan = 0;
+    addr = addr_max = dsize;  // nothing to fetch
+  }
 
   unsigned int line_size = 2*read_bsize + 32; // logdata as nmea/hex.
   unsigned int data_size = read_bsize + 32;
@@ -771,6 +848,9 @@ mtk_retry:
 #endif
     fclose(dout);
   }
+  if (OPT_cache) {
+    mtk_save_cache_key(mtk_cache_key(log_addr));
+  }
   if (global_opts.verbose_status || (global_opts.debug_level >= 2 && global_opts.debug_level < 5)) {
     fprintf(stderr,"\n");
   }
@@ -109,7 +109,7 @@ NaviReadCache(const QXmlStreamReader& reader)
     wpt_tmp->AddUrlLink(l);
   }
   if (a.hasAttribute("name")) {
-    wpt_tmp->description = a.value("name").toString();
+    wpt_tmp->SetDescription(a.value("name").toString());
   }
   if (a.hasAttribute("user_name")) {
     gc_data->placer = a.value("user_name").toString();
@@ -133,13 +133,13 @@ NaviReadCache(const QXmlStreamReader& reader)
     QString t = a.value("cache_type").toString();
     gc_data->type = nc_mktype(t);
     if (t == "normal") {
-      wpt_tmp->icon_descr = "Geocache-regular";
+      wpt_tmp->SetIconDescr("Geocache-regular");
     } else if (t == "multi-part") {
-      wpt_tmp->icon_descr = "Geocache-multi";
+      wpt_tmp->SetIconDescr("Geocache-multi");
     } else if (t == "moving_travelling") {
-      wpt_tmp->icon_descr = "Geocache-moving";
+      wpt_tmp->SetIconDescr("Geocache-moving");
     } else {
-      wpt_tmp->icon_descr = QString("Geocache-%-%1").arg(t);
+      wpt_tmp->SetIconDescr(QString("Geocache-%-%1").arg(t));
     }
   }
 
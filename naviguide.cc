@@ -255,7 +255,7 @@ ng_waypt_rd(const Waypoint* wpt)
     s = wpt->shortname;
   }
 
-  ng_fwrite_wp_data(s, wpt->description, &WPNC.wp_data, file_out);
+  ng_fwrite_wp_data(s, wpt->GetDescription(), &WPNC.wp_data, file_out);
 
 
   /* if not Last WP, write the next one index */
@@ -395,7 +395,7 @@ data_read()
     /* put the data in the waypoint structure */
     ng_convert_datum(wpt_tmp);
     wpt_tmp->shortname = STRTOUNICODE(WPNC.strName);
-    wpt_tmp->description = STRTOUNICODE(strComment);
+    wpt_tmp->SetDescription(STRTOUNICODE(strComment));
 
     if (process_rte) {
       route_add_wpt(rte_head, wpt_tmp);
@@ -404,7 +404,7 @@ decode_waypoint(const unsigned char* buffer)
   char* s = xstrdup((char*)buffer + 4);
   waypt->shortname = s;
   xfree(s);
-  waypt->icon_descr = icon_table[buffer[28]];
+  waypt->SetIconDescr(icon_table[buffer[28]]);
   waypt->SetCreationTime(decode_datetime(buffer + 22));
 
   return waypt;
@@ -421,7 +421,7 @@ encode_waypoint(const Waypoint* waypt, unsigned char* buffer)
   buffer[11] = 0;
   encode_position(waypt, buffer + 12);
   encode_datetime(waypt->GetCreationTime().toTime_t(), buffer + 22);
-  buffer[28] = find_icon_from_descr(waypt->icon_descr);
+  buffer[28] = find_icon_from_descr(waypt->GetIconDescr());
   buffer[29] = 0;
   buffer[30] = 0x00;
   buffer[31] = 0x7e;
@@ -219,15 +219,15 @@ data_read()
       }
 
       if (flags & 0x0010) {	/* encrypted? */
-        wpt_tmp->icon_descr = seicon;
+        wpt_tmp->SetIconDescr(seicon);
       } else {
-        wpt_tmp->icon_descr = sneicon;
+        wpt_tmp->SetIconDescr(sneicon);
       }
     } else {
       if (flags & 0x0010) {	/* encrypted? */
-        wpt_tmp->icon_descr = nseicon;
+        wpt_tmp->SetIconDescr(nseicon);
       } else {
-        wpt_tmp->icon_descr = nsneicon;
+        wpt_tmp->SetIconDescr(nsneicon);
       }
     }
 
@@ -239,7 +239,7 @@ data_read()
       wpt_tmp->shortname = (ssid);
     }
 
-    wpt_tmp->description = desc;
+    wpt_tmp->SetDescription(desc);
     wpt_tmp->longitude = lon;
     wpt_tmp->latitude = lat;
     wpt_tmp->SetCreationTime(mktime(&tm));
@@ -278,7 +278,7 @@ compare(const void* a, const void* b)
 
     Waypoint* wpt_a = ((const htable_t*)a)->wpt;
     Waypoint* wpt_b = ((const htable_t*)b)->wpt;
-    return wpt_a->description.compare(wpt_b->description);
+    return wpt_a->GetDescription().compare(wpt_b->GetDescription());
   }
 }
 
@@ -301,12 +301,12 @@ fix_netstumbler_dupes()
 #if NEWQ
   // Why, oh, why is this format running over the entire waypoint list and
   // modifying it?  This seems wrong.
-  extern QList<Waypoint*> waypt_list;
+  extern thread_local QList<Waypoint*> waypt_list;
   foreach(Waypoint* waypointp, waypt_list) {
     bh->wpt = waypointp;
 #else
   queue* elem, *tmp;
-  extern queue waypt_head;
+  extern thread_local queue waypt_head;
   QUEUE_FOR_EACH(&waypt_head, elem, tmp) {
     bh->wpt = reinterpret_cast<Waypoint *>(elem);
 #endif
@@ -150,55 +150,55 @@ typedef enum {
   gprmc
 } preferred_posn_type;
 
-static enum {
+static thread_local enum {
   rm_unknown = 0,
   rm_serial,
   rm_file
 } read_mode;
 
-static gbfile* file_in, *file_out;
-static route_head* trk_head;
-static short_handle mkshort_handle;
-static preferred_posn_type posn_type;
-static struct tm tm;
-static Waypoint* curr_waypt;
-static Waypoint* last_waypt;
-static void* gbser_handle;
-static QString posn_fname;
-static queue pcmpt_head;
+static thread_local gbfile* file_in, *file_out;
+static thread_local route_head* trk_head;
+static thread_local short_handle mkshort_handle;
+static thread_local preferred_posn_type posn_type;
+static thread_local struct tm tm;
+static thread_local Waypoint* curr_waypt;
+static thread_local Waypoint* last_waypt;
+static thread_local void* gbser_handle;
+static thread_local QString posn_fname;
+static thread_local queue pcmpt_head;
 
-static int without_date;	/* number of created trackpoints without a valid date */
-static struct tm opt_tm;	/* converted "date" parameter */
+static thread_local int without_date;	/* number of created trackpoints without a valid date */
+static thread_local struct tm opt_tm;	/* converted "date" parameter */
 
 #define MYNAME "nmea"
 
-static char* opt_gprmc;
-static char* opt_gpgga;
-static char* opt_gpvtg;
-static char* opt_gpgsa;
-static char* snlenopt;
-static char* optdate;
-static char* getposnarg;
-static char* opt_sleep;
-static char* opt_baud;
-static char* opt_append;
-static char* opt_gisteq;
-static char* opt_ignorefix;
-
-static long sleepus;
-static int getposn;
-static int append_output;
-static int amod_waypoint;
-
-static time_t last_time;
-static double last_read_time;   /* Last timestamp of GGA or PRMC */
-static int datum;
-static int had_checksum;
+static thread_local char* opt_gprmc;
+static thread_local char* opt_gpgga;
+static thread_local char* opt_gpvtg;
+static thread_local char* opt_gpgsa;
+static thread_local char* snlenopt;
+static thread_local char* optdate;
+static thread_local char* getposnarg;
+static thread_local char* opt_sleep;
+static thread_local char* opt_baud;
+static thread_local char* opt_append;
+static thread_local char* opt_gisteq;
+static thread_local char* opt_ignorefix;
+
+static thread_local long sleepus;
+static thread_local int getposn;
+static thread_local int append_output;
+static thread_local int amod_waypoint;
+
+static thread_local time_t last_time;
+static thread_local double last_read_time;   /* Last timestamp of GGA or PRMC */
+static thread_local int datum;
+static thread_local int had_checksum;
 
 static Waypoint* nmea_rd_posn(posn_status*);
 static void nmea_rd_posn_init(const QString& fname);
 
-static arglist_t nmea_args[] = {
+static thread_local arglist_t nmea_args[] = {
   {"snlen", &snlenopt, "Max length of waypoint name to write", "6", ARGTYPE_INT, "1", "64", nullptr },
   {"gprmc", &opt_gprmc, "Read/write GPRMC sentences", "1", ARGTYPE_BOOL, ARG_NOMINMAX, nullptr },
   {"gpgga", &opt_gpgga, "Read/write GPGGA sentences", "1", ARGTYPE_BOOL, ARG_NOMINMAX, nullptr },
@@ -899,7 +899,7 @@ nmea_fix_timestamps(route_head* track)
           wpt->creation_time+=SECONDS_PER_DAY;
         }
       }
-      prev = wpt->GetCreationTime().toTime_t();
+      prev = wpt->creation_time.toTime_t();
     }
   }
 }
@@ -944,7 +944,7 @@ nmea_parse_one_line(char* ibuf)
     int ckcmp;
     sscanf(ck, "%2X", &ckcmp);
     if (ckval != ckcmp) {
-      Warning() << "Invalid NMEA checksum. Computed " << ckval << " but found " << ckcmp << ". Ignoring sentence";
+      warning(WarningMsg() << "Invalid NMEA checksum. Computed " << ckval << " but found " << ckcmp << ". Ignoring sentence");
       return;
     }
 
@@ -1120,7 +1120,7 @@ int hunt_sirf()
 {
   /* Try to place the common BR's first to speed searching */
   static int br[] = {38400, 9600, 57600, 115200, 19200, 4800, -1};
-  static int* brp = &br[0];
+  static thread_local int* brp = &br[0];
   char ibuf[1024];
 
   for (brp = br; *brp > 0; brp++) {
@@ -1160,7 +1160,7 @@ static Waypoint*
 nmea_rd_posn(posn_status*)
 {
   char ibuf[1024];
-  static double lt = -1;
+  static thread_local double lt = -1;
   int am_sirf = 0;
 
   /*
@@ -1254,20 +1254,21 @@ nmea_trackpt_pr(const Waypoint* wpt)
       if (sleepus >= 0) {
         QThread::usleep(sleepus);
       } else {
-        long wait_time = wpt->GetCreationTime().toTime_t() - last_time;
+        long wait_time = wpt->creation_time.toTime_t() - last_time;
         if (wait_time > 0) {
           QThread::usleep(wait_time * 1000000);
         }
       }
     }
-    last_time = wpt->GetCreationTime().toTime_t();
+    last_time = wpt->creation_time.toTime_t();
   }
 
   double lat = degrees2ddmm(wpt->latitude);
   double lon = degrees2ddmm(wpt->longitude);
 
-  time_t ct = wpt->GetCreationTime().toTime_t();
-  struct tm* tm = gmtime(&ct);
+  time_t ct = wpt->creation_time.toTime_t();
+  struct tm tm_buf;
+  struct tm* tm = gb_gmtime_r(&ct, &tm_buf);
   if (tm) {
     hms = tm->tm_hour * 10000 + tm->tm_min * 100 + tm->tm_sec;
     ymd = tm->tm_mday * 10000 + tm->tm_mon * 100 + tm->tm_year;
@@ -1384,7 +1385,7 @@ nmea_wr_posn_deinit()
 }
 
 
-ff_vecs_t nmea_vecs = {
+thread_local ff_vecs_t nmea_vecs = {
   ff_type_file,
   {
     (ff_cap)(ff_cap_read | ff_cap_write),
@@ -154,11 +154,11 @@ nmn4_read_data()
         }
 
         /* concats all fields to one string and release */
-        wpt->description = zip1.trimmed() + " " +
+        wpt->SetDescription(zip1.trimmed() + " " +
           city.trimmed() + " " +
           street.trimmed() + " " +
           number.trimmed() + " " +
-          zip2.trimmed();
+          zip2.trimmed());
 
         break;
 
@@ -493,7 +493,7 @@ osm_node(xg_string, const QXmlStreamAttributes* attrv)
 
   if (attrv->hasAttribute("id")) {
     QString atstr = attrv->value("id").toString();
-    wpt->description =  "osm-id " + atstr;
+    wpt->SetDescription("osm-id " + atstr);
     if (waypoints.contains(atstr)) {
       warning(MYNAME ": Duplicate osm-id %s!\n", qPrintable(atstr));
     } else {
@@ -513,7 +513,7 @@ osm_node(xg_string, const QXmlStreamAttributes* attrv)
 
   if (attrv->hasAttribute("timestamp")) {
     QString ts = attrv->value("timestamp").toString();
-    wpt->creation_time = xml_parse_time(ts);
+    wpt->SetCreationTime(xml_parse_time(ts));
   }
 }
 
@@ -540,13 +540,12 @@ osm_node_tag(xg_string, const QXmlStreamAttributes* attrv)
   } else if (key == QLatin1String("name:en")) {
     wpt->shortname = str;
   } else if ((ikey = osm_feature_ikey(key)) >= 0) {
-    wpt->icon_descr = osm_feature_symbol(ikey, CSTR(value));
+    wpt->SetIconDescr(osm_feature_symbol(ikey, CSTR(value)));
   } else if (key == QLatin1String("note")) {
-    if (wpt->notes.isEmpty()) {
-      wpt->notes = str;
+    if (wpt->GetNotes().isEmpty()) {
+      wpt->SetNotes(str);
     } else {
-      wpt->notes += "; ";
-      wpt->notes += str;
+      wpt->SetNotes(wpt->GetNotes() + "; " + str);
     }
   } else if (key == QLatin1String("gps:hdop")) {
     wpt->hdop = str.toDouble();
@@ -625,13 +624,12 @@ osm_way_tag(xg_string, const QXmlStreamAttributes* attrv)
     wpt->shortname = str;
     // The remaining cases only apply to the center node
   } else if ((ikey = osm_feature_ikey(key)) >= 0) {
-    wpt->icon_descr = osm_feature_symbol(ikey, CSTR(value));
+    wpt->SetIconDescr(osm_feature_symbol(ikey, CSTR(value)));
   } else if (key == "note") {
-    if (wpt->notes.isEmpty()) {
-      wpt->notes = str;
+    if (wpt->GetNotes().isEmpty()) {
+      wpt->SetNotes(str);
     } else {
-      wpt->notes += "; ";
-      wpt->notes += str;
+      wpt->SetNotes(wpt->GetNotes() + "; " + str);
     }
   }
 }
@@ -724,8 +722,8 @@ osm_write_tag(const QString& key, const QString& value)
 static void
 osm_disp_feature(const Waypoint* wpt)
 {
-  if (icons.contains(wpt->icon_descr)) {
-    const osm_icon_mapping_t* map = icons.value(wpt->icon_descr);
+  if (icons.contains(wpt->GetIconDescr())) {
+    const osm_icon_mapping_t* map = icons.value(wpt->GetIconDescr());
     osm_write_tag(osm_features[map->key], map->value);
   }
 }
@@ -845,8 +843,8 @@ osm_waypt_disp(const Waypoint* wpt)
   }
 
   osm_write_tag("name", wpt->shortname);
-  osm_write_tag("note", (wpt->notes.isEmpty()) ? wpt->description : wpt->notes);
-  if (!wpt->icon_descr.isNull()) {
+  osm_write_tag("note", (wpt->GetNotes().isEmpty()) ? wpt->GetDescription() : wpt->GetNotes());
+  if (!wpt->GetIconDescr().isNull()) {
     osm_disp_feature(wpt);
   }
 
@@ -360,7 +360,7 @@ ozi_route_disp(const Waypoint* waypointp)
             waypointp->latitude,
             waypointp->longitude,
             ozi_time,
-            CSTR(waypointp->description));
+            CSTR(waypointp->GetDescription()));
 
 }
 
@@ -517,7 +517,7 @@ ozi_parse_waypt(int field, const QString& str, Waypoint* wpt_tmp, ozi_fsdata* fs
        other types, but it at least maintains fidelity for an ozi->ozi
        operation. */
     if (str.toInt() > 0) {
-      wpt_tmp->icon_descr = str;
+      wpt_tmp->SetIconDescr(str);
     }
     break;
   case 6:
@@ -536,7 +536,7 @@ ozi_parse_waypt(int field, const QString& str, Waypoint* wpt_tmp, ozi_fsdata* fs
     break;
   case 10:
     /* Description */
-    wpt_tmp->description = str.trimmed();
+    wpt_tmp->SetDescription(str.trimmed());
     break;
   case 11:
     /* pointer direction 0,1,2,3 bottom,top,left,right */
@@ -675,7 +675,7 @@ ozi_parse_routepoint(int field, char* str, Waypoint* wpt_tmp)
     break;
   case 13:
     /* description */
-    wpt_tmp->description = csv_stringclean(str, QString(","));
+    wpt_tmp->SetDescription(csv_stringclean(str, QString(",")));
     break;
   default:
     break;
@@ -882,11 +882,11 @@ ozi_waypt_pr(const Waypoint* wpt)
     alt = wpt->altitude * alt_scale;
   }
   if ((wpt->shortname.isEmpty()) || (global_opts.synthesize_shortnames)) {
-    if (!wpt->description.isEmpty()) {
+    if (!wpt->GetDescription().isEmpty()) {
       if (global_opts.synthesize_shortnames) {
         shortname = mkshort_from_wpt(mkshort_handle, wpt);
       } else {
-        shortname = csv_stringclean(wpt->description, BADCHARS);
+        shortname = csv_stringclean(wpt->GetDescription(), BADCHARS);
       }
     } else {
       /* no description available */
@@ -895,20 +895,20 @@ ozi_waypt_pr(const Waypoint* wpt)
   } else {
     shortname = csv_stringclean(wpt->shortname, BADCHARS);
   }
-  if (wpt->description.isEmpty()) {
+  if (wpt->GetDescription().isEmpty()) {
     if (!shortname.isEmpty()) {
       description = csv_stringclean(shortname, BADCHARS);
     } else {
       description = xstrdup("");
     }
   } else {
-    description = csv_stringclean(wpt->description, BADCHARS);
+    description = csv_stringclean(wpt->GetDescription(), BADCHARS);
   }
 
   index++;
 
-  if (wpt->icon_descr.toInt()) {
-    icon = wpt->icon_descr.toInt();
+  if (wpt->GetIconDescr().toInt()) {
+    icon = wpt->GetIconDescr().toInt();
   }
 
   gbfprintf(file_out,
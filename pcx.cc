@@ -157,8 +157,8 @@ static void data_read() {
         wpt_tmp->altitude = alt;
         SetWaypointTime(wpt_tmp, date, time);
         wpt_tmp->shortname = name.trimmed();
-        wpt_tmp->description = desc.trimmed();
-        wpt_tmp->icon_descr = gt_find_desc_from_icon_number(symnum, PCX);
+        wpt_tmp->SetDescription(desc.trimmed());
+        wpt_tmp->SetIconDescr(gt_find_desc_from_icon_number(symnum, PCX));
 
         double lat = 0;
         double lon = 0;
@@ -303,7 +303,7 @@ static void gpsutil_disp(const Waypoint* wpt) {
   if (deficon) {
     icon_token = atoi(deficon);
   } else {
-    icon_token = gt_find_icon_number_from_desc(wpt->icon_descr, PCX);
+    icon_token = gt_find_icon_number_from_desc(wpt->GetIconDescr(), PCX);
     if (get_cache_icon(wpt)) {
       icon_token = gt_find_icon_number_from_desc(get_cache_icon(wpt), PCX);
     }
@@ -315,7 +315,7 @@ static void gpsutil_disp(const Waypoint* wpt) {
                 : CSTRc(wpt->shortname),
             lat < 0.0 ? 'S' : 'N', fabs(lat), lon < 0.0 ? 'W' : 'E', fabs(lon),
             CSTR(ds), (wpt->altitude == unknown_alt) ? -9999 : wpt->altitude,
-            (wpt->description != nullptr) ? CSTRc(wpt->description) : "", 0.0,
+            (wpt->GetDescription() != nullptr) ? CSTRc(wpt->GetDescription()) : "", 0.0,
             icon_token);
 }
 
@@ -0,0 +1,405 @@
+/*
+    Progress reports for front ends and stage timing.
+
+    Copyright (C) 2019 Robert Lipe, gpsbabel.org
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111 USA
+
+ */
+
+#include "defs.h"
+#include "progress.h"
+
+#include <QtCore/QElapsedTimer>  // for QElapsedTimer
+#include <QtCore/QJsonArray>     // for QJsonArray
+#include <QtCore/QJsonDocument>  // for QJsonDocument, QJsonDocument::Compact
+#include <QtCore/QJsonObject>    // for QJsonObject
+#include <QtCore/QVector>        // for QVector
+
+#include <cstdio>                // for fprintf, fputs, fputc, fflush, stderr
+#include <cstring>               // for strcmp
+
+#if !__WIN32__
+#include <sys/resource.h>        // for getrusage, rusage, RUSAGE_SELF
+#include <sys/time.h>            // for timeval
+#endif
+
+/* Points between looks at the clock. */
+#define PROGRESS_POINT_BATCH 256
+
+/* What --profile measured for one step of a stage. */
+typedef struct {
+  int invocation;
+  const char* stage;
+  const char* step;
+  QString name;
+  qint64 wall;		/* ns */
+  qint64 cpu;		/* ns, -1 if unknown */
+  unsigned long allocations;
+  long peak_so_far;	/* kB of the process up to the end of the step, -1 if unknown */
+  long points;
+} progress_timing_t;
+
+std::atomic<unsigned long> progress_allocations{0};
+bool progress_count_allocations = false;
+
+static thread_local QElapsedTimer progress_timer;
+static thread_local const char* progress_stage_name = nullptr;
+static thread_local QString progress_name;
+static thread_local long progress_points = 0;
+static thread_local const void* progress_handle = nullptr;
+static thread_local qint64 progress_total = 0;
+static thread_local std::function<qint64()> progress_pos;
+
+static thread_local QElapsedTimer progress_run_timer;
+static thread_local qint64 progress_run_cpu;
+static thread_local unsigned long progress_run_allocations;
+static thread_local QVector<progress_timing_t> progress_timings;
+static thread_local int progress_invocation = 0;
+static thread_local int progress_current = -1;	/* index into progress_timings */
+/* Where the current step stood when it was last resumed. */
+static thread_local QElapsedTimer progress_step_timer;
+static thread_local qint64 progress_step_cpu;
+static thread_local unsigned long progress_step_allocations;
+static thread_local long progress_step_points;
+
+bool
+progress_due(QElapsedTimer& timer)
+{
+  if (timer.isValid() && (timer.elapsed() < PROGRESS_INTERVAL)) {
+    return false;
+  }
+  timer.start();
+  return true;
+}
+
+static void
+progress_report()
+{
+  qint64 done = 0;
+  if (progress_handle != nullptr) {
+    done = progress_pos();
+    if (done < 0) {
+      done = 0;
+    }
+  }
+  fprintf(stderr, "progress\t%s\t%lld\t%lld\t%ld\t%s\n",
+          progress_stage_name, (long long) done, (long long) progress_total,
+          progress_points, qPrintable(progress_name));
+  fflush(stderr);
+  progress_timer.start();
+}
+
+/* The user and system time we used so far, in ns, or -1 when we can't tell. */
+static qint64
+progress_cpu_time()
+{
+#if !__WIN32__
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * Q_INT64_C(1000000000) +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * Q_INT64_C(1000);
+  }
+#endif
+  return -1;
+}
+
+/* The most memory we ever used, in kB, or -1 when we can't tell. */
+static long
+progress_peak_memory()
+{
+#if !__WIN32__
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if __APPLE__
+    return usage.ru_maxrss / 1024;	/* bytes, not kB */
+#else
+    return usage.ru_maxrss;
+#endif
+  }
+#endif
+  return -1;
+}
+
+/* Add what happened since the current step was resumed to its record. */
+static void
+progress_step_pause()
+{
+  if (progress_current < 0) {
+    return;
+  }
+  progress_timing_t& timing = progress_timings[progress_current];
+  qint64 cpu = progress_cpu_time();
+
+  timing.wall += progress_step_timer.nsecsElapsed();
+  if ((cpu < 0) || (timing.cpu < 0)) {
+    timing.cpu = -1;
+  } else {
+    timing.cpu += cpu - progress_step_cpu;
+  }
+  timing.allocations += progress_allocations.load(std::memory_order_relaxed) - progress_step_allocations;
+  timing.peak_so_far = progress_peak_memory();
+  if (strcmp(timing.step, "read") == 0) {
+    timing.points += progress_points - progress_step_points;
+  } else {
+    timing.points = waypt_count() + route_waypt_count() + track_waypt_count();
+  }
+  progress_current = -1;
+}
+
+static void
+progress_step_resume(const char* step)
+{
+  progress_step_pause();
+
+  for (int i = progress_timings.size() - 1; i >= 0; i--) {
+    const progress_timing_t& timing = progress_timings.at(i);
+    if (timing.invocation != progress_invocation) {
+      break;
+    }
+    if (strcmp(timing.step, step) == 0) {
+      progress_current = i;
+      break;
+    }
+  }
+  if (progress_current < 0) {
+    progress_timing_t timing;
+    timing.invocation = progress_invocation;
+    timing.stage = progress_stage_name;
+    timing.step = step;
+    timing.name = progress_name;
+    timing.wall = 0;
+    timing.cpu = 0;
+    timing.allocations = 0;
+    timing.peak_so_far = -1;
+    timing.points = 0;
+    progress_current = progress_timings.size();
+    progress_timings.append(timing);
+  }
+
+  progress_step_timer.start();
+  progress_step_cpu = progress_cpu_time();
+  progress_step_allocations = progress_allocations.load(std::memory_order_relaxed);
+  progress_step_points = progress_points;
+}
+
+static void
+progress_text_report(double wall, qint64 cpu, unsigned long allocations, long peak)
+{
+  fprintf(stderr, "%-8s %-8s %-24s %9s %9s %10s %14s %9s %10s\n", "stage", "step", "name",
+          "wall s", "cpu s", "allocs", "peak kB so far", "points", "points/s");
+  for (const auto& timing : progress_timings) {
+    double secs = timing.wall / 1.0e9;
+    fprintf(stderr, "%-8s %-8s %-24s %9.3f ", timing.stage, timing.step,
+            qPrintable(timing.name), secs);
+    if (timing.cpu >= 0) {
+      fprintf(stderr, "%9.3f ", timing.cpu / 1.0e9);
+    } else {
+      fprintf(stderr, "%9s ", "-");
+    }
+    if (progress_count_allocations) {
+      fprintf(stderr, "%10lu ", timing.allocations);
+    } else {
+      fprintf(stderr, "%10s ", "-");
+    }
+    if (timing.peak_so_far >= 0) {
+      fprintf(stderr, "%14ld ", timing.peak_so_far);
+    } else {
+      fprintf(stderr, "%14s ", "-");
+    }
+    fprintf(stderr, "%9ld %10.0f\n", timing.points, (secs > 0) ? timing.points / secs : 0.0);
+  }
+
+  fprintf(stderr, "%-8s %-8s %-24s %9.3f ", "total", "", "", wall);
+  if (cpu >= 0) {
+    fprintf(stderr, "%9.3f ", cpu / 1.0e9);
+  } else {
+    fprintf(stderr, "%9s ", "-");
+  }
+  if (progress_count_allocations) {
+    fprintf(stderr, "%10lu ", allocations);
+  } else {
+    fprintf(stderr, "%10s ", "-");
+  }
+  if (peak >= 0) {
+    fprintf(stderr, "%14ld\n", peak);
+  } else {
+    fprintf(stderr, "%14s\n", "-");
+  }
+}
+
+/* Unknown values are left out. */
+static void
+progress_json_report(double wall, qint64 cpu, unsigned long allocations, long peak)
+{
+  QJsonArray steps;
+  for (const auto& timing : progress_timings) {
+    QJsonObject step;
+    step["invocation"] = timing.invocation;
+    step["stage"] = timing.stage;
+    step["step"] = timing.step;
+    step["name"] = timing.name;
+    step["wall"] = timing.wall / 1.0e9;
+    if (timing.cpu >= 0) {
+      step["cpu"] = timing.cpu / 1.0e9;
+    }
+    if (progress_count_allocations) {
+      step["allocations"] = double(timing.allocations);
+    }
+    if (timing.peak_so_far >= 0) {
+      step["peak_rss_so_far_kb"] = double(timing.peak_so_far);
+    }
+    step["points"] = double(timing.points);
+    steps.append(step);
+  }
+
+  QJsonObject report;
+  report["steps"] = steps;
+  report["wall"] = wall;
+  if (cpu >= 0) {
+    report["cpu"] = cpu / 1.0e9;
+  }
+  if (progress_count_allocations) {
+    report["allocations"] = double(allocations);
+  }
+  if (peak >= 0) {
+    report["peak_rss_kb"] = double(peak);
+  }
+  fputs(QJsonDocument(report).toJson(QJsonDocument::Compact).constData(), stderr);
+  fputc('\n', stderr);
+}
+
+static void
+progress_summary()
+{
+  progress_step_pause();
+
+  double wall = progress_run_timer.nsecsElapsed() / 1.0e9;
+  qint64 cpu = progress_cpu_time();
+  if ((cpu >= 0) && (progress_run_cpu >= 0)) {
+    cpu -= progress_run_cpu;
+  } else {
+    cpu = -1;
+  }
+  unsigned long allocations = progress_allocations.load(std::memory_order_relaxed) - progress_run_allocations;
+  long peak = progress_peak_memory();
+
+  if (global_opts.profile == 2) {
+    progress_json_report(wall, cpu, allocations, peak);
+  } else {
+    progress_text_report(wall, cpu, allocations, peak);
+  }
+  fflush(stderr);
+  progress_timings.clear();
+  progress_invocation = 0;
+}
+
+void
+progress_stage(const char* stage, const QString& name)
+{
+  if (!global_opts.progress && !global_opts.profile) {
+    return;
+  }
+  if (global_opts.profile) {
+    progress_step_pause();
+    if (!progress_run_timer.isValid()) {
+      progress_run_timer.start();
+      progress_run_cpu = progress_cpu_time();
+      progress_run_allocations = progress_allocations.load(std::memory_order_relaxed);
+    }
+  }
+  progress_stage_name = stage;
+  progress_name = name;
+  progress_points = 0;
+  progress_handle = nullptr;
+  progress_total = 0;
+  progress_pos = nullptr;
+  if (global_opts.profile) {
+    progress_invocation++;
+    progress_step_resume(stage);
+  }
+  if (global_opts.progress) {
+    progress_report();
+  }
+}
+
+void
+progress_step(const char* step)
+{
+  if (!global_opts.profile || (progress_stage_name == nullptr)) {
+    return;
+  }
+  progress_step_resume((step != nullptr) ? step : progress_stage_name);
+}
+
+void
+progress_point()
+{
+  if (progress_stage_name == nullptr) {
+    return;
+  }
+  ++progress_points;
+  if (global_opts.progress && (progress_points % PROGRESS_POINT_BATCH == 0) &&
+      (progress_timer.elapsed() >= PROGRESS_INTERVAL)) {
+    progress_report();
+  }
+}
+
+void
+progress_done()
+{
+  if (!global_opts.progress && !global_opts.profile) {
+    return;
+  }
+  if (global_opts.profile) {
+    progress_summary();
+  }
+  progress_stage_name = nullptr;
+  if (global_opts.progress) {
+    progress_stage_name = "done";
+    progress_name.clear();
+    progress_points = 0;
+    progress_handle = nullptr;
+    progress_total = 0;
+    progress_report();
+    progress_stage_name = nullptr;
+  }
+  progress_run_timer.invalidate();
+}
+
+void
+progress_file(const void* handle, qint64 total, const std::function<qint64()>& pos)
+{
+  if (!global_opts.progress || (progress_stage_name == nullptr) ||
+      (progress_handle != nullptr)) {
+    return;
+  }
+  progress_handle = handle;
+  progress_total = (total > 0) ? total : 0;
+  progress_pos = pos;
+}
+
+void
+progress_file_closed(const void* handle)
+{
+  if ((progress_handle != nullptr) && (handle == progress_handle)) {
+    /* Remember where the file ended, and keep later files of this stage out. */
+    qint64 done = progress_pos();
+    progress_pos = [done]() {
+      return done;
+    };
+    progress_handle = &progress_pos;
+  }
+}
@@ -0,0 +1,81 @@
+/*
+    Machine readable progress for front ends.
+
+    Copyright (C) 2019 Robert Lipe, gpsbabel.org
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111 USA
+
+ */
+
+#ifndef PROGRESS_H_INCLUDED_
+#define PROGRESS_H_INCLUDED_
+
+#include <QtCore/QElapsedTimer>  // for QElapsedTimer
+#include <QtCore/QString>        // for QString
+#include <QtCore/QtGlobal>       // for qint64
+
+#include <atomic>                // for atomic
+#include <functional>            // for function
+
+/*
+ * With -vp gpsbabel reports its progress on stderr in lines of the form
+ *
+ *   progress<TAB>stage<TAB>bytes done<TAB>bytes total<TAB>points<TAB>name
+ *
+ * where stage is one of read, filter, write or done, a byte total of 0
+ * means it is unknown, and points counts the waypoints, route points and
+ * track points handled in the stage so far.  A line is written whenever
+ * a stage starts and otherwise at most every PROGRESS_INTERVAL ms.
+ */
+#define PROGRESS_INTERVAL 200
+
+/*
+ * With --profile the same stages are measured, and progress_done() prints
+ * the wall and CPU time, allocations and points of each of them to stderr,
+ * as a table or with --profile=json as one line of JSON.  The system only
+ * tells the peak memory of the whole process, so a step shows the peak so
+ * far at its end ("peak kB so far", "peak_rss_so_far_kb"), and only the
+ * total is the peak of the run.
+ * progress_step() splits a stage into steps that are measured on their
+ * own, e.g. the character set conversion after reading.  Returning to a
+ * step adds to what was measured for it before.
+ */
+void progress_stage(const char* stage, const QString& name = QString());
+void progress_step(const char* step);
+void progress_point();
+void progress_done();
+
+/*
+ * The gpsbabel program counts its operator new calls here while
+ * progress_count_allocations is set.  The library counts nothing.
+ */
+extern std::atomic<unsigned long> progress_allocations;
+extern bool progress_count_allocations;
+
+/*
+ * True if timer was never started or PROGRESS_INTERVAL ms have passed
+ * since it last returned true, for displays that mustn't draw every point.
+ */
+bool progress_due(QElapsedTimer& timer);
+
+/*
+ * Called by gbfopen() and gpsbabel::File::open(): the first file opened
+ * in a stage is the one whose position is reported.  pos returns -1 when
+ * it cannot tell.
+ */
+void progress_file(const void* handle, qint64 total, const std::function<qint64()>& pos);
+void progress_file_closed(const void* handle);
+
+#endif // PROGRESS_H_INCLUDED_
@@ -311,14 +311,14 @@ psit_waypoint_r(gbfile* psit_file, Waypoint**)
     psit_getToken(psit_file,psit_current_token,sizeof(psit_current_token), comma);
     rtrim(psit_current_token);
     thisWaypoint->shortname = psit_current_token;
-    thisWaypoint->description = "";
+    thisWaypoint->SetDescription("");
 
     psit_getToken(psit_file,psit_current_token,sizeof(psit_current_token), ltrimEOL);
     rtrim(psit_current_token);
     /* since PsiTrex only deals with Garmins, let's use the "proper" Garmin icon name */
     /* convert the PsiTrex name to the number, which is the PCX one; from there to Garmin desc */
     int garmin_icon_num = psit_find_icon_number_from_desc(psit_current_token);
-    thisWaypoint->icon_descr = gt_find_desc_from_icon_number(garmin_icon_num, PCX);
+    thisWaypoint->SetIconDescr(gt_find_desc_from_icon_number(garmin_icon_num, PCX));
 
     waypt_add(thisWaypoint);
 
@@ -352,9 +352,9 @@ psit_waypoint_w(gbfile* psit_file, const Waypoint* wpt)
   gbfprintf(psit_file, " %-6s, ", ident);
   xfree(ident);
 
-  int icon = gt_find_icon_number_from_desc(wpt->icon_descr, PCX);
+  int icon = gt_find_icon_number_from_desc(wpt->GetIconDescr(), PCX);
 
-  if (get_cache_icon(wpt) && wpt->icon_descr.compare(QLatin1String("Geocache Found")) != 0) {
+  if (get_cache_icon(wpt) && wpt->GetIconDescr().compare(QLatin1String("Geocache Found")) != 0) {
     icon = gt_find_icon_number_from_desc(get_cache_icon(wpt), PCX);
   }
 
@@ -419,14 +419,14 @@ psit_route_r(gbfile* psit_file, route_head** rte)
       psit_getToken(psit_file,psit_current_token,sizeof(psit_current_token), comma);
       rtrim(psit_current_token);
       thisWaypoint->shortname = psit_current_token;
-      thisWaypoint->description = "";
+      thisWaypoint->SetDescription("");
 
       psit_getToken(psit_file,psit_current_token,sizeof(psit_current_token), ltrimEOL);
       rtrim(psit_current_token);
       /* since PsiTrex only deals with Garmins, let's use the "proper" Garmin icon name */
       /* convert the PsiTrex name to the number, which is the PCX one; from there to Garmin desc */
       int garmin_icon_num = psit_find_icon_number_from_desc(psit_current_token);
-      thisWaypoint->icon_descr = gt_find_desc_from_icon_number(garmin_icon_num, PCX);
+      thisWaypoint->SetIconDescr(gt_find_desc_from_icon_number(garmin_icon_num, PCX));
 
       route_add_wpt(rte_head, thisWaypoint);
 
@@ -178,7 +178,7 @@ random_generate_wpt(int i, const QDateTime& time, const Waypoint* prev)
       }
     }
     if RND(3) {
-      wpt->icon_descr = rand_qstr(3, "Icon_%s");
+      wpt->SetIconDescr(rand_qstr(3, "Icon_%s"));
     }
 
     wpt->SetCreationTime(time);
@@ -207,10 +207,10 @@ random_generate_wpt(int i, const QDateTime& time, const Waypoint* prev)
         wpt->longitude = prev->longitude + rand_dbl(0.01);
       }
       if RND(3) {
-        wpt->description = rand_qstr(16, "Des_%s");
+        wpt->SetDescription(rand_qstr(16, "Des_%s"));
       }
       if RND(3) {
-        wpt->notes = rand_qstr(16, "Nts_%s");
+        wpt->SetNotes(rand_qstr(16, "Nts_%s"));
       }
       if RND(3) {
         GMSD_SET(addr, rand_str(8, "Adr_%s"));
@@ -210,7 +210,7 @@ raymarine_read()
     /* try to read optional values */
     str = inifile_readstr(fin, sect, "Notes");
     if (!str.isEmpty()) {
-      wpt->notes = str;
+      wpt->SetNotes(str);
     }
     str = inifile_readstr(fin, sect, "Time");
     if (!str.isEmpty()) {
@@ -223,7 +223,7 @@ raymarine_read()
       if ((symbol < 3) && (symbol >= RAYMARINE_SYMBOL_CT)) {
         symbol = RAYMARINE_STD_SYMBOL;
       }
-      wpt->icon_descr = raymarine_symbols[symbol].name;
+      wpt->SetIconDescr(raymarine_symbols[symbol].name);
     }
   }
 
@@ -329,9 +329,9 @@ qsort_cb(const void* a, const void* b)
 static void
 write_waypoint(gbfile* fout, const Waypoint* wpt, const int waypt_no, const char* location)
 {
-  QString notes = wpt->notes;
+  QString notes = wpt->GetNotes();
   if (notes == nullptr) {
-    notes = wpt->description;
+    notes = wpt->GetDescription();
     if (notes == nullptr) {
       notes = "";
     }
@@ -354,7 +354,7 @@ write_waypoint(gbfile* fout, const Waypoint* wpt, const int waypt_no, const char
             "Locked=0" LINE_FEED
             "Notes=%s" LINE_FEED,
             0.0, 0.0,
-            find_symbol_num(wpt->icon_descr),
+            find_symbol_num(wpt->GetIconDescr()),
             CSTR(notes)
            );
   gbfprintf(fout, "Rel=" LINE_FEED
@@ -19,15 +19,23 @@
 
 #include "defs.h"
 #include "grtcirc.h"
+#include "progress.h"
 #include "session.h"
 #include <cstdio>
 
-queue my_route_head;
-queue my_track_head;
-static int rte_head_ct;
-static int rte_waypts;
-static int trk_head_ct;
-static int trk_waypts;
+thread_local queue my_route_head;
+thread_local queue my_track_head;
+static thread_local int rte_head_ct;
+static thread_local int rte_waypts;
+static thread_local int trk_head_ct;
+static thread_local int trk_waypts;
+/*
+ * track_recompute() results are cached per route_head and tagged with
+ * this generation.  Adding or removing points resets the tag of the
+ * affected route.  As points are modified in place by formats and
+ * filters, main bumps the generation after every reader and filter.
+ */
+static thread_local unsigned int trkdata_generation = 1;
 
 extern void update_common_traits(const Waypoint* wpt);
 
@@ -160,7 +168,9 @@ static void
 any_route_add_wpt(route_head* rte, Waypoint* wpt, int* ct, int synth, const QString& namepart, int number_digits)
 {
   ENQUEUE_TAIL(&rte->waypoint_list, &wpt->Q);
+  progress_point();
   rte->rte_waypt_ct++;	/* waypoints in this route */
+  rte->trkdata_generation = 0;
   if (ct) {
     (*ct)++;
   }
@@ -235,6 +245,7 @@ any_route_del_wpt(route_head* rte, Waypoint* wpt, int* ct)
   wpt->wpt_flags.new_trkseg = 0;
   dequeue(&wpt->Q);
   rte->rte_waypt_ct--;
+  rte->trkdata_generation = 0;
   if (ct) {
     (*ct)--;
   }
@@ -267,6 +278,7 @@ route_reverse(const route_head* rte_hd)
   QUEUE_FOR_EACH(&rh->waypoint_list, elem, tmp) {
     ENQUEUE_HEAD(&rh->waypoint_list, dequeue(elem));
   }
+  rh->trkdata_generation = 0;
 }
 
 static void
@@ -517,11 +529,17 @@ tracks_to_routes()
  * Run over all the trackpoints, computing heading (course), speed, and
  * and so on.
  *
- * If trkdatap is non-null upon entry, a pointer to an allocated collection
- * (hopefully interesting) statistics about the track will be placed there.
+ * Returns a collection of (hopefully interesting) statistics about the
+ * track.  The result is cached in the route_head, so writers can ask for
+ * it as often as they like; the points are only walked (and course,
+ * speed and shortname filled in) again after the track changed.
  */
 computed_trkdata track_recompute(const route_head* trk)
 {
+  if (trk->trkdata_generation == trkdata_generation) {
+    return trk->trkdata;
+  }
+
   Waypoint first;
   Waypoint* prev = &first;
   queue* elem, *tmp;
@@ -531,6 +549,7 @@ computed_trkdata track_recompute(const route_head* trk)
   int pts_cad = 0;
   double tot_cad = 0.0;
   computed_trkdata tdata;
+  gpsbabel::TimeStamp start, end;	/* converted to tdata.start and .end at the end */
 
 //  first.latitude = 0;
 //  first.longitude = 0;
@@ -564,11 +583,11 @@ computed_trkdata track_recompute(const route_head* trk)
     if (!WAYPT_HAS(thisw, speed) && (dist > 1)) {
       // Only recompute speed if the waypoint
       // didn't already have a speed
-      if (thisw->GetCreationTime().isValid() &&
-          prev->GetCreationTime().isValid() &&
-          thisw->GetCreationTime() > prev->GetCreationTime()) {
+      if (thisw->creation_time.isValid() &&
+          prev->creation_time.isValid() &&
+          thisw->creation_time > prev->creation_time) {
         double timed =
-          prev->GetCreationTime().msecsTo(thisw->GetCreationTime()) / 1000.0;
+          prev->creation_time.msecsTo(thisw->creation_time) / 1000.0;
         WAYPT_SET(thisw, speed, dist / timed);
       }
     }
@@ -613,13 +632,13 @@ computed_trkdata track_recompute(const route_head* trk)
       tdata.max_cad = thisw->cadence;
     }
 
-    if (thisw->GetCreationTime().isValid()) {
-      if (!tdata.start.isValid() || (thisw->GetCreationTime() < tdata.start)) {
-        tdata.start = thisw->GetCreationTime();
+    if (thisw->creation_time.isValid()) {
+      if (!start.isValid() || (thisw->creation_time < start)) {
+        start = thisw->creation_time;
       }
 
-      if (!tdata.end.isValid() || (thisw->GetCreationTime() > tdata.end)) {
-        tdata.end = thisw->GetCreationTime();
+      if (!end.isValid() || (thisw->creation_time > end)) {
+        end = thisw->creation_time;
       }
     }
 
@@ -638,9 +657,28 @@ computed_trkdata track_recompute(const route_head* trk)
     tdata.avg_cad = tot_cad / pts_cad;
   }
 
+  if (start.isValid()) {
+    tdata.start = start.toDateTime();
+    tdata.end = end.toDateTime();
+  }
+
+  trk->trkdata = tdata;
+  trk->trkdata_generation = trkdata_generation;
   return tdata;
 }
 
+/*
+ * Forget the statistics cached by track_recompute() for all routes and
+ * tracks.  Needed whenever points may have been modified in place.
+ */
+void track_recompute_invalidate()
+{
+  trkdata_generation++;
+  if (trkdata_generation == 0) {	/* 0 is reserved for "never computed" */
+    trkdata_generation++;
+  }
+}
+
 route_head::route_head() :
   rte_num(0),
   rte_waypt_ct(0),
@@ -648,7 +686,8 @@ route_head::route_head() :
   cet_converted(0),
   // line_color(),
   line_width(-1),
-  session(curr_session())
+  session(curr_session()),
+  trkdata_generation(0)
 {
   QUEUE_INIT(&Q);
   QUEUE_INIT(&waypoint_list);
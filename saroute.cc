@@ -216,7 +216,7 @@ my_read()
         // That we've had no bugreports on this strongly indicates this code
         // is never used... 
         wpt_tmp->shortname = "booger";
-        wpt_tmp->notes = "goober";
+        wpt_tmp->SetNotes("goober");
 #else
         wpt_tmp->shortname = (char*) xmalloc(addrlen+1);
         wpt_tmp->shortname[addrlen]='\0';
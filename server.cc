@@ -0,0 +1,330 @@
+/*
+
+    Conversion server: run many conversions from one process.
+    Copyright (C) 2019 Robert Lipe, gpsbabel.org
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111 USA
+
+*/
+
+#include "defs.h"
+#include "server.h"
+
+#include <QtCore/QByteArray>     // for QByteArray
+#include <QtCore/QFile>          // for QFile::encodeName
+#include <QtCore/QJsonArray>     // for QJsonArray
+#include <QtCore/QJsonDocument>  // for QJsonDocument, QJsonDocument::Compact
+#include <QtCore/QJsonObject>    // for QJsonObject
+#include <QtCore/QJsonParseError>// for QJsonParseError
+#include <QtCore/QJsonValue>     // for QJsonValue
+
+#include <cstdio>                // for FILE, fputs, fputc, fflush, tmpfile
+#include <cstdlib>               // for exit, free
+
+#if !__WIN32__
+#include <cerrno>                // for errno, EINTR
+#include <csignal>               // for signal, SIGCHLD, SIG_IGN, SIG_DFL
+#include <cstring>               // for strerror, memset, strcpy
+#include <fcntl.h>               // for open, O_RDONLY
+#include <sys/socket.h>          // for socket, bind, listen, accept, connect
+#include <sys/stat.h>            // for stat, S_ISSOCK
+#include <sys/un.h>              // for sockaddr_un
+#include <sys/wait.h>            // for waitpid, WIFEXITED, WEXITSTATUS
+#include <unistd.h>              // for fork, dup, dup2, close, unlink
+#endif
+
+#define MYNAME "server"
+
+#if !__WIN32__
+
+static QJsonObject
+server_error(QJsonObject reply, const QString& error)
+{
+  reply["status"] = -1;
+  reply["error"] = error;
+  return reply;
+}
+
+/* Read back and close one of the temporary files a job wrote to. */
+static QString
+server_slurp(FILE* f)
+{
+  QByteArray data;
+  char buf[4096];
+  size_t n;
+
+  rewind(f);
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    data.append(buf, n);
+  }
+  fclose(f);
+  return QString::fromUtf8(data);
+}
+
+/* The -F arguments of a job, so the caller knows what was written. */
+static QJsonArray
+server_outputs(const QStringList& args)
+{
+  QJsonArray outputs;
+
+  for (int i = 1; i < args.size(); i++) {
+    const QString& arg = args.at(i);
+    if (arg == "-F") {
+      if (i + 1 < args.size()) {
+        outputs.append(args.at(++i));
+      }
+    } else if (arg.startsWith("-F")) {
+      outputs.append(arg.mid(2));
+    }
+  }
+  return outputs;
+}
+
+static QJsonObject
+server_do_job(const QString& prog_name, const QByteArray& request, server_job_t job)
+{
+  QJsonObject reply;
+  QJsonParseError perr;
+  QJsonDocument doc = QJsonDocument::fromJson(request, &perr);
+
+  if (perr.error != QJsonParseError::NoError) {
+    return server_error(reply, perr.errorString());
+  }
+  if (!doc.isObject()) {
+    return server_error(reply, "request is not a JSON object");
+  }
+  QJsonObject req = doc.object();
+  if (req.contains("id")) {
+    reply["id"] = req.value("id");
+  }
+
+  QJsonValue jargs = req.value("args");
+  if (!jargs.isArray()) {
+    return server_error(reply, "request has no \"args\" array");
+  }
+  QStringList args(prog_name);
+  for (const auto& arg : jargs.toArray()) {
+    if (!arg.isString()) {
+      return server_error(reply, "\"args\" must only hold strings");
+    }
+    args.append(arg.toString());
+  }
+
+  FILE* out = tmpfile();
+  FILE* err = tmpfile();
+  if (!out || !err) {
+    if (out) {
+      fclose(out);
+    }
+    if (err) {
+      fclose(err);
+    }
+    return server_error(reply, "could not create temporary files");
+  }
+
+  /* Don't let the child inherit, and later repeat, our pending output. */
+  fflush(nullptr);
+
+  pid_t pid = fork();
+  if (pid < 0) {
+    fclose(out);
+    fclose(err);
+    return server_error(reply, QString("fork failed: %1").arg(strerror(errno)));
+  }
+  if (pid == 0) {
+    int devnull = open("/dev/null", O_RDONLY);
+    if (devnull >= 0) {
+      dup2(devnull, STDIN_FILENO);
+      close(devnull);
+    }
+    dup2(fileno(out), STDOUT_FILENO);
+    dup2(fileno(err), STDERR_FILENO);
+    exit(job(args));
+  }
+
+  int wstatus = 0;
+  while ((waitpid(pid, &wstatus, 0) < 0) && (errno == EINTR)) {
+    /* retry */
+  }
+  if (WIFEXITED(wstatus)) {
+    reply["status"] = WEXITSTATUS(wstatus);
+  } else if (WIFSIGNALED(wstatus)) {
+    reply["status"] = -WTERMSIG(wstatus);
+  } else {
+    reply["status"] = -1;
+  }
+  reply["outputs"] = server_outputs(args);
+  reply["stdout"] = server_slurp(out);
+  reply["stderr"] = server_slurp(err);
+  return reply;
+}
+
+static void
+server_serve(const QString& prog_name, FILE* in, FILE* out, server_job_t job)
+{
+  char* line = nullptr;
+  size_t len = 0;
+
+  while (getline(&line, &len, in) >= 0) {
+    QByteArray request = QByteArray(line).trimmed();
+    if (request.isEmpty()) {
+      continue;
+    }
+    QJsonObject reply = server_do_job(prog_name, request, job);
+    fputs(QJsonDocument(reply).toJson(QJsonDocument::Compact).constData(), out);
+    fputc('\n', out);
+    fflush(out);
+  }
+  free(line);
+}
+
+static void
+server_address(const QString& socket_path, sockaddr_un* addr)
+{
+  QByteArray path = QFile::encodeName(socket_path);
+
+  memset(addr, 0, sizeof(*addr));
+  addr->sun_family = AF_UNIX;
+  if (path.isEmpty() || (path.size() >= (int) sizeof(addr->sun_path))) {
+    fatal(MYNAME ": Invalid socket path '%s'.\n", qPrintable(socket_path));
+  }
+  strcpy(addr->sun_path, path.constData());
+}
+
+int
+server_run(const QString& prog_name, const QString& socket_path, server_job_t job)
+{
+  if (socket_path.isEmpty()) {
+    server_serve(prog_name, stdin, stdout, job);
+    return 0;
+  }
+
+  sockaddr_un addr;
+  server_address(socket_path, &addr);
+
+  /* Clean up after a server that wasn't shut down, but never remove
+   * anything that isn't a socket. */
+  struct stat st;
+  if ((stat(addr.sun_path, &st) == 0) && S_ISSOCK(st.st_mode)) {
+    unlink(addr.sun_path);
+  }
+
+  int lfd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (lfd < 0) {
+    fatal(MYNAME ": Cannot create socket: %s\n", strerror(errno));
+  }
+  if (bind(lfd, (sockaddr*) &addr, sizeof(addr)) < 0) {
+    fatal(MYNAME ": Cannot bind to '%s': %s\n", addr.sun_path, strerror(errno));
+  }
+  if (listen(lfd, 16) < 0) {
+    fatal(MYNAME ": Cannot listen on '%s': %s\n", addr.sun_path, strerror(errno));
+  }
+
+  /* Each connection is served by its own child; let the system reap them. */
+  signal(SIGCHLD, SIG_IGN);
+
+  for (;;) {
+    int cfd = accept(lfd, nullptr, nullptr);
+    if (cfd < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fatal(MYNAME ": accept failed: %s\n", strerror(errno));
+    }
+
+    fflush(nullptr);
+    pid_t pid = fork();
+    if (pid < 0) {
+      warning(MYNAME ": fork failed: %s\n", strerror(errno));
+    } else if (pid == 0) {
+      close(lfd);
+      /* We wait for our jobs ourselves. */
+      signal(SIGCHLD, SIG_DFL);
+      FILE* in = fdopen(cfd, "r");
+      FILE* out = fdopen(dup(cfd), "w");
+      if (in && out) {
+        server_serve(prog_name, in, out, job);
+      }
+      if (in) {
+        fclose(in);
+      }
+      if (out) {
+        fclose(out);
+      }
+      _exit(0);
+    }
+    close(cfd);
+  }
+}
+
+int
+server_client(const QString& socket_path, const QStringList& args)
+{
+  sockaddr_un addr;
+  server_address(socket_path, &addr);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    fatal(MYNAME ": Cannot create socket: %s\n", strerror(errno));
+  }
+  if (::connect(fd, (sockaddr*) &addr, sizeof(addr)) < 0) {
+    fatal(MYNAME ": Cannot connect to '%s': %s\n", addr.sun_path, strerror(errno));
+  }
+
+  QJsonObject request;
+  request["args"] = QJsonArray::fromStringList(args);
+  QByteArray data = QJsonDocument(request).toJson(QJsonDocument::Compact) + '\n';
+
+  FILE* in = fdopen(fd, "r");
+  FILE* out = fdopen(dup(fd), "w");
+  if (!in || !out) {
+    fatal(MYNAME ": Cannot open connection to '%s'.\n", addr.sun_path);
+  }
+  fputs(data.constData(), out);
+  fclose(out);
+
+  char* line = nullptr;
+  size_t len = 0;
+  if (getline(&line, &len, in) < 0) {
+    fatal(MYNAME ": No reply from '%s'.\n", addr.sun_path);
+  }
+  QJsonObject reply = QJsonDocument::fromJson(QByteArray(line)).object();
+  free(line);
+  fclose(in);
+
+  fputs(CSTR(reply.value("stdout").toString()), stdout);
+  fputs(CSTR(reply.value("stderr").toString()), stderr);
+  if (reply.contains("error")) {
+    warning(MYNAME ": %s\n", qPrintable(reply.value("error").toString()));
+  }
+  int status = reply.value("status").toInt(-1);
+  return (status < 0) ? 1 : status;
+}
+
+#else
+
+int
+server_run(const QString&, const QString&, server_job_t)
+{
+  fatal(MYNAME ": Server mode is not supported on this platform.\n");
+}
+
+int
+server_client(const QString&, const QStringList&)
+{
+  fatal(MYNAME ": Server mode is not supported on this platform.\n");
+}
+
+#endif
@@ -0,0 +1,55 @@
+/*
+
+    Conversion server: run many conversions from one process.
+    Copyright (C) 2019 Robert Lipe, gpsbabel.org
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111 USA
+
+*/
+
+#ifndef SERVER_H_INCLUDED_
+#define SERVER_H_INCLUDED_
+
+#include <QtCore/QString>      // for QString
+#include <QtCore/QStringList>  // for QStringList
+
+/*
+ * A job is an ordinary command line, including the program name in
+ * args[0].  It returns the exit status of the conversion.
+ */
+typedef int (*server_job_t)(const QStringList& args);
+
+/*
+ * Serve newline delimited JSON job requests of the form
+ *   {"id": <anything>, "args": ["-i", "gpx", "-f", "in.gpx", ...]}
+ * and answer each with one line
+ *   {"id": <same>, "status": 0, "outputs": [...], "stdout": "...", "stderr": "..."}
+ * Requests are read from stdin and answered on stdout if socket_path is
+ * empty, otherwise from each connection to a Unix domain socket bound
+ * to socket_path.
+ *
+ * Each job runs in a child forked from the fully initialized server, so
+ * it starts from the same pristine global state a fresh process would
+ * have and a fatal() in one job can't take the server down.
+ */
+int server_run(const QString& prog_name, const QString& socket_path, server_job_t job);
+
+/*
+ * Send a single job to the server listening on socket_path, copy its
+ * stdout and stderr to ours and return its status.
+ */
+int server_client(const QString& socket_path, const QStringList& args);
+
+#endif
@@ -24,7 +24,7 @@
 
 #include <QtCore/QList>  // for QList
 
-static QList<session_t> session_list;
+static thread_local QList<session_t> session_list;
 
 void
 session_init()
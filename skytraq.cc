@@ -25,10 +25,13 @@
 
 #include "defs.h"
 #include "gbser.h"
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
 #include <QtCore/QThread>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 #define MYNAME "skytraq"
 
@@ -57,6 +60,7 @@
 
 static void* serial_handle = nullptr;		/* IO file descriptor */
 static int skytraq_baud = 0;		/* detected baud rate */
+static uint8_t skytraq_firmware[12];	/* kernel, ODM and revision versions reported by the device */
 static gbfile* file_handle = nullptr;		/* file descriptor (used by skytraq-bin format) */
 
 static char* opt_erase = nullptr;		/* erase after read? (0/1) */
@@ -66,6 +70,7 @@ static char* opt_read_at_once = nullptr;	/* number of sectors to read at once (V
 static char* opt_first_sector = nullptr;	/* first sector to be read from the device (default: 0) */
 static char* opt_last_sector = nullptr;	/* last sector to be read from the device (default: smart read everything) */
 static char* opt_dump_file = nullptr;		/* dump raw data to this file (optional) */
+static char* opt_cache_file = nullptr;		/* keep raw data in this file between runs (optional) */
 static char* opt_no_output = nullptr;		/* disable output? (0/1) */
 static char* opt_set_location = nullptr;	/* set if the "targetlocation" options was used */
 static char* opt_configure_logging = nullptr;
@@ -110,6 +115,10 @@ arglist_t skytraq_args[] = {
     "dump-file", &opt_dump_file, "Dump raw data to this file",
     nullptr, ARGTYPE_OUTFILE, ARG_NOMINMAX, nullptr
   },
+  {
+    "cache", &opt_cache_file, "Keep raw data in this file and only read new sectors",
+    nullptr, ARGTYPE_FILE, ARG_NOMINMAX, nullptr
+  },
   {
     "no-output", &opt_no_output, "Disable output (useful with erase)",
     "0", ARGTYPE_BOOL, ARG_NOMINMAX, nullptr
@@ -1019,11 +1028,13 @@ skytraq_read_single_sector(unsigned int sector, uint8_t* buf)
   return res_OK;
 }
 
+/* Ask the device for |sector_count| sectors beginning at |first_sector|.
+ * The data must then be fetched with skytraq_receive_multiple_sectors().
+ */
 static int
-skytraq_read_multiple_sectors(int first_sector, unsigned int sector_count, uint8_t* buf)
+skytraq_request_multiple_sectors(int first_sector, unsigned int sector_count)
 {
   uint8_t MSG_LOG_READ_MULTI_SECTORS[5] = { 0x1D };
-  unsigned int i;
 
   if (first_sector < 0  ||  first_sector > 0xFFFF) {
     fatal(MYNAME ": Invalid sector number (%i)\n", first_sector);
@@ -1036,16 +1047,29 @@ skytraq_read_multiple_sectors(int first_sector, unsigned int sector_count, uint8
 
   db(2, "Reading %i sectors beginning from #%i...\n", sector_count, first_sector);
 
-  unsigned int read_result = skytraq_wr_msg_verify((uint8_t*)&MSG_LOG_READ_MULTI_SECTORS, sizeof(MSG_LOG_READ_MULTI_SECTORS));
-  if (read_result != res_OK) {
-    return read_result;
-  }
+  return skytraq_wr_msg_verify((uint8_t*)&MSG_LOG_READ_MULTI_SECTORS, sizeof(MSG_LOG_READ_MULTI_SECTORS));
+}
+
+/* Receive the sectors asked for by skytraq_request_multiple_sectors().
+ * The checksum covers the whole batch, so a batch that broke off or came
+ * in damaged is dropped as a whole and has to be read again.
+ */
+static int
+skytraq_receive_multiple_sectors(int first_sector, unsigned int sector_count, uint8_t* buf)
+{
+  unsigned int i;
 
   for (i = 0; i < sector_count; i++) {
     db(2, "Receiving data of sector #%i...\n", first_sector+i);
-    rd_buf(buf+i*SECTOR_SIZE, SECTOR_SIZE);
+    if (rd_buf(buf+i*SECTOR_SIZE, SECTOR_SIZE) != res_OK) {
+      db(1, MYNAME ": Batch broke off in sector #%i\n", first_sector+i);
+      return res_ERROR;
+    }
+  }
+  if (rd_buf(buf+SECTOR_SIZE*sector_count, sizeof(SECTOR_READ_END)+6) != res_OK) {
+    db(1, MYNAME ": Batch broke off after the last sector\n");
+    return res_ERROR;
   }
-  rd_buf(buf+SECTOR_SIZE*sector_count, sizeof(SECTOR_READ_END)+6);
 
   uint8_t* buf_end_tag = buf + SECTOR_SIZE*sector_count;
   for (i = 0; i < sizeof(SECTOR_READ_END); i++) {
@@ -1067,6 +1091,174 @@ skytraq_read_multiple_sectors(int first_sector, unsigned int sector_count, uint8
   return res_OK;
 }
 
+static int
+skytraq_read_multiple_sectors(int first_sector, unsigned int sector_count, uint8_t* buf)
+{
+  int rc = skytraq_request_multiple_sectors(first_sector, sector_count);
+  if (rc != res_OK) {
+    return rc;
+  }
+  return skytraq_receive_multiple_sectors(first_sector, sector_count, buf);
+}
+
+/* Batch size for multi sector reads.  The size is doubled while reads
+ * succeed and halved on a failure.  |error_rate| is a moving average of
+ * recent failures; while it is high the size only grows one sector at
+ * a time, so a noisy link settles on a size that mostly gets through.
+ */
+struct read_batch {
+  int size;
+  int max;
+  double error_rate;
+};
+
+static void
+read_batch_succeeded(read_batch* rb)
+{
+  rb->error_rate *= 0.75;
+  if (rb->error_rate < 0.05) {
+    rb->size = MIN(rb->size*2, rb->max);
+  } else {
+    rb->size = MIN(rb->size+1, rb->max);
+  }
+}
+
+static void
+read_batch_failed(read_batch* rb)
+{
+  rb->error_rate = rb->error_rate*0.75 + 0.25;
+  rb->size = MAX(rb->size/2, 1);
+}
+
+/* The cache file starts with a header that ties it to the logger and to
+ * the state of its log, followed by a CRC32 for each sector and then the
+ * sectors.  SkyTraq loggers have no serial number, so the firmware
+ * versions and the size of the log stand in for the identity.
+ *
+ *   0  magic "STQCACHE"
+ *   8  kernel, ODM and revision versions (12 bytes)
+ *  20  total sectors (LE16)
+ *  22  log write pointer (LE32)
+ *  26  number of sectors (LE32)
+ *  30  CRC32 of each sector (LE32 each), then the sectors
+ */
+static const char CACHE_MAGIC[8] = { 'S','T','Q','C','A','C','H','E' };
+#define CACHE_HEADER_SIZE 30
+
+/* Load the sectors of an earlier download from the cache file.  A cache
+ * of another logger is ignored, and only sectors that still match their
+ * CRC are used.  If the write pointer hasn't moved since, the log is the
+ * same and all sectors are reused.  Otherwise the log has grown, so every
+ * sector before the last one holding data is complete and can be reused.
+ * Before trusting those we compare the last reused sector with the device,
+ * which catches a log that was erased and written again.  Returns the
+ * number of sectors that can be reused.
+ */
+static int
+skytraq_load_cache(QByteArray* cache, uint8_t* buffer, uint32_t log_wr_ptr, uint16_t sectors_total)
+{
+  QFile file(opt_cache_file);
+  if (!file.open(QIODevice::ReadOnly)) {
+    db(1, MYNAME ": No cache file '%s' yet\n", opt_cache_file);
+    return 0;
+  }
+  QByteArray data = file.readAll();
+  file.close();
+
+  const uint8_t* header = (const uint8_t*) data.constData();
+  if (data.size() < CACHE_HEADER_SIZE  ||  memcmp(header, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0) {
+    db(1, MYNAME ": '%s' isn't a cache file, reading everything\n", opt_cache_file);
+    return 0;
+  }
+  if (memcmp(header+8, skytraq_firmware, sizeof(skytraq_firmware)) != 0  ||
+      le_readu16(header+20) != sectors_total) {
+    db(1, MYNAME ": Cache is from another logger, reading everything\n");
+    return 0;
+  }
+  uint32_t cached_wr_ptr = le_readu32(header+22);
+  int sectors = le_readu32(header+26);
+  if (sectors < 0  ||  sectors > sectors_total  ||
+      data.size() != CACHE_HEADER_SIZE + sectors*(4+SECTOR_SIZE)) {
+    db(1, MYNAME ": Cache file is truncated, reading everything\n");
+    return 0;
+  }
+
+  const uint8_t* crcs = header + CACHE_HEADER_SIZE;
+  const char* sector_data = data.constData() + CACHE_HEADER_SIZE + 4*sectors;
+  bool damaged = false;
+  for (int s = 0; s < sectors; s++) {
+    if (get_crc32(sector_data + s*SECTOR_SIZE, SECTOR_SIZE) != le_readu32(crcs + 4*s)) {
+      db(1, MYNAME ": Sector #%i in cache is damaged\n", s);
+      sectors = s;	/* the sectors before it are still good */
+      damaged = true;
+      break;
+    }
+  }
+  *cache = QByteArray(sector_data, sectors*SECTOR_SIZE);
+
+  if (!damaged  &&  log_wr_ptr == cached_wr_ptr) {
+    db(1, MYNAME ": Log hasn't changed, reusing all %i sectors from cache\n", sectors);
+    return sectors;
+  }
+  if (log_wr_ptr < cached_wr_ptr) {
+    db(1, MYNAME ": Log was erased since, reading everything\n");
+    cache->clear();
+    return 0;
+  }
+
+  while (sectors > 0 && (uint8_t) cache->at((sectors-1)*SECTOR_SIZE) == 0xFF) {
+    sectors--;	/* empty sector */
+  }
+  int reuse = sectors - 1;	/* the last sector with data may have grown */
+  if (reuse <= 0) {
+    cache->clear();
+    return 0;
+  }
+
+  int rc;
+  if (atoi(opt_read_at_once) != 0) {
+    rc = skytraq_read_multiple_sectors(reuse-1, 1, buffer);
+  } else if (reuse-1 <= 0xFF) {
+    rc = skytraq_read_single_sector(reuse-1, buffer);
+  } else {
+    rc = res_ERROR;
+  }
+  if (rc != res_OK  ||  memcmp(buffer, cache->constData() + (reuse-1)*SECTOR_SIZE, SECTOR_SIZE) != 0) {
+    db(1, MYNAME ": Cache doesn't match the device, reading everything\n");
+    cache->clear();
+    return 0;
+  }
+
+  db(1, MYNAME ": Reusing %i sectors from cache\n", reuse);
+  cache->truncate(reuse*SECTOR_SIZE);
+  return reuse;
+}
+
+/* Write the sectors of this download to the cache file, see above. */
+static void
+skytraq_save_cache(const QByteArray& cache, uint32_t log_wr_ptr, uint16_t sectors_total)
+{
+  int sectors = cache.size() / SECTOR_SIZE;
+  QByteArray header(CACHE_HEADER_SIZE + 4*sectors, 0);
+  uint8_t* p = (uint8_t*) header.data();
+
+  memcpy(p, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+  memcpy(p+8, skytraq_firmware, sizeof(skytraq_firmware));
+  le_write16(p+20, sectors_total);
+  le_write32(p+22, log_wr_ptr);
+  le_write32(p+26, sectors);
+  for (int s = 0; s < sectors; s++) {
+    le_write32(p + CACHE_HEADER_SIZE + 4*s, get_crc32(cache.constData() + s*SECTOR_SIZE, SECTOR_SIZE));
+  }
+
+  QFile file(opt_cache_file);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)  ||
+      file.write(header) != header.size()  ||
+      file.write(cache) != cache.size()) {
+    warning(MYNAME ": Can't write cache file '%s'\n", opt_cache_file);
+  }
+}
+
 static void
 skytraq_read_tracks()
 {
@@ -1074,8 +1266,12 @@ skytraq_read_tracks()
   uint32_t log_wr_ptr;
   uint16_t sectors_free, sectors_total, /*sectors_used_a, sectors_used_b,*/ sectors_used;
   int t, rc, got_sectors, total_sectors_read = 0;
-  int read_at_once = MAX(atoi(opt_read_at_once), 1);
+  read_batch batch = { MAX(atoi(opt_read_at_once), 1), atoi(opt_read_at_once), 0.0 };
+  int pending_sectors = 0;	/* sectors requested but not yet received */
+  bool use_cache = false;
+  QByteArray cache;
   int opt_first_sector_val = atoi(opt_first_sector);
+  int first_sector = opt_first_sector_val;
   int opt_last_sector_val = atoi(opt_last_sector);
   int multi_read_supported = 1;
   gbfile* dumpfile = nullptr;
@@ -1117,35 +1313,68 @@ skytraq_read_tracks()
     }
   }
 
-  uint8_t* buffer = (uint8_t*) xmalloc(SECTOR_SIZE*read_at_once+sizeof(SECTOR_READ_END)+6);
+  uint8_t* buffer = (uint8_t*) xmalloc(SECTOR_SIZE*batch.size+sizeof(SECTOR_READ_END)+6);
   // m.ad/090930: removed code that tried reducing read_at_once if necessary since doesn't work with xmalloc
 
   if (opt_dump_file) {
     dumpfile = gbfopen(opt_dump_file, "w", MYNAME);
   }
 
+  if (opt_cache_file) {
+    if (opt_first_sector_val != 0  ||  opt_last_sector_val >= 0) {
+      db(1, MYNAME ": Not using the cache with first-sector or last-sector\n");
+    } else {
+      use_cache = true;
+      first_sector = skytraq_load_cache(&cache, buffer, log_wr_ptr, sectors_total);
+      total_sectors_read = first_sector;
+      if (dumpfile) {
+        gbfwrite(cache.constData(), SECTOR_SIZE, first_sector, dumpfile);
+      }
+      if (*opt_no_output == '0') {
+        for (int s = 0; s < first_sector; s++) {
+          if (process_data_sector(&st, (const uint8_t*) cache.constData() + s*SECTOR_SIZE, SECTOR_SIZE) == 0) {
+            break;	/* empty sector, as in the loop below */
+          }
+        }
+      }
+    }
+  }
+
   db(1, MYNAME ": Reading log data from device...\n");
   db(1, MYNAME ": start=%d used=%d\n", opt_first_sector_val, sectors_used);
   db(1, MYNAME ": opt_last_sector_val=%d\n", opt_last_sector_val);
-  for (int i = opt_first_sector_val; i < sectors_used; i += got_sectors) {
-    for (t = 0, got_sectors = 0; (t < SECTOR_RETRIES) && (got_sectors <= 0); t++) {
+  for (int i = first_sector; i < sectors_used; i += got_sectors) {
+    got_sectors = 0;
+    if (pending_sectors > 0) {
+      /* Already requested while the previous batch was decoded. */
+      if (skytraq_receive_multiple_sectors(i, pending_sectors, buffer) == res_OK) {
+        got_sectors = pending_sectors;
+        read_batch_succeeded(&batch);
+      } else {
+        /* Read again from its first sector, with a smaller batch. */
+        read_batch_failed(&batch);
+        rd_drain();
+      }
+      pending_sectors = 0;
+    }
+    for (t = 0; (t < SECTOR_RETRIES) && (got_sectors <= 0); t++) {
       if (atoi(opt_read_at_once) == 0  ||  multi_read_supported == 0) {
         rc = skytraq_read_single_sector(i, buffer);
         if (rc == res_OK) {
           got_sectors = 1;
         }
       } else {
-        /* Try to read read_at_once sectors at once.
+        /* Try to read batch.size sectors at once.
          * If tere aren't any so many interesting ones, read the remainder (sectors_used-i).
          * And read at least 1 sector.
          */
-        read_at_once = MAX(MIN(read_at_once, sectors_used-i), 1);
+        int read_at_once = MAX(MIN(batch.size, sectors_used-i), 1);
 
         rc = skytraq_read_multiple_sectors(i, read_at_once, buffer);
         switch (rc) {
         case res_OK:
           got_sectors = read_at_once;
-          read_at_once = MIN(read_at_once*2, atoi(opt_read_at_once));
+          read_batch_succeeded(&batch);
           break;
 
         case res_NACK:
@@ -1156,7 +1385,8 @@ skytraq_read_tracks()
 
         default:
           /* On failure, try with less sectors */
-          read_at_once = MAX(read_at_once/2, 1);
+          read_batch_failed(&batch);
+          rd_drain();
         }
       }
     }
@@ -1166,6 +1396,26 @@ skytraq_read_tracks()
 
     total_sectors_read += got_sectors;
 
+    if (use_cache) {
+      /* Both ways of reading check the checksum, so these are good. */
+      cache.append((const char*) buffer, SECTOR_SIZE*got_sectors);
+    }
+
+    /* Request the next batch before decoding this one, so the device
+     * sends it while we are busy.  A failed request is simply retried
+     * the usual way on the next pass.
+     */
+    int next = i + got_sectors;
+    if (atoi(opt_read_at_once) != 0  &&  multi_read_supported  &&  next < sectors_used) {
+      int read_at_once = MAX(MIN(batch.size, sectors_used-next), 1);
+      rc = skytraq_request_multiple_sectors(next, read_at_once);
+      if (rc == res_OK) {
+        pending_sectors = read_at_once;
+      } else if (rc == res_NACK) {
+        multi_read_supported = 0;
+      }
+    }
+
     if (dumpfile) {
       gbfwrite(buffer, SECTOR_SIZE, got_sectors, dumpfile);
     }
@@ -1189,9 +1439,17 @@ skytraq_read_tracks()
       }
     }
   }
+  if (pending_sectors > 0) {
+    /* Drain the batch we no longer need before talking to the device again. */
+    skytraq_receive_multiple_sectors(sectors_used, pending_sectors, buffer);
+  }
   free(buffer);
   db(1, MYNAME ": Got %i trackpoints from %i sectors.\n", st.tpn, total_sectors_read);
 
+  if (use_cache) {
+    skytraq_save_cache(cache, log_wr_ptr, sectors_total);
+  }
+
   if (dumpfile) {
     gbfclose(dumpfile);
   }
@@ -1264,6 +1522,9 @@ skytraq_probe()
          MSG_SOFTWARE_VERSION.odm_ver[3],
          MSG_SOFTWARE_VERSION.revision[1], MSG_SOFTWARE_VERSION.revision[2],
          MSG_SOFTWARE_VERSION.revision[3]);
+      memcpy(skytraq_firmware, MSG_SOFTWARE_VERSION.kernel_ver, 4);
+      memcpy(skytraq_firmware+4, MSG_SOFTWARE_VERSION.odm_ver, 4);
+      memcpy(skytraq_firmware+8, MSG_SOFTWARE_VERSION.revision, 4);
 
       return baud_rates[i];
     }
@@ -1352,13 +1613,16 @@ skytraq_read()
     skytraq_set_baud(dlbaud);
   }
 
-  // read device unless no-output=1 and dump-file=0 (i.e. no data needed at all)
-  if (*opt_no_output == '0'  ||  opt_dump_file != nullptr) {
+  // read device unless no-output=1, dump-file=0 and cache=0 (i.e. no data needed at all)
+  if (*opt_no_output == '0'  ||  opt_dump_file != nullptr  ||  opt_cache_file != nullptr) {
     skytraq_read_tracks();
   }
 
   if (*opt_erase == '1') {
     skytraq_erase();
+    if (opt_cache_file) {
+      QFile::remove(opt_cache_file);
+    }
   }
 
   if (dlbaud != 0  &&  dlbaud != skytraq_baud) {
@@ -1558,7 +1822,7 @@ static void miniHomer_get_poi()
 
       Waypoint* wpt = new Waypoint;
       wpt->shortname      = QString().sprintf("POI_%s", poinames[poi]);
-      wpt->description    = QString().sprintf("miniHomer points to this coordinates if the %s symbol is on", poinames[poi]);
+      wpt->SetDescription(QString().sprintf("miniHomer points to this coordinates if the %s symbol is on", poinames[poi]));
       wpt->latitude       = lat;
       wpt->longitude      = lng;
       wpt->altitude       = alt;
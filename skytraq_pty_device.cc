@@ -0,0 +1,319 @@
+/*
+    A scripted SkyTraq data logger on a pseudo terminal.
+
+    Copyright (C) 2019 Robert Lipe, gpsbabel.org
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111 USA
+
+ */
+
+/*
+ * Plays a SkyTraq logger holding the sectors of |flash| on the master side
+ * of a pty and runs |command| with every "PTY" argument replaced by the
+ * name of the slave side.
+ *
+ * The |break_reply|th multi sector read (counted from 1, 0 for none) stops
+ * in the middle of the sector after |break_after| sectors, as if the
+ * device had been interrupted.  Nothing of that batch is checksummed, so
+ * the read that follows has to ask for its first sector again.  A negative
+ * |break_reply| means that the host must not read any sectors at all.
+ *
+ * usage: skytraq_pty_device flash break_reply break_after command [arg...]
+ */
+
+#include <cerrno>          // for errno, EINTR
+#include <cstdio>          // for fprintf, stderr, FILE, fopen, fread, fclose
+#include <cstdlib>         // for atoi, exit, posix_openpt, grantpt, unlockpt, ptsname
+#include <cstring>         // for strcmp, strerror
+#include <fcntl.h>         // for open, O_RDWR, O_NOCTTY
+#include <string>          // for string
+#include <sys/select.h>    // for select, fd_set, FD_SET, FD_ZERO, FD_ISSET
+#include <sys/wait.h>      // for waitpid, WNOHANG, WIFEXITED, WEXITSTATUS
+#include <unistd.h>        // for read, write, close, fork, execvp, _exit
+#include <vector>          // for vector
+
+#define SECTOR_SIZE 4096
+#define SECTORS_TOTAL 256
+
+static const unsigned char SECTOR_READ_END[13] = { 'E','N','D', 0, 'C','H','E','C','K','S','U','M','=' };
+
+static int master = -1;
+static std::string flash;
+static int break_reply;
+static int break_after;
+static int multi_replies;
+static int resume_expected = -1;
+
+static void
+fail(const char* what)
+{
+  fprintf(stderr, "skytraq_pty_device: %s\n", what);
+  exit(1);
+}
+
+static void
+device_send(const void* buf, size_t len)
+{
+  const char* p = (const char*) buf;
+  while (len > 0) {
+    ssize_t rc = write(master, p, len);
+    if (rc < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fail(strerror(errno));
+    }
+    p += rc;
+    len -= rc;
+  }
+}
+
+static unsigned char
+checksum(const std::string& s)
+{
+  unsigned char cs = 0;
+  for (char c : s) {
+    cs ^= (unsigned char) c;
+  }
+  return cs;
+}
+
+static void
+send_msg(const std::string& payload)
+{
+  std::string msg("\xA0\xA1", 2);
+  msg += (char)(payload.size() >> 8);
+  msg += (char)(payload.size() & 0xFF);
+  msg += payload;
+  msg += (char) checksum(payload);
+  msg += "\r\n";
+  device_send(msg.data(), msg.size());
+}
+
+static std::string
+le(unsigned int value, int len)
+{
+  std::string s;
+  for (int i = 0; i < len; i++) {
+    s += (char)((value >> (8*i)) & 0xFF);
+  }
+  return s;
+}
+
+static std::string
+sector(int n)
+{
+  std::string s(SECTOR_SIZE, '\xFF');
+  if ((size_t) n*SECTOR_SIZE < flash.size()) {
+    s.replace(0, SECTOR_SIZE, flash, n*SECTOR_SIZE, SECTOR_SIZE);
+  }
+  return s;
+}
+
+/* 0x1D: the sectors, the end tag, the checksum of all sectors and a few
+ * more bytes that the host skips.
+ */
+static void
+read_multiple_sectors(int first, int count)
+{
+  if (break_reply < 0) {
+    fail("the host read sectors it should have taken from its cache");
+  }
+  if (resume_expected >= 0) {
+    if (first != resume_expected) {
+      fprintf(stderr, "skytraq_pty_device: read went on at sector %d, expected %d\n",
+              first, resume_expected);
+      exit(1);
+    }
+    resume_expected = -1;
+  }
+
+  std::string data;
+  for (int i = 0; i < count; i++) {
+    data += sector(first + i);
+  }
+
+  if (++multi_replies == break_reply  &&  break_after < count) {
+    /* Half of the first missing sector, then nothing. */
+    device_send(data.data(), break_after*SECTOR_SIZE + SECTOR_SIZE/2);
+    resume_expected = first;
+    return;
+  }
+
+  unsigned char cs = checksum(data);
+  data.append((const char*) SECTOR_READ_END, sizeof(SECTOR_READ_END));
+  data += (char) cs;
+  data.append(5, '\0');
+  device_send(data.data(), data.size());
+}
+
+static void
+handle_msg(const std::string& payload)
+{
+  unsigned char id = payload[0];
+  const unsigned char* p = (const unsigned char*) payload.data();
+
+  std::string ack("\x83", 1);
+  ack += (char) id;
+
+  switch (id) {
+  case 0x01:	/* system restart */
+  case 0x05:	/* configure serial port */
+    send_msg(ack);
+    break;
+
+  case 0x02: {	/* query software version */
+    send_msg(ack);
+    std::string version("\x80\x01", 2);
+    version += std::string("\0\1\0\0", 4) + std::string("\0\1\0\0", 4) + std::string("\0\x13\x01\x01", 4);
+    send_msg(version);
+    break;
+  }
+
+  case 0x17: {	/* log status */
+    send_msg(ack);
+    int used = (flash.size() + SECTOR_SIZE - 1) / SECTOR_SIZE;
+    std::string status("\x94", 1);
+    status += le(flash.size(), 4);
+    /* The host reads one sector more than total - free. */
+    status += le(SECTORS_TOTAL - used + 1, 2);
+    status += le(SECTORS_TOTAL, 2);
+    status += le(3600, 4) + le(5, 4) + le(1000, 4) + le(0, 4) + le(100, 4) + le(0, 4);
+    status += std::string("\1\0", 2);
+    send_msg(status);
+    break;
+  }
+
+  case 0x1D:	/* read multiple sectors */
+    if (payload.size() < 5) {
+      fail("short multi sector read request");
+    }
+    send_msg(ack);
+    read_multiple_sectors((p[1] << 8) | p[2], (p[3] << 8) | p[4]);
+    break;
+
+  default: {
+    std::string nack("\x84", 1);
+    nack += (char) id;
+    send_msg(nack);
+  }
+  }
+}
+
+/* Pick complete messages out of what the host sent so far. */
+static void
+handle_input(std::string& in)
+{
+  for (;;) {
+    size_t start = in.find("\xA0\xA1");
+    if (start == std::string::npos) {
+      in.clear();
+      return;
+    }
+    in.erase(0, start);
+    if (in.size() < 4) {
+      return;
+    }
+    size_t len = ((unsigned char) in[2] << 8) | (unsigned char) in[3];
+    if (in.size() < 4 + len + 3) {
+      return;
+    }
+    std::string payload = in.substr(4, len);
+    if ((unsigned char) in[4 + len] != checksum(payload)  ||  len == 0) {
+      fail("bad message from host");
+    }
+    in.erase(0, 4 + len + 3);
+    handle_msg(payload);
+  }
+}
+
+int
+main(int argc, char* argv[])
+{
+  if (argc < 5) {
+    fail("usage: skytraq_pty_device flash break_reply break_after command [arg...]");
+  }
+
+  FILE* f = fopen(argv[1], "rb");
+  if (f == nullptr) {
+    fail("cannot open the flash image");
+  }
+  char buf[SECTOR_SIZE];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    flash.append(buf, n);
+  }
+  fclose(f);
+  break_reply = atoi(argv[2]);
+  break_after = atoi(argv[3]);
+
+  master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+    /* Nothing to test on a system without ptys. */
+    fprintf(stderr, "skytraq_pty_device: no pty available, skipped.\n");
+    return 0;
+  }
+  std::string slave_name = ptsname(master);
+  /* Keep the slave open so the master doesn't see a hangup before the
+   * command opens it or after it closes it.
+   */
+  int slave = open(slave_name.c_str(), O_RDWR | O_NOCTTY);
+  if (slave < 0) {
+    fail("cannot open the pty slave");
+  }
+
+  std::vector<char*> args;
+  for (int i = 4; i < argc; i++) {
+    args.push_back(strcmp(argv[i], "PTY") == 0 ? &slave_name[0] : argv[i]);
+  }
+  args.push_back(nullptr);
+
+  pid_t child = fork();
+  if (child < 0) {
+    fail(strerror(errno));
+  }
+  if (child == 0) {
+    close(master);
+    close(slave);
+    execvp(args[0], args.data());
+    _exit(127);
+  }
+
+  std::string in;
+  int status;
+  while (waitpid(child, &status, WNOHANG) != child) {
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(master, &fds);
+    struct timeval tv = { 0, 100000 };
+    if (select(master + 1, &fds, nullptr, nullptr, &tv) > 0  &&  FD_ISSET(master, &fds)) {
+      ssize_t rc = read(master, buf, sizeof(buf));
+      if (rc > 0) {
+        in.append(buf, rc);
+        handle_input(in);
+      }
+    }
+  }
+  close(slave);
+  close(master);
+
+  if (break_reply > 0  &&  multi_replies < break_reply) {
+    fail("the host didn't read enough batches to break one");
+  }
+  if (resume_expected >= 0) {
+    fail("the host didn't read again after the broken batch");
+  }
+  return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+}
@@ -128,9 +128,9 @@ void SimplifyRouteFilter::compute_xte(struct xte* xte_rec)
       fatal(MYNAME ": relative needs hdop information.\n");
     }
     // if timestamps exist, distance to interpolated point
-    if (wpt1->GetCreationTime() != wpt2->GetCreationTime()) {
-      double frac = (double)(wpt3->GetCreationTime().toTime_t() - wpt1->GetCreationTime().toTime_t()) /
-        (wpt2->GetCreationTime().toTime_t() - wpt1->GetCreationTime().toTime_t());
+    if (wpt1->creation_time != wpt2->creation_time) {
+      double frac = (double)(wpt3->creation_time.toTime_t() - wpt1->creation_time.toTime_t()) /
+        (wpt2->creation_time.toTime_t() - wpt1->creation_time.toTime_t());
       linepart(wpt1->latitude, wpt1->longitude,
                wpt2->latitude, wpt2->longitude,
                frac, &reslat, &reslon);
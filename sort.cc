@@ -24,8 +24,8 @@
 #include <QtCore/QString>    // for QString
 #include <cstdlib>           // for abort
 
-extern queue my_route_head;
-extern queue my_track_head;
+extern thread_local queue my_route_head;
+extern thread_local queue my_track_head;
 
 #if FILTERS_ENABLED
 
@@ -51,13 +51,13 @@ int SortFilter::sort_comp_wpt(const queue* a, const queue* b)
 
   switch (wpt_sort_mode)  {
   case SortModeWpt::description:
-    return x1->description.compare(x2->description);
+    return x1->GetDescription().compare(x2->GetDescription());
   case SortModeWpt::gcid:
     return cmp(x1->gc_data->id, x2->gc_data->id);
   case SortModeWpt::shortname:
     return x1->shortname.compare(x2->shortname);
   case SortModeWpt::time:
-    return sgn(x2->GetCreationTime().msecsTo(x1->GetCreationTime()));
+    return sgn(x2->creation_time.msecsTo(x1->creation_time));
   default:
     abort();
     return 0; /* Internal caller error. */
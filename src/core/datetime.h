@@ -24,6 +24,8 @@
 #define DATETIME_H_INCLUDED_
 
 #include <ctime>
+#include <limits>
+#include <type_traits>
 
 #include <QtCore/QtGlobal>
 #include <QtCore/QDateTime>
@@ -39,6 +41,9 @@
 namespace gpsbabel {
 
 class DateTime : public QDateTime {
+private:
+  static constexpr qint64 kEpochJulianDay = 2440588; // 1970-01-01
+
 public:
   // As a crutch, mimic the old behaviour of an uninitialized creation time
   // being 1/1/1970.
@@ -75,8 +80,21 @@ public:
   }
 
   // Temporary: Override the standard, also handle time_t 0 as invalid.
+  // This is called for every point by many filters and formats.  Only
+  // times within the first second of the epoch are rejected, and only
+  // those need the (expensive for local time) conversion to UTC, so
+  // look at the date first.
   bool isValid() const {
-    return date().isValid() && time().isValid() && toTime_t() > 0;
+    QDate d(date());
+    if (!d.isValid() || !time().isValid()) {
+      return false;
+    }
+    qint64 days = d.toJulianDay() - kEpochJulianDay;
+    if (days < -1 || days > 1) {
+      return true;
+    }
+    qint64 msecs = toMSecsSinceEpoch();
+    return msecs < 0 || msecs >= 1000;
   }
 
   // Like toString, but with subsecond time that's included only when
@@ -90,6 +108,126 @@ public:
   }
 };
 
+// Storage for Waypoint::creation_time.  It holds the milliseconds since
+// the epoch, doubled, plus one if the time is shown in local time, so it
+// is a single integer that is trivially copyable and cheap to compare and
+// shift, which the filters that walk whole tracks do for every point.
+// Everything else converts to and from DateTime.  The conversions keep
+// the instant and whether it is local time or UTC; other specs
+// (OffsetFromUTC, TimeZone) come back as UTC.  Like DateTime, a default
+// constructed time is the epoch in local time, which isValid() rejects.
+class TimeStamp {
+public:
+  TimeStamp() = default;
+
+  TimeStamp(const QDateTime& dt) {
+    if (dt.isValid()) {
+      v_ = dt.toMSecsSinceEpoch() * 2 + ((dt.timeSpec() == Qt::LocalTime) ? 1 : 0);
+    } else {
+      v_ = kInvalid;
+    }
+  }
+
+  DateTime toDateTime() const {
+    if (v_ == kInvalid) {
+      return DateTime(QDateTime());
+    }
+    return DateTime(QDateTime::fromMSecsSinceEpoch(msecs(), isLocal() ? Qt::LocalTime : Qt::UTC));
+  }
+
+  // Same as DateTime::isValid().
+  bool isValid() const {
+    qint64 ms = msecs();
+    return v_ != kInvalid && (ms < 0 || ms >= 1000);
+  }
+
+  qint64 toMSecsSinceEpoch() const {
+    return (v_ == kInvalid) ? 0 : msecs();
+  }
+
+  // Same as QDateTime::toTime_t(): -1 outside of 1970 to 2106.
+  uint toTime_t() const {
+    if (v_ == kInvalid) {
+      return uint(-1);
+    }
+    qint64 secs = msecs() / 1000;
+    if (quint64(secs) >= Q_UINT64_C(0xFFFFFFFF)) {
+      return uint(-1);
+    }
+    return uint(secs);
+  }
+
+  // Like QDateTime::setTime_t(), the local time flag is kept.
+  void setTime_t(uint secs) {
+    v_ = qint64(secs) * 2000 + ((v_ == kInvalid || isLocal()) ? 1 : 0);
+  }
+
+  qint64 msecsTo(const TimeStamp& other) const {
+    if (v_ == kInvalid || other.v_ == kInvalid) {
+      return 0;
+    }
+    return other.msecs() - msecs();
+  }
+
+  qint64 secsTo(const TimeStamp& other) const {
+    return msecsTo(other) / 1000;
+  }
+
+  TimeStamp addMSecs(qint64 ms) const {
+    TimeStamp result(*this);
+    if (v_ != kInvalid) {
+      result.v_ += ms * 2;
+    }
+    return result;
+  }
+
+  TimeStamp addSecs(qint64 secs) const {
+    return addMSecs(secs * 1000);
+  }
+
+  // TODO: like DateTime's, this should go away in favor of .addSecs().
+  TimeStamp& operator+=(const time_t& t) {
+    *this = addSecs(t);
+    return *this;
+  }
+
+  // Invalid times compare equal to each other and before all valid ones.
+  friend bool operator==(const TimeStamp& a, const TimeStamp& b) {
+    return a.msecs() == b.msecs();
+  }
+  friend bool operator!=(const TimeStamp& a, const TimeStamp& b) {
+    return a.msecs() != b.msecs();
+  }
+  friend bool operator<(const TimeStamp& a, const TimeStamp& b) {
+    return a.msecs() < b.msecs();
+  }
+  friend bool operator>(const TimeStamp& a, const TimeStamp& b) {
+    return a.msecs() > b.msecs();
+  }
+  friend bool operator<=(const TimeStamp& a, const TimeStamp& b) {
+    return a.msecs() <= b.msecs();
+  }
+  friend bool operator>=(const TimeStamp& a, const TimeStamp& b) {
+    return a.msecs() >= b.msecs();
+  }
+
+private:
+  static constexpr qint64 kInvalid = std::numeric_limits<qint64>::min();
+
+  bool isLocal() const {
+    return (v_ & 1) != 0;
+  }
+
+  qint64 msecs() const {
+    return (v_ - (v_ & 1)) / 2;
+  }
+
+  qint64 v_{1}; // the epoch in local time, as DateTime()
+};
+
+static_assert(sizeof(TimeStamp) == sizeof(qint64), "TimeStamp should be a single integer");
+static_assert(std::is_trivially_copyable<TimeStamp>::value, "TimeStamp should be trivially copyable");
+
 } // namespace gpsbabel
 
 #endif // DATETIME_H_INCLUDED_
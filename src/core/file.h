@@ -24,6 +24,7 @@
 #include <QtCore/QIODevice>
 #include <cstdio>
 #include "defs.h"
+#include "progress.h"
 
 // Mimic gbfile open services
 
@@ -34,11 +35,20 @@ class File : public QFile
 {
 public:
     explicit File(const QString& s) : QFile(s) {}
+    ~File() override {
+      progress_file_closed(this);
+    }
 
   /* in the tradition of gbfile we assume WriteOnly or ReadOnly, not ReadWrite */
   bool open(OpenMode mode) override {
     bool status;
 
+    /* In-memory files (see gbfmem_register) are stood in for by a temporary file. */
+    QString spill = gbfmem_spill(QFile::fileName(), mode & QIODevice::WriteOnly);
+    if (!spill.isEmpty()) {
+      setFileName(spill);
+    }
+
     if (QFile::fileName() == "-") {
       if (mode & QIODevice::WriteOnly) {
         status = QFile::open(stdout, mode);
@@ -55,9 +65,19 @@ public:
             (mode & QIODevice::WriteOnly)? "write" : "read",
             qPrintable(QFile::errorString()));
     }
+    if (!isSequential()) {
+      progress_file(this, (mode & QIODevice::WriteOnly) ? 0 : size(), [this]() {
+        return pos();
+      });
+    }
     return status;
   }
 
+  void close() override {
+    progress_file_closed(this);
+    QFile::close();
+  }
+
 };
 
 }; // namespace gpsbabel
@@ -19,55 +19,47 @@
 #ifndef gpsbabel_logging_h_included
 #define gpsbabel_logging_h_included
 
-// A wrapper for QTextStream that provides a sensible Warning() and Fatal()
-// with convenient stream operators.
+// A wrapper for QTextStream that builds a message with convenient stream
+// operators for fatal() and warning() in defs.h:
+//   fatal(FatalMsg() << "Invalid longitude" << lon);
 
+#include <QtCore/QString>
 #include <QtCore/QTextStream>
-#include <QtCore/QFile>
-#include <cstdlib> //exit()
 
-class Warning {
+class LogMessage {
  public:
-    explicit Warning(bool fatal = false) :
-   fatal_(fatal) {
-    file_.open(stderr, QIODevice::WriteOnly);
-    fileStream_.setDevice(&file_);
+  LogMessage() {
+    fileStream_.setString(&buffer_);
   }
-  ~Warning() {
-    fileStream_ << '\n';
-    if (fatal_) {
-      fileStream_.flush();
-      exit(1);
-    }
-  }
-  inline Warning& operator << (char d) { fileStream_ << d; return optionalSpace(); }
-  inline Warning& operator << (signed short d) { fileStream_ << d; return optionalSpace(); }
-  inline Warning& operator << (unsigned short d) { fileStream_ << d; return optionalSpace(); }
-  inline Warning& operator << (signed int d) { fileStream_ << d; return optionalSpace(); }
-  inline Warning& operator << (unsigned int d) { fileStream_ << d; return optionalSpace(); }
-  inline Warning& operator << (signed long d) { fileStream_ << d; return optionalSpace(); }
-  inline Warning& operator << (unsigned long d) { fileStream_ << d; return optionalSpace(); }
-  inline Warning& operator << (qint64 d) { fileStream_ << d; return optionalSpace(); }
-  inline Warning& operator << (quint64 d) { fileStream_ << d; return optionalSpace(); }
-  inline Warning& operator << (float d) { fileStream_ << d; return optionalSpace(); }
-  inline Warning& operator << (double d) { fileStream_ << d; return optionalSpace(); }
-  inline Warning& operator << (const char* d) { fileStream_ << QString::fromUtf8(d); return optionalSpace(); }
-  inline Warning& operator << (const QString& d) { fileStream_ << '\"' << d << '\"'; return optionalSpace(); }
-  inline Warning& operator << (const void* d) { fileStream_ << '\"' << d << '\"'; return optionalSpace(); }
+  inline LogMessage& operator << (char d) { fileStream_ << d; return optionalSpace(); }
+  inline LogMessage& operator << (signed short d) { fileStream_ << d; return optionalSpace(); }
+  inline LogMessage& operator << (unsigned short d) { fileStream_ << d; return optionalSpace(); }
+  inline LogMessage& operator << (signed int d) { fileStream_ << d; return optionalSpace(); }
+  inline LogMessage& operator << (unsigned int d) { fileStream_ << d; return optionalSpace(); }
+  inline LogMessage& operator << (signed long d) { fileStream_ << d; return optionalSpace(); }
+  inline LogMessage& operator << (unsigned long d) { fileStream_ << d; return optionalSpace(); }
+  inline LogMessage& operator << (qint64 d) { fileStream_ << d; return optionalSpace(); }
+  inline LogMessage& operator << (quint64 d) { fileStream_ << d; return optionalSpace(); }
+  inline LogMessage& operator << (float d) { fileStream_ << d; return optionalSpace(); }
+  inline LogMessage& operator << (double d) { fileStream_ << d; return optionalSpace(); }
+  inline LogMessage& operator << (const char* d) { fileStream_ << QString::fromUtf8(d); return optionalSpace(); }
+  inline LogMessage& operator << (const QString& d) { fileStream_ << '\"' << d << '\"'; return optionalSpace(); }
+  inline LogMessage& operator << (const void* d) { fileStream_ << '\"' << d << '\"'; return optionalSpace(); }
 
-  inline Warning& optionalSpace() {
+  inline LogMessage& optionalSpace() {
     fileStream_ << ' ';
     return *this;
   }
+  QString str() const {
+    fileStream_.flush();
+    return buffer_;
+  }
 private:
-  QFile file_;
-  QTextStream fileStream_;
-  bool fatal_;
+  QString buffer_;
+  mutable QTextStream fileStream_;
 };
 
-class Fatal : public Warning {
- public:
-  Fatal() : Warning(true) {}
-};
+class FatalMsg : public LogMessage {};
+class WarningMsg : public LogMessage {};
 
 #endif //  gpsbabel_logging_h_included
@@ -0,0 +1,135 @@
+/*
+    Copyright (C) 2019 Robert Lipe, gpsbabel.org
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111 USA
+
+ */
+
+#include "src/core/timeindex.h"
+
+#include "defs.h"     // for Waypoint, route_head, unknown_alt
+
+#include <QtCore/QtGlobal>  // for qAbs
+
+#include <algorithm>  // for lower_bound, is_sorted, stable_sort
+
+namespace gpsbabel
+{
+
+TimeIndex::TimeIndex(const route_head* track)
+{
+  add(track);
+}
+
+void TimeIndex::add(const Waypoint* wpt)
+{
+  if (!wpt->creation_time.isValid()) {
+    return;
+  }
+  qint64 time = wpt->creation_time.toMSecsSinceEpoch();
+  if (sorted && !entries.isEmpty() && (time < entries.last().time)) {
+    sorted = false;
+  }
+  entries.append({time, entries.size(), wpt});
+}
+
+void TimeIndex::add(const route_head* track)
+{
+  entries.reserve(entries.size() + track->rte_waypt_ct);
+  const queue* elem;
+  const queue* tmp;
+  QUEUE_FOR_EACH(&track->waypoint_list, elem, tmp) {
+    add(reinterpret_cast<const Waypoint*>(elem));
+  }
+}
+
+void TimeIndex::clear()
+{
+  entries.clear();
+  sorted = true;
+}
+
+/*
+ * Tracks are almost always recorded in time order, so the sort is
+ * normally skipped.  It is deferred until the first lookup so that
+ * points may be added in any order.
+ */
+void TimeIndex::sort() const
+{
+  if (!sorted) {
+    std::stable_sort(entries.begin(), entries.end(),
+    [](const Entry& a, const Entry& b) {
+      return a.time < b.time;
+    });
+    sorted = true;
+  }
+}
+
+/* Index of the first entry at or after msecs, size() if there is none. */
+int TimeIndex::lower_bound(qint64 msecs) const
+{
+  sort();
+  auto it = std::lower_bound(entries.cbegin(), entries.cend(), msecs,
+  [](const Entry& e, qint64 t) {
+    return e.time < t;
+  });
+  return it - entries.cbegin();
+}
+
+const Waypoint* TimeIndex::nearest(qint64 msecs) const
+{
+  if (entries.isEmpty()) {
+    return nullptr;
+  }
+
+  int after = lower_bound(msecs);
+  if (after == 0) {
+    return entries.at(0).wpt;
+  }
+  /* The first of the points sharing the time just before msecs. */
+  int before = lower_bound(entries.at(after - 1).time);
+  if (after == entries.size()) {
+    return entries.at(before).wpt;
+  }
+
+  const Entry& eb = entries.at(before);
+  const Entry& ea = entries.at(after);
+  qint64 db = qAbs(msecs - eb.time);
+  qint64 da = qAbs(ea.time - msecs);
+  if ((db < da) || ((db == da) && (eb.seq < ea.seq))) {
+    return eb.wpt;
+  }
+  return ea.wpt;
+}
+
+double TimeIndex::interpolate_altitude(qint64 msecs) const
+{
+  int idx = lower_bound(msecs);
+  if (idx == entries.size()) {
+    return unknown_alt;
+  }
+  const Entry& ea = entries.at(idx);
+  if (ea.time == msecs) {
+    return ea.wpt->altitude;
+  }
+  if (idx == 0) {
+    return unknown_alt;
+  }
+  const Entry& eb = entries.at(idx - 1);
+  double alt_diff = ea.wpt->altitude - eb.wpt->altitude;
+  return eb.wpt->altitude + (alt_diff / (ea.time - eb.time)) * (msecs - eb.time);
+}
+
+} // namespace gpsbabel
@@ -0,0 +1,80 @@
+/*
+    Copyright (C) 2019 Robert Lipe, gpsbabel.org
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111 USA
+
+ */
+
+#ifndef TIMEINDEX_H
+#define TIMEINDEX_H
+
+#include <QtCore/QVector>  // for QVector
+#include <QtCore/QtGlobal> // for qint64
+
+class Waypoint;
+struct route_head;
+
+namespace gpsbabel
+{
+
+/*
+ * An index of waypoints ordered by creation time, so that lookups by
+ * time are a binary search instead of a walk over the whole track.
+ * Points without a valid creation time are not indexed.  Points with
+ * equal times keep the order in which they were added.
+ */
+class TimeIndex
+{
+public:
+  TimeIndex() = default;
+  explicit TimeIndex(const route_head* track);
+
+  void add(const Waypoint* wpt);
+  void add(const route_head* track);
+  void clear();
+  bool isEmpty() const
+  {
+    return entries.isEmpty();
+  }
+  int size() const
+  {
+    return entries.size();
+  }
+
+  /* The point closest in time to msecs, or nullptr if the index is empty.
+   * Of several equally close points the one added first is returned. */
+  const Waypoint* nearest(qint64 msecs) const;
+
+  /* Linear interpolation of the altitude at msecs, unknown_alt outside
+   * the time span of the index. */
+  double interpolate_altitude(qint64 msecs) const;
+
+private:
+  struct Entry {
+    qint64 time;
+    int seq;
+    const Waypoint* wpt;
+  };
+
+  void sort() const;
+  int lower_bound(qint64 msecs) const;
+
+  mutable QVector<Entry> entries;
+  mutable bool sorted{true};
+};
+
+} // namespace gpsbabel
+
+#endif // TIMEINDEX_H
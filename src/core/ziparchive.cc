@@ -68,21 +68,21 @@ bool ZipArchive::Add(QString item_to_add) {
    Z_DEFAULT_STRATEGY,
    Z_DEFAULT_COMPRESSION);
   if (err) {
-    Fatal() << "Error adding" << item_to_add <<  "to zip file";
+    fatal(FatalMsg() << "Error adding" << item_to_add <<  "to zip file");
   }
 
   QFile src(item_to_add);
   if (!src.open(QIODevice::ReadOnly)) {
-    Fatal() << "Error reading" << item_to_add <<  "to zip file";
+    fatal(FatalMsg() << "Error reading" << item_to_add <<  "to zip file");
   }
 
   // Be lazy and read the whole file back into memory (again).
   QByteArray b = src.readAll();
   if (zipWriteInFileInZip(zipfile_, b.constData(), b.size())) {
-    Fatal() << "Error writing" << item_to_add << "to zip";
+    fatal(FatalMsg() << "Error writing" << item_to_add << "to zip");
   }
   if (zipCloseFileInZip(zipfile_)) {
-    Fatal() << "Error closing" << item_to_add << "to zip";
+    fatal(FatalMsg() << "Error closing" << item_to_add << "to zip");
   }
   return false;
 }
@@ -138,7 +138,7 @@ parse_header(char* line)
       } else if (key == "TYPE") {
         filetype = qstr.toInt(&ok);
         if (!ok) {
-          Fatal() << MYNAME << "Unknown file type " << key;
+          fatal(FatalMsg() << MYNAME << "Unknown file type " << key);
         }
         switch (filetype) {
         case 4:	/* M9 TrackLog (Suunto Sail Manager) */
@@ -285,7 +285,7 @@ parse_point(char *line) {
           auto year = v[2].toInt();
           dt = QDate(year, month, day);
         } else {
-          Fatal() << MYNAME << "Invalid date" << qstr;
+          fatal(FatalMsg() << MYNAME << "Invalid date" << qstr);
         }
         break;
       }
@@ -298,20 +298,20 @@ parse_point(char *line) {
           auto sec = v[2].toInt();
           tm = QTime(hour, min, sec);
         } else {
-          Fatal() << MYNAME << "Invalid Time" << qstr;
+          fatal(FatalMsg() << MYNAME << "Invalid Time" << qstr);
         }
         break;
       }
       case 4:
         wpt->latitude = qstr.toDouble(&ok);
         if (!ok) {
-          Fatal() << MYNAME << "Invalid latitude" << qstr;
+          fatal(FatalMsg() << MYNAME << "Invalid latitude" << qstr);
         }
         break;
       case 5:
         wpt->longitude = qstr.toDouble(&ok);
         if (!ok) {
-          Fatal() << MYNAME << "Invalid longitude" << qstr;
+          fatal(FatalMsg() << MYNAME << "Invalid longitude" << qstr);
         }
         break;
       case 6: {
@@ -329,7 +329,7 @@ parse_point(char *line) {
             WAYPT_SET(wpt, speed, v * 3.6);
           } else if (what == 3) {
             WAYPT_SET(wpt, proximity, v);
-            wpt->notes = QString("Alarm point: radius=" + qstr);
+            wpt->SetNotes(QString("Alarm point: radius=" + qstr));
           }
         }
         break;
@@ -378,7 +378,7 @@ parse_point(char *line) {
       route_add_wpt(route, wpt);
       break;
     default:
-      Warning() << MYNAME << "Invalid internal field type" << what;
+      warning(WarningMsg() << MYNAME << "Invalid internal field type" << what);
   }
 }
 
@@ -194,11 +194,11 @@ waypoint_final()
   wpt_tmp->wpt_flags.fmt_use  = 0;
 
   if (version < 2) {	/* keep the old behaviour */
-    wpt_tmp->notes = wpt_tmp->description;
-    wpt_tmp->description = QString();
+    wpt_tmp->SetNotes(wpt_tmp->GetDescription());
+    wpt_tmp->SetDescription(QString());
   }
 
-  wpt_tmp->notes = fix_notes(wpt_tmp->shortname, wpt_tmp->notes);
+  wpt_tmp->SetNotes(fix_notes(wpt_tmp->shortname, wpt_tmp->GetNotes()));
 
   if (via != 0) {
     waypt_add(wpt_tmp);
@@ -249,14 +249,14 @@ tef_item_start(xg_string, const QXmlStreamAttributes* attrv)
     if (attr.name().compare(QLatin1String("SegDescription"), Qt::CaseInsensitive) == 0) {
       wpt_tmp->shortname = attrstr.trimmed();
     } else if (attr.name().compare(QLatin1String("PointDescription"), Qt::CaseInsensitive) == 0) {
-      wpt_tmp->description = attrstr.trimmed();
+      wpt_tmp->SetDescription(attrstr.trimmed());
     } else if (attr.name().compare(QLatin1String("ViaStation"), Qt::CaseInsensitive) == 0 &&
                attr.value().compare(QLatin1String("true"), Qt::CaseInsensitive) == 0) {
       wpt_tmp->wpt_flags.fmt_use = 1;  /* only a flag */
 
       /* new in TEF V2 */
     } else if (attr.name().compare(QLatin1String("Instruction"), Qt::CaseInsensitive) == 0) {
-      wpt_tmp->description = attrstr.trimmed();
+      wpt_tmp->SetDescription(attrstr.trimmed());
     } else if (attr.name().compare(QLatin1String("Altitude"), Qt::CaseInsensitive) == 0) {
       wpt_tmp->altitude = attrstr.toDouble();
     } else if (attr.name().compare(QLatin1String("TimeStamp"), Qt::CaseInsensitive) == 0) {
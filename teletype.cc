@@ -60,7 +60,7 @@ teletype_read()
   for (uint32_t i = 0; i < tty_wpt_count; i++) {
     Waypoint* wpt = new Waypoint;
     wpt->shortname = (gbfgetcstr(fin));
-    wpt->description = (gbfgetcstr(fin));
+    wpt->SetDescription(gbfgetcstr(fin));
 
     if (true) { // needs bit values of NEWFORMAT2
       uint32_t direction = gbfgetuint32(fin);
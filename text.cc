@@ -129,8 +129,8 @@ text_disp(const Waypoint* wpt)
     xfree(altout);
   }
 
-  if (wpt->description != wpt->shortname) {
-    gbfputs(wpt->description, file_out);
+  if (wpt->GetDescription() != wpt->shortname) {
+    gbfputs(wpt->GetDescription(), file_out);
     if (!wpt->gc_data->placer.isEmpty()) {
       gbfputs(" by ", file_out);
       gbfputs(wpt->gc_data->placer, file_out);
@@ -160,9 +160,9 @@ text_disp(const Waypoint* wpt)
       }
       gbfprintf(file_out, "\nHint: %s\n", CSTR(hint));
     }
-  } else if (!wpt->notes.isEmpty() && (wpt->description.isEmpty() || wpt->notes != wpt->description)) {
+  } else if (!wpt->GetNotes().isEmpty() && (wpt->GetDescription().isEmpty() || wpt->GetNotes() != wpt->GetDescription())) {
     gbfputs("\n", file_out);
-    gbfputs(wpt->notes, file_out);
+    gbfputs(wpt->GetNotes(), file_out);
     gbfputs("\n", file_out);
   }
 
@@ -171,7 +171,7 @@ data_read()
 
       wpt_tmp->longitude = lon;
       wpt_tmp->latitude = lat;
-      wpt_tmp->description = desc;
+      wpt_tmp->SetDescription(desc);
       wpt_tmp->shortname = mkshort(mkshort_handle, QString(desc));
 
       waypt_add(wpt_tmp);
@@ -187,8 +187,8 @@ tiger_disp(const Waypoint* wpt)
   double lon = wpt->longitude;
 
   if (iconismarker) {
-    pin = wpt->icon_descr;
-  } else if (wpt->icon_descr.contains("-unfound")) {
+    pin = wpt->GetIconDescr();
+  } else if (wpt->GetIconDescr().contains("-unfound")) {
     pin = unfoundmarker;
   } else if (wpt->GetCreationTime() > current_time().addSecs(-3600 * 24 * thresh_days)) {
     pin = newmarker;
@@ -214,7 +214,7 @@ tiger_disp(const Waypoint* wpt)
   gbfprintf(file_out, "%f,%f:%s", lon, lat, CSTR(pin));
   if (!nolabels) {
     QString temp;
-    QString desc = csv_stringclean(wpt->description, ":");
+    QString desc = csv_stringclean(wpt->GetDescription(), ":");
     if (global_opts.synthesize_shortnames) {
       temp = desc;
       desc = mkshort(mkshort_whandle, desc);
@@ -237,7 +237,7 @@ map_plot(const Waypoint* wpt)
   x+=10;
   y+=10;
 
-  gbfprintf(linkf, "<area shape=\"circle\" coords=\"%d,%d,7\" href=\"%s\" alt=\"%s\"\n", x, y, wpt->url, wpt->description);
+  gbfprintf(linkf, "<area shape=\"circle\" coords=\"%d,%d,7\" href=\"%s\" alt=\"%s\"\n", x, y, wpt->url, wpt->GetDescription());
 }
 #endif /* CLICKMAP */
 
@@ -103,7 +103,7 @@ data_read()
           /* Description is not a TopoMapPro format requirement.
              If we assign "" then .loc/.gpx will generate empty XML tags :(
           */
-          wpt_tmp->description = csv_stringtrim(s, "");
+          wpt_tmp->SetDescription(csv_stringtrim(s, ""));
           break;
         case 3:
           wpt_tmp->latitude = atof(s);
@@ -174,11 +174,11 @@ tmpro_waypt_pr(const Waypoint* wpt)
   QString shortname;
   QString description;
   if ((wpt->shortname.isEmpty()) || (global_opts.synthesize_shortnames)) {
-    if (!wpt->description.isEmpty()) {
+    if (!wpt->GetDescription().isEmpty()) {
       if (global_opts.synthesize_shortnames) {
         shortname = mkshort_from_wpt(mkshort_handle, wpt);
       } else {
-        shortname = csv_stringclean(wpt->description, ",\"");
+        shortname = csv_stringclean(wpt->GetDescription(), ",\"");
       }
     } else {
       /* no description available */
@@ -188,14 +188,14 @@ tmpro_waypt_pr(const Waypoint* wpt)
     shortname = csv_stringclean(wpt->shortname, ",\"");
   }
 
-  if (wpt->description.isEmpty()) {
+  if (wpt->GetDescription().isEmpty()) {
     if (!shortname.isEmpty()) {
       description = csv_stringclean(shortname, ",\"");
     } else {
       description = xstrdup("");
     }
   } else {
-    description = csv_stringclean(wpt->description, ",\"");
+    description = csv_stringclean(wpt->GetDescription(), ",\"");
   }
 
   /* Group sID sDescription fLat fLong fEasting fNorthing fAlt iColour iSymbol sHyperLink */
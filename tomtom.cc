@@ -201,7 +201,7 @@ data_read()
 
       wpt_tmp->longitude = x/100000.0;
       wpt_tmp->latitude = y/100000.0;
-      wpt_tmp->description = STRTOUNICODE(desc);
+      wpt_tmp->SetDescription(STRTOUNICODE(desc));
       xfree(desc);
       desc = nullptr;
       // TODO:: description in rectype 3 contains two zero-terminated strings
@@ -338,7 +338,7 @@ write_blocks(gbfile* f, struct blockheader* blocks)
       if (global_opts.smart_names &&
           blocks->start[i].wpt->gc_data->diff &&
           blocks->start[i].wpt->gc_data->terr) {
-        snprintf(desc_field,sizeof(desc_field),"%s(t%ud%u)%s(type%dcont%d)",STRFROMUNICODE(blocks->start[i].wpt->description),
+        snprintf(desc_field,sizeof(desc_field),"%s(t%ud%u)%s(type%dcont%d)",STRFROMUNICODE(blocks->start[i].wpt->GetDescription()),
                  blocks->start[i].wpt->gc_data->terr/10,
                  blocks->start[i].wpt->gc_data->diff/10,
                  STRFROMUNICODE(blocks->start[i].wpt->shortname),
@@ -347,7 +347,7 @@ write_blocks(gbfile* f, struct blockheader* blocks)
         //Unfortunately enums mean we get numbers for cache type and container.
       } else {
         snprintf(desc_field, sizeof(desc_field), "%s",
-                 STRFROMUNICODE(blocks->start[i].wpt->description));
+                 STRFROMUNICODE(blocks->start[i].wpt->GetDescription()));
       }
       write_long(f, strlen(desc_field) + 14);
       write_float_as_long(f, blocks->start[i].wpt->longitude*100000);
@@ -374,7 +374,7 @@ compute_blocks(struct hdr* start, int count,
       newblock->size += 4 * 3 + 1;
       /* wpt const part 3 longs, 1 char */
       Waypoint* wpt = start[i].wpt;
-      newblock->size += wpt->description.length() + 1;
+      newblock->size += wpt->GetDescription().length() + 1;
     }
   } else {
     if ((maxlat-minlat)>(maxlon-minlon)) {
@@ -424,10 +424,10 @@ data_write()
   int ct = waypt_count();
   struct hdr* htable, *bh;
 #if NEWQ
-  extern QList<Waypoint*> waypt_list;
+  extern thread_local QList<Waypoint*> waypt_list;
 #else
   queue* elem, *tmp;
-  extern queue waypt_head;
+  extern thread_local queue waypt_head;
 #endif
   double minlon = 200;
   double maxlon = -200;
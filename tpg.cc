@@ -151,7 +151,7 @@ tpg_read()
     (void) gbfgetint32(tpg_file_in);
 
     /* pascal-like description */
-    wpt_tmp->description = gbfgetpstr(tpg_file_in);
+    wpt_tmp->SetDescription(gbfgetpstr(tpg_file_in));
 
     /* 2 bytes */
     (void) gbfgetint16(tpg_file_in);
@@ -185,11 +185,11 @@ tpg_waypt_pr(const Waypoint* wpt)
    */
 
   if ((wpt->shortname.isEmpty()) || (global_opts.synthesize_shortnames)) {
-    if (!wpt->description.isEmpty()) {
+    if (!wpt->GetDescription().isEmpty()) {
       if (global_opts.synthesize_shortnames) {
         shortname = mkshort_from_wpt(mkshort_handle, wpt);
       } else {
-        shortname = wpt->description;
+        shortname = wpt->GetDescription();
       }
     } else {
       /* no description available */
@@ -198,14 +198,14 @@ tpg_waypt_pr(const Waypoint* wpt)
   } else {
     shortname = wpt->shortname;
   }
-  if (wpt->description.isEmpty()) {
+  if (wpt->GetDescription().isEmpty()) {
     if (!shortname.isEmpty()) {
       description = shortname;
     } else {
       description = "";
     }
   } else {
-    description = wpt->description;
+    description = wpt->GetDescription();
   }
 
   /* convert lat/long to NAD27/CONUS datum */
@@ -855,7 +855,7 @@ static void tpo_process_waypoints()
     if (name_length) {
       QString comment;
       gbfread(comment, 1, name_length, tpo_file_in);
-      waypoint_temp->description = comment;
+      waypoint_temp->SetDescription(comment);
     }
 
     // For routes (later), we need a duplicate of each waypoint
@@ -940,7 +940,7 @@ static void tpo_process_map_notes()
       QString comment;
 
       gbfread(comment, 1, name_length, tpo_file_in);
-      waypoint_temp->description = comment;
+      waypoint_temp->SetDescription(comment);
     }
 
     // Length of text for external path.  If non-zero, skip past
@@ -1089,7 +1089,7 @@ static void tpo_process_text_labels()
     if (name_length) {
       QString comment;
       gbfread(comment, 1, name_length, tpo_file_in);
-      waypoint_temp->description = comment;
+      waypoint_temp->SetDescription(comment);
     }
 
     // Add the waypoint to the chain of waypoints
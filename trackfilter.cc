@@ -42,14 +42,17 @@
 #include <QtCore/QRegularExpression>       // for QRegularExpression, QRegularExpression::CaseInsensitiveOption, QRegularExpression::PatternOptions
 #include <QtCore/QRegularExpressionMatch>  // for QRegularExpressionMatch
 #include <QtCore/QString>                  // for QString
+#include <QtCore/QVector>                  // for QVector
 #include <QtCore/Qt>                       // for UTC, CaseInsensitive
-#include <algorithm>                       // for sort, stable_sort
+#include <algorithm>                       // for sort
 #include <cassert>                         // for assert
 #include <cmath>                           // for nan
 #include <cstdio>                          // for printf
 #include <cstdlib>                         // for abs
 #include <cstring>                         // for strlen, strchr, strcmp
 #include <ctime>                           // for gmtime, strftime
+#include <queue>                           // for priority_queue
+#include <vector>                          // for vector
 
 #if FILTERS_ENABLED || MINIMAL_FILTERS
 #define MYNAME "trackfilter"
@@ -117,11 +120,6 @@ bool TrackFilter::trackfilter_init_sort_cb(const route_head* ha, const route_hea
   return trackfilter_get_first_time(ha) < trackfilter_get_first_time(hb);
 }
 
-bool TrackFilter::trackfilter_merge_sort_cb(const Waypoint* wa, const Waypoint* wb)
-{
-  return wa->GetCreationTime() < wb->GetCreationTime();
-}
-
 fix_type TrackFilter::trackfilter_parse_fix(int* nsats)
 {
   if (!opt_fix) {
@@ -200,7 +198,7 @@ void TrackFilter::trackfilter_fill_track_list_cb(const route_head* track) 	/* ca
             wpt->latitude, wpt->longitude);
     }
 
-    if (need_time && (prev != nullptr) && (prev->GetCreationTime() > wpt->GetCreationTime())) {
+    if (need_time && (prev != nullptr) && (prev->creation_time > wpt->creation_time)) {
       if (opt_merge == nullptr) {
         QString t1 = prev->CreationTimeXML();
         QString t2 = wpt->CreationTimeXML();
@@ -343,6 +341,8 @@ void TrackFilter::trackfilter_merge()
     int original_waypt_count = track_waypt_count();
 
     QList<Waypoint*> buff;
+    QVector<qint64> times;	/* creation time of buff[i] */
+    QVector<int> runs;	/* start of each non decreasing run of times in buff */
 
     auto it = track_list.begin();
     while (it != track_list.end()) { /* put all points into temp buffer */
@@ -358,7 +358,12 @@ void TrackFilter::trackfilter_merge()
           // track_del_wpt cleared new_trkseg flag for wpt.
           // track_add_wpt will set new_trkseg for the first point
           // added to a track.
+          qint64 time = wpt->creation_time.toMSecsSinceEpoch();
+          if (times.isEmpty() || (time < times.last())) {
+            runs.append(buff.size());
+          }
           buff.append(wpt);
+          times.append(time);
         } else {
           delete wpt;
         }
@@ -371,14 +376,49 @@ void TrackFilter::trackfilter_merge()
       }
     }
 
-    std::stable_sort(buff.begin(), buff.end(), trackfilter_merge_sort_cb);
+    /*
+     * The tracks are usually sorted by time already, so instead of sorting
+     * all points we merge the sorted runs.  Ties are taken from the earlier
+     * run first, which gives the same order as a stable sort.
+     */
+    QVector<int> order;	/* indices into buff, sorted by time */
+    order.reserve(buff.size());
+    if (runs.size() <= 1) {
+      for (int i = 0; i < buff.size(); i++) {
+        order.append(i);
+      }
+    } else {
+      QVector<int> next(runs);	/* next unmerged point of each run */
+      QVector<int> end(runs.mid(1));
+      end.append(buff.size());
+      auto later = [&times, &next](int run_a, int run_b) {
+        qint64 time_a = times.at(next.at(run_a));
+        qint64 time_b = times.at(next.at(run_b));
+        return (time_a > time_b) || ((time_a == time_b) && (run_a > run_b));
+      };
+      std::priority_queue<int, std::vector<int>, decltype(later)> heap(later);
+      for (int run = 0; run < runs.size(); run++) {
+        heap.push(run);
+      }
+      while (!heap.empty()) {
+        int run = heap.top();
+        heap.pop();
+        order.append(next[run]++);
+        if (next.at(run) < end.at(run)) {
+          heap.push(run);
+        }
+      }
+    }
 
     Waypoint* prev = nullptr;
+    qint64 prev_time = 0;
 
-    for (auto wpt : buff) {
-      if ((prev == nullptr) || (prev->GetCreationTime() != wpt->GetCreationTime())) {
+    for (int i : qAsConst(order)) {
+      Waypoint* wpt = buff.at(i);
+      if ((prev == nullptr) || (prev_time != times.at(i))) {
         track_add_wpt(master, wpt);
         prev = wpt;
+        prev_time = times.at(i);
       } else {
         delete wpt;
       }
@@ -531,7 +571,7 @@ void TrackFilter::trackfilter_split()
         }
 
         if (interval > 0) {
-          double tr_interval = 0.001 * buff.at(i)->GetCreationTime().msecsTo(buff.at(j)->GetCreationTime());
+          double tr_interval = 0.001 * buff.at(i)->creation_time.msecsTo(buff.at(j)->creation_time);
           if (tr_interval <= interval) {
             new_track_flag = false;
           }
@@ -560,106 +600,6 @@ void TrackFilter::trackfilter_split()
   }
 }
 
-/*******************************************************************************
-* option "move"
-*******************************************************************************/
-
-void TrackFilter::trackfilter_move()
-{
-  queue* elem, *tmp;
-
-  qint64 delta = trackfilter_parse_time_opt(opt_move);
-  if (delta == 0) {
-    return;
-  }
-
-  for (auto track : qAsConst(track_list)) {
-    QUEUE_FOR_EACH(&track->waypoint_list, elem, tmp) {
-      auto wpt = reinterpret_cast<Waypoint*>(elem);
-      wpt->creation_time = wpt->creation_time.addSecs(delta);
-    }
-  }
-}
-
-/*******************************************************************************
-* options "fix", "course", "speed"
-*******************************************************************************/
-
-void TrackFilter::trackfilter_synth()
-{
-  queue* elem, *tmp;
-
-  double last_course_lat;
-  double last_course_lon;
-  double last_speed_lat = std::nan(""); /* Quiet gcc 7.3.0 -Wmaybe-uninitialized */
-  double last_speed_lon = std::nan(""); /* Quiet gcc 7.3.0 -Wmaybe-uninitialized */
-  gpsbabel::DateTime last_speed_time;
-  int nsats = 0;
-
-  fix_type fix = trackfilter_parse_fix(&nsats);
-
-  for (auto track : qAsConst(track_list)) {
-    bool first = true;
-    QUEUE_FOR_EACH(&track->waypoint_list, elem, tmp) {
-      auto wpt = reinterpret_cast<Waypoint*>(elem);
-      if (opt_fix) {
-        wpt->fix = fix;
-        if (wpt->sat == 0) {
-          wpt->sat = nsats;
-        }
-      }
-      if (first) {
-        if (opt_course) {
-          // TODO: the course value 0 isn't valid, wouldn't it be better to UNSET course?
-          WAYPT_SET(wpt, course, 0);
-        }
-        if (opt_speed) {
-          // TODO: the speed value 0 isn't valid, wouldn't it be better to UNSET speed?
-          WAYPT_SET(wpt, speed, 0);
-        }
-        first = false;
-        last_course_lat = wpt->latitude;
-        last_course_lon = wpt->longitude;
-        last_speed_lat = wpt->latitude;
-        last_speed_lon = wpt->longitude;
-        last_speed_time = wpt->GetCreationTime();
-      } else {
-        if (opt_course) {
-          WAYPT_SET(wpt, course, heading_true_degrees(RAD(last_course_lat),
-                    RAD(last_course_lon),RAD(wpt->latitude),
-                    RAD(wpt->longitude)));
-          last_course_lat = wpt->latitude;
-          last_course_lon = wpt->longitude;
-        }
-        if (opt_speed) {
-          if (last_speed_time.msecsTo(wpt->GetCreationTime()) != 0) {
-            // If we have mutliple points with the same time and
-            // we use the pair of points about which the time ticks then we will
-            // underestimate the distance and compute low speeds on average.
-            // Therefore, if we have multiple points with the same time use the
-            // first ones with the new times to compute speed.
-            // Note that points with the same time can occur because the input
-            // has truncated times, or because we are truncating times with
-            // toTime_t().
-            WAYPT_SET(wpt, speed, radtometers(gcdist(
-                                                RAD(last_speed_lat), RAD(last_speed_lon),
-                                                RAD(wpt->latitude),
-                                                RAD(wpt->longitude))) /
-                      (0.001 * std::abs(last_speed_time.msecsTo(wpt->GetCreationTime())))
-                     );
-            last_speed_lat = wpt->latitude;
-            last_speed_lon = wpt->longitude;
-            last_speed_time = wpt->GetCreationTime();
-          } else {
-            WAYPT_UNSET(wpt, speed);
-          }
-        }
-      }
-    }
-  }
-}
-
-
 /*******************************************************************************
 * option: "start" / "stop"
 *******************************************************************************/
@@ -691,6 +631,20 @@ QDateTime TrackFilter::trackfilter_range_check(const char* timestr)
   return result;
 }
 
+/* Whether wpt is kept by "start" and "stop"; an invalid bound is open. */
+bool TrackFilter::trackfilter_range_inside(const Waypoint* wpt, const QDateTime& start, const QDateTime& stop)
+{
+  if (!wpt->creation_time.isValid()) {
+    // If the time is mangled so horribly that it's
+    // negative, toss it.
+    return false;
+  }
+  qint64 time = wpt->creation_time.toMSecsSinceEpoch();
+  bool after_start = !start.isValid() || (time >= start.toMSecsSinceEpoch());
+  bool before_stop = !stop.isValid() || (time <= stop.toMSecsSinceEpoch());
+  return after_start && before_stop;
+}
+
 void TrackFilter::trackfilter_range()
 {
   QDateTime start, stop; // constructed such that isValid() is false, unlike gpsbabel::DateTime!
@@ -712,18 +666,7 @@ void TrackFilter::trackfilter_range()
 
     QUEUE_FOR_EACH(&track->waypoint_list, elem, tmp) {
       auto wpt = reinterpret_cast<Waypoint*>(elem);
-      bool inside;
-      if (wpt->creation_time.isValid()) {
-        bool after_start = !start.isValid() || (wpt->GetCreationTime() >= start);
-        bool before_stop = !stop.isValid() || (wpt->GetCreationTime() <= stop);
-        inside = after_start && before_stop;
-      } else {
-        // If the time is mangled so horribly that it's
-        // negative, toss it.
-        inside = false;
-      }
-
-      if (!inside) {
+      if (!trackfilter_range_inside(wpt, start, stop)) {
         track_del_wpt(track, wpt);
         delete wpt;
       }
@@ -870,25 +813,6 @@ TrackFilter::faketime_t TrackFilter::trackfilter_faketime_check(const char* time
   return result;
 }
 
-void TrackFilter::trackfilter_faketime()
-{
-  queue* elem, *tmp;
-
-  assert(opt_faketime != nullptr);
-  faketime_t faketime = trackfilter_faketime_check(opt_faketime);
-
-  for (auto track : qAsConst(track_list)) {
-    QUEUE_FOR_EACH(&track->waypoint_list, elem, tmp) {
-      auto wpt = reinterpret_cast<Waypoint*>(elem);
-
-      if (!wpt->creation_time.isValid() || faketime.force) {
-        wpt->creation_time = faketime.start;
-        faketime.start = faketime.start.addSecs(faketime.step);
-      }
-    }
-  }
-}
-
 bool TrackFilter::trackfilter_points_are_same(const Waypoint* wpta, const Waypoint* wptb)
 {
   // We use a simpler (non great circle) test for lat/lon here as this
@@ -957,6 +881,147 @@ void TrackFilter::trackfilter_segment_head(const route_head* rte)
   }
 }
 
+/*******************************************************************************
+* options "move", "fix", "course", "speed", "faketime" and "start" / "stop"
+*******************************************************************************/
+
+/*
+ * These options only look at a point and its predecessor in the same
+ * track, so they are done in a single pass over the points.  For each
+ * point they are applied in the same order as separate passes would be.
+ * Range checking ("start"/"stop") is only included if do_range is set,
+ * i.e. if faketime isn't used; with faketime the tracks have to be
+ * checked and resorted by init() before the range check.
+ */
+void TrackFilter::trackfilter_points(bool do_range)
+{
+  queue* elem, *tmp;
+
+  qint64 delta = (opt_move != nullptr) ? trackfilter_parse_time_opt(opt_move) : 0;
+
+  bool do_synth = (opt_speed || opt_course || opt_fix);
+  int nsats = 0;
+  fix_type fix = trackfilter_parse_fix(&nsats);
+
+  faketime_t faketime;
+  if (opt_faketime != nullptr) {
+    faketime = trackfilter_faketime_check(opt_faketime);
+  }
+
+  QDateTime start, stop; // constructed such that isValid() is false, unlike gpsbabel::DateTime!
+  if (do_range && (opt_start != nullptr)) {
+    start = trackfilter_range_check(opt_start);
+  }
+  if (do_range && (opt_stop != nullptr)) {
+    stop = trackfilter_range_check(opt_stop);
+  }
+
+  int original_waypt_count = track_waypt_count();
+
+  auto it = track_list.begin();
+  while (it != track_list.end()) {
+    route_head* track = *it;
+
+    bool first = true;
+    double last_course_lat = 0;
+    double last_course_lon = 0;
+    double last_speed_lat = 0;
+    double last_speed_lon = 0;
+    gpsbabel::TimeStamp last_speed_time;
+
+    QUEUE_FOR_EACH(&track->waypoint_list, elem, tmp) {
+      auto wpt = reinterpret_cast<Waypoint*>(elem);
+
+      /* option "move" */
+      if (delta != 0) {
+        wpt->creation_time = wpt->creation_time.addSecs(delta);
+      }
+
+      /* options "fix", "course", "speed" */
+      if (do_synth) {
+        if (opt_fix) {
+          wpt->fix = fix;
+          if (wpt->sat == 0) {
+            wpt->sat = nsats;
+          }
+        }
+        if (first) {
+          if (opt_course) {
+            // TODO: the course value 0 isn't valid, wouldn't it be better to UNSET course?
+            WAYPT_SET(wpt, course, 0);
+          }
+          if (opt_speed) {
+            // TODO: the speed value 0 isn't valid, wouldn't it be better to UNSET speed?
+            WAYPT_SET(wpt, speed, 0);
+          }
+          last_course_lat = wpt->latitude;
+          last_course_lon = wpt->longitude;
+          last_speed_lat = wpt->latitude;
+          last_speed_lon = wpt->longitude;
+          last_speed_time = wpt->creation_time;
+        } else {
+          if (opt_course) {
+            WAYPT_SET(wpt, course, heading_true_degrees(RAD(last_course_lat),
+                      RAD(last_course_lon),RAD(wpt->latitude),
+                      RAD(wpt->longitude)));
+            last_course_lat = wpt->latitude;
+            last_course_lon = wpt->longitude;
+          }
+          if (opt_speed) {
+            if (last_speed_time.msecsTo(wpt->creation_time) != 0) {
+              // If we have mutliple points with the same time and
+              // we use the pair of points about which the time ticks then we will
+              // underestimate the distance and compute low speeds on average.
+              // Therefore, if we have multiple points with the same time use the
+              // first ones with the new times to compute speed.
+              // Note that points with the same time can occur because the input
+              // has truncated times, or because we are truncating times with
+              // toTime_t().
+              WAYPT_SET(wpt, speed, radtometers(gcdist(
+                                                  RAD(last_speed_lat), RAD(last_speed_lon),
+                                                  RAD(wpt->latitude),
+                                                  RAD(wpt->longitude))) /
+                        (0.001 * std::abs(last_speed_time.msecsTo(wpt->creation_time)))
+                       );
+              last_speed_lat = wpt->latitude;
+              last_speed_lon = wpt->longitude;
+              last_speed_time = wpt->creation_time;
+            } else {
+              WAYPT_UNSET(wpt, speed);
+            }
+          }
+        }
+      }
+      first = false;
+
+      /* option "faketime" */
+      if ((opt_faketime != nullptr) && (!wpt->creation_time.isValid() || faketime.force)) {
+        wpt->creation_time = faketime.start;
+        faketime.start = faketime.start.addSecs(faketime.step);
+      }
+
+      /* options "start" / "stop" */
+      if (do_range) {
+        if (!trackfilter_range_inside(wpt, start, stop)) {
+          track_del_wpt(track, wpt);
+          delete wpt;
+        }
+      }
+    }
+
+    if (do_range && (track->rte_waypt_ct == 0)) {
+      track_del_head(track);
+      it = track_list.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  if (do_range && (original_waypt_count > 0) && (track_waypt_count() == 0)) {
+    warning(MYNAME "-range: All %d track points have been dropped!\n", original_waypt_count);
+  }
+}
+
 /*******************************************************************************
 * global cb's
 *******************************************************************************/
@@ -1027,15 +1092,16 @@ void TrackFilter::process()
     }
   }
 
-  if (opt_move != nullptr) {		/* Correct timestamps before any other op */
-    trackfilter_move();
-    if (--opts == 0) {
-      return;
-    }
-  }
+  /* Correct timestamps before any other op */
+  bool do_range = ((opt_stop != nullptr) || (opt_start != nullptr)) && (opt_faketime == nullptr);
+
+  if ((opt_move != nullptr) || opt_speed || opt_course || opt_fix ||
+      (opt_faketime != nullptr) || do_range) {
+    trackfilter_points(do_range);
 
-  if (opt_speed || opt_course || opt_fix) {
-    trackfilter_synth();
+    if (opt_move != nullptr) {
+      opts--;
+    }
     if (opt_speed) {
       opts--;
     }
@@ -1045,30 +1111,34 @@ void TrackFilter::process()
     if (opt_fix) {
       opts--;
     }
-    if (!opts) {
-      return;
+    if (opt_faketime != nullptr) {
+      opts--;
+      // tracks and points within tracks may now be out of order.
+    }
+    if (do_range && (opt_start != nullptr)) {
+      opts--;
+    }
+    if (do_range && (opt_stop != nullptr)) {
+      opts--;
     }
-  }
-
-  if ((opt_faketime != nullptr)) {
-    opts--;
-
-    trackfilter_faketime();
-    // tracks and points within tracks may now be out of order.
 
     if (opts == 0) {
       return;
     }
 
-    deinit();       /* reinitialize */
-    init();
+    if ((opt_faketime != nullptr) || do_range) {
+      // track_list may? now be invalid!
+      // TODO: Is this needed if range maintains the track_list?
+      deinit();       /* reinitialize */
+      init();
 
-    if (track_list.isEmpty()) {
-      return;  /* no more track(s), no more fun */
+      if (track_list.isEmpty()) {
+        return;  /* no more track(s), no more fun */
+      }
     }
   }
 
-  if ((opt_stop != nullptr) || (opt_start != nullptr)) {
+  if (!do_range && ((opt_stop != nullptr) || (opt_start != nullptr))) {
     if (opt_start != nullptr) {
       opts--;
     }
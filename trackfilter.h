@@ -178,7 +178,6 @@ private:
   int trackfilter_opt_count();
   qint64 trackfilter_parse_time_opt(const char* arg);
   static bool trackfilter_init_sort_cb(const route_head* ha, const route_head* hb);
-  static bool trackfilter_merge_sort_cb(const Waypoint* wa, const Waypoint* wb);
   fix_type trackfilter_parse_fix(int* nsats);
   static QDateTime trackfilter_get_first_time(const route_head* track);
   static QDateTime trackfilter_get_last_time(const route_head* track);
@@ -196,11 +195,8 @@ private:
 
   void trackfilter_split();
 
-  void trackfilter_move();
-
-  void trackfilter_synth();
-
   QDateTime trackfilter_range_check(const char* timestr);
+  static bool trackfilter_range_inside(const Waypoint* wpt, const QDateTime& start, const QDateTime& stop);
   void trackfilter_range();
 
   void trackfilter_seg2trk();
@@ -214,11 +210,12 @@ private:
   };
 
   faketime_t trackfilter_faketime_check(const char* timestr);
-  void trackfilter_faketime();             /* returns number of track points left after filtering */
   bool trackfilter_points_are_same(const Waypoint* wpta, const Waypoint* wptb);
 
   void trackfilter_segment_head(const route_head* rte);
 
+  void trackfilter_points(bool do_range);
+
 };
 
 #endif // FILTERS_ENABLED
@@ -240,28 +240,28 @@ static field_t fields_def[] = {
   { nullptr,		fld_terminator, 0 }
 };
 
-static QVector<field_e> unicsv_fields_tab;
-static double unicsv_altscale, unicsv_depthscale, unicsv_proximityscale
+static thread_local QVector<field_e> unicsv_fields_tab;
+static thread_local double unicsv_altscale, unicsv_depthscale, unicsv_proximityscale
 ;
-static const char* unicsv_fieldsep;
-static gbfile* fin, *fout;
-static gpsdata_type unicsv_data_type;
-static route_head* unicsv_track, *unicsv_route;
-static char unicsv_outp_flags[(fld_terminator + 8) / 8];
-static grid_type unicsv_grid_idx;
-static int unicsv_datum_idx;
-static char* opt_datum;
-static char* opt_grid;
-static char* opt_utc;
-static char* opt_filename;
-static char* opt_format;
-static char* opt_prec;
-static char* opt_fields;
-static int unicsv_waypt_ct;
-static char unicsv_detect;
-static int llprec;
-
-static arglist_t unicsv_args[] = {
+static thread_local const char* unicsv_fieldsep;
+static thread_local gbfile* fin, *fout;
+static thread_local gpsdata_type unicsv_data_type;
+static thread_local route_head* unicsv_track, *unicsv_route;
+static thread_local char unicsv_outp_flags[(fld_terminator + 8) / 8];
+static thread_local grid_type unicsv_grid_idx;
+static thread_local int unicsv_datum_idx;
+static thread_local char* opt_datum;
+static thread_local char* opt_grid;
+static thread_local char* opt_utc;
+static thread_local char* opt_filename;
+static thread_local char* opt_format;
+static thread_local char* opt_prec;
+static thread_local char* opt_fields;
+static thread_local int unicsv_waypt_ct;
+static thread_local char unicsv_detect;
+static thread_local int llprec;
+
+static thread_local arglist_t unicsv_args[] = {
   {
     "datum", &opt_datum, "GPS datum (def. WGS 84)",
     "WGS 84", ARGTYPE_STRING, ARG_NOMINMAX, nullptr
@@ -348,7 +348,7 @@ unicsv_parse_date(const char* str, int* consumed)
       *consumed = 0;	/* for a possible date */
       return 0;
     }
-    Fatal() << MYNAME << ": Could not parse date string (" << str << ").\n";
+    fatal(FatalMsg() << MYNAME << ": Could not parse date string (" << str << ").\n");
   }
 
   if ((p1 > 99) || (sep[0] == '-')) { /* Y-M-D (iso like) */
@@ -377,7 +377,7 @@ unicsv_parse_date(const char* str, int* consumed)
       *consumed = 0;
       return 0;	/* don't stop here */
     }
-    Fatal() << MYNAME << ": Could not parse date string (" << str << ").\n";
+    fatal(FatalMsg() << MYNAME << ": Could not parse date string (" << str << ").\n");
   }
 
   tm.tm_year -= 1900;
@@ -451,7 +451,8 @@ unicsv_adjust_time(const time_t time, const time_t* date)
   if (opt_utc) {
     res += atoi(opt_utc) * SECONDS_PER_HOUR;
   } else {
-    struct tm tm = *gmtime(&res);
+    struct tm tm;
+    gb_gmtime_r(&res, &tm);
     res = mklocaltime(&tm);
   }
   return QDateTime::fromTime_t(res);
@@ -698,11 +699,11 @@ unicsv_parse_one_line(char* ibuf)
       break;
 
     case fld_description:
-      wpt->description = s;
+      wpt->SetDescription(s);
       break;
 
     case fld_notes:
-      wpt->notes = s;
+      wpt->SetNotes(s);
       break;
 
     case fld_url: {
@@ -904,7 +905,7 @@ unicsv_parse_one_line(char* ibuf)
       break;
 
     case fld_symbol:
-      wpt->icon_descr = s;
+      wpt->SetIconDescr(s);
       break;
 
     case fld_iso_time:
@@ -1107,7 +1108,7 @@ unicsv_parse_one_line(char* ibuf)
 
       if (is_localtime) {
         struct tm tm;
-        tm = *gmtime(&t);
+        gb_gmtime_r(&t, &tm);
         if (opt_utc) {
           wpt->SetCreationTime(mkgmtime(&tm));
         } else {
@@ -1302,14 +1303,14 @@ unicsv_waypt_enum_cb(const Waypoint* wpt)
   if (wpt->altitude != unknown_alt) {
     gb_setbit(&unicsv_outp_flags, fld_altitude);
   }
-  if (!wpt->icon_descr.isNull()) {
+  if (!wpt->GetIconDescr().isNull()) {
     gb_setbit(&unicsv_outp_flags, fld_symbol);
   }
-  if (!wpt->description.isEmpty() && shortname != wpt->description) {
+  if (!wpt->GetDescription().isEmpty() && shortname != wpt->GetDescription()) {
     gb_setbit(&unicsv_outp_flags, fld_description);
   }
-  if (!wpt->notes.isEmpty() && shortname != wpt->notes) {
-    if ((wpt->description.isEmpty()) || (wpt->description != wpt->notes)) {
+  if (!wpt->GetNotes().isEmpty() && shortname != wpt->GetNotes()) {
+    if ((wpt->GetDescription().isEmpty()) || (wpt->GetDescription() != wpt->GetNotes())) {
       gb_setbit(&unicsv_outp_flags, fld_notes);
     }
   }
@@ -1545,13 +1546,13 @@ unicsv_waypt_disp_cb(const Waypoint* wpt)
     }
   }
   if FIELD_USED(fld_description) {
-    unicsv_print_str(wpt->description);
+    unicsv_print_str(wpt->GetDescription());
   }
   if FIELD_USED(fld_notes) {
-    unicsv_print_str(wpt->notes);
+    unicsv_print_str(wpt->GetNotes());
   }
   if FIELD_USED(fld_symbol) {
-    unicsv_print_str(wpt->icon_descr.isNull() ? "Waypoint" : wpt->icon_descr);
+    unicsv_print_str(wpt->GetIconDescr().isNull() ? "Waypoint" : wpt->GetIconDescr());
   }
   if FIELD_USED(fld_depth) {
     if WAYPT_HAS(wpt, depth) {
@@ -1896,8 +1897,8 @@ static void
 unicsv_check_modes(bool test)
 {
   if (test) {
-    Fatal() << MYNAME <<
-            " : Invalid combination of -w, -t, -r selected. Use only one.";
+    fatal(FatalMsg() << MYNAME <<
+            " : Invalid combination of -w, -t, -r selected. Use only one.");
   }
 }
 
@@ -1920,7 +1921,7 @@ unicsv_wr()
     route_disp_all(nullptr, nullptr, unicsv_waypt_enum_cb);
     break;
   case posndata:
-    Fatal() << MYNAME << ": Realtime positioning not supported.";
+    fatal(FatalMsg() << MYNAME << ": Realtime positioning not supported.");
   }
 
   gbfprintf(fout, "No%s", unicsv_fieldsep);
@@ -2105,7 +2106,7 @@ unicsv_wr()
 
 /* --------------------------------------------------------------------------- */
 
-ff_vecs_t unicsv_vecs = {
+thread_local ff_vecs_t unicsv_vecs = {
   ff_type_file,
   FF_CAP_RW_ALL,
   unicsv_rd_init,
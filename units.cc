@@ -21,7 +21,7 @@
 
 #include "defs.h"
 
-static int units = units_statute;
+static thread_local int units = units_statute;
 
 int
 fmt_setunits(fmt_units u)
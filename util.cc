@@ -708,7 +708,7 @@ mklocaltime(struct tm* t)
 
   check.tm_isdst = 0;
   result = mktime(&check);
-  check = *localtime(&result);
+  gb_localtime_r(&result, &check);
   if (check.tm_isdst == 1) {	/* DST is in effect */
     check = *t;
     check.tm_isdst = 1;
@@ -717,6 +717,41 @@ mklocaltime(struct tm* t)
   return result;
 }
 
+/*
+ * gmtime() and localtime() that fill in *result instead of a buffer shared
+ * by all threads.  The Microsoft C runtime already keeps that buffer per
+ * thread.
+ */
+struct tm*
+gb_gmtime_r(const time_t* t, struct tm* result)
+{
+#if __WIN32__
+  struct tm* tm = gmtime(t);
+  if (tm == nullptr) {
+    return nullptr;
+  }
+  *result = *tm;
+  return result;
+#else
+  return gmtime_r(t, result);
+#endif
+}
+
+struct tm*
+gb_localtime_r(const time_t* t, struct tm* result)
+{
+#if __WIN32__
+  struct tm* tm = localtime(t);
+  if (tm == nullptr) {
+    return nullptr;
+  }
+  *result = *tm;
+  return result;
+#else
+  return localtime_r(t, result);
+#endif
+}
+
 /*
  * Historically, when we were C, this was A wrapper for time(2) that
  * allowed us to "freeze" time for testing. The UNIX epoch
@@ -356,7 +356,7 @@ v900_read()
         strcpy(vox_file_name,vox);
         strcat(vox_file_name,".WAV");
         wpt2->shortname = vox_file_name;
-        wpt2->description = vox_file_name;
+        wpt2->SetDescription(vox_file_name);
         waypt_add_url(wpt2, vox_file_name, vox_file_name);
       }
       waypt_add(wpt2);
@@ -20,11 +20,15 @@
  */
 
 #include "defs.h"
+#include "context.h"
 #include "csv_util.h"
 #include "gbversion.h"
 #include "inifile.h"
 #include "xcsv.h"
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
 #include <QtCore/QString>
+#include <QtCore/QVector>
 #include <cstdio>
 #include <cstdlib> // qsort
 
@@ -65,7 +69,7 @@ extern ff_vecs_t gpl_vecs;
 extern ff_vecs_t gpssim_vecs;
 extern ff_vecs_t gpspilot_vecs;
 extern ff_vecs_t gpsutil_vecs;
-extern ff_vecs_t gpx_vecs;
+extern thread_local ff_vecs_t gpx_vecs;
 extern ff_vecs_t gtm_vecs;
 extern ff_vecs_t hiketech_vecs;
 extern ff_vecs_t holux_vecs;
@@ -74,7 +78,7 @@ extern ff_vecs_t html_vecs;
 extern ff_vecs_t igc_vecs;
 extern ff_vecs_t ignr_vecs;
 extern ff_vecs_t igo8_vecs;
-extern ff_vecs_t kml_vecs;
+extern thread_local ff_vecs_t kml_vecs;
 extern ff_vecs_t lowranceusr_vecs;
 extern ff_vecs_t mag_fvecs;
 extern ff_vecs_t maggeo_vecs;
@@ -91,7 +95,7 @@ extern ff_vecs_t mtk_locus_vecs;
 extern ff_vecs_t mynav_vecs;
 extern ff_vecs_t navicache_vecs;
 extern ff_vecs_t netstumbler_vecs;
-extern ff_vecs_t nmea_vecs;
+extern thread_local ff_vecs_t nmea_vecs;
 extern ff_vecs_t nmn4_vecs;
 extern ff_vecs_t ozi_vecs;
 extern ff_vecs_t palmdoc_vecs;
@@ -117,11 +121,11 @@ extern ff_vecs_t tomtom_vecs;
 extern ff_vecs_t tpg_vecs;
 extern ff_vecs_t tpo2_vecs;
 extern ff_vecs_t tpo3_vecs;
-extern ff_vecs_t unicsv_vecs;
+extern thread_local ff_vecs_t unicsv_vecs;
 extern ff_vecs_t vcf_vecs;
 extern ff_vecs_t vitosmt_vecs;
 extern ff_vecs_t wfff_xml_vecs;
-extern ff_vecs_t xcsv_vecs;
+extern thread_local ff_vecs_t xcsv_vecs;
 extern ff_vecs_t yahoo_vecs;
 extern ff_vecs_t wbt_svecs;
 extern ff_vecs_t wbt_fvecs;
@@ -181,7 +185,7 @@ extern ff_vecs_t mapbar_track_vecs;
 extern ff_vecs_t f90g_track_vecs;
 extern ff_vecs_t mapfactor_vecs;
 
-static
+static thread_local
 vecs_t vec_list[] = {
 #if CSVFMTS_ENABLED
   /* XCSV must be the first entry in this table. */
@@ -1096,51 +1100,63 @@ vecs_t vec_list[] = {
   }
 };
 
-void
-init_vecs()
+/*
+ * The formats find_vec() has handed out.  Only these have options to
+ * release and an exit routine worth calling, so a run that uses two
+ * formats doesn't have to visit all of vec_list on the way out.
+ */
+static thread_local QVector<ff_vecs_t*> selected_vecs;
+
+int
+is_integer(const char* c)
 {
-  vecs_t* vec = vec_list;
-  while (vec->vec) {
-    if (vec->vec->args) {
-      for (auto ap = vec->vec->args; ap->argstring; ap++) {
-        ap->argvalptr = nullptr;
-        if (ap->argval) {
-          *ap->argval = nullptr;
-        }
+  return isdigit(c[0]) || ((c[0] == '+' || c[0] == '-') && isdigit(c[1]));
+}
+
+static void
+exit_vec(ff_vecs_t* vec)
+{
+  if (vec->exit) {
+    (*vec->exit)();
+  }
+  if (vec->args) {
+    for (auto ap = vec->args; ap->argstring; ap++) {
+      if (ap->defaultvalue &&
+          (ap->argtype == ARGTYPE_INT) &&
+          ! is_integer(ap->defaultvalue)) {
+        warning("%s: not an integer\n", ap->argstring);
+      }
+      if (ap->argvalptr) {
+        xfree(ap->argvalptr);
+        *ap->argval = ap->argvalptr = nullptr;
       }
     }
-    vec++;
   }
 }
 
-int
-is_integer(const char* c)
+void
+exit_vecs()
 {
-  return isdigit(c[0]) || ((c[0] == '+' || c[0] == '-') && isdigit(c[1]));
+  for (auto vec : selected_vecs) {
+    exit_vec(vec);
+  }
+  selected_vecs.clear();
 }
 
+/*
+ * exit_vecs() for the formats whose state is thread local, so that the
+ * next conversion on this thread starts afresh.  See context.h.
+ */
 void
-exit_vecs()
+exit_thread_vecs()
 {
-  vecs_t* vec = vec_list;
-  while (vec->vec) {
-    if (vec->vec->exit) {
-      (*vec->vec->exit)();
-    }
-    if (vec->vec->args) {
-      for (auto ap = vec->vec->args; ap->argstring; ap++) {
-        if (ap->defaultvalue &&
-            (ap->argtype == ARGTYPE_INT) &&
-            ! is_integer(ap->defaultvalue)) {
-          warning("%s: not an integer\n", ap->argstring);
-        }
-        if (ap->argvalptr) {
-          xfree(ap->argvalptr);
-          *ap->argval = ap->argvalptr = nullptr;
-        }
-      }
+  for (auto it = selected_vecs.begin(); it != selected_vecs.end();) {
+    if (ConversionContext::is_reentrant((*it)->name)) {
+      exit_vec(*it);
+      it = selected_vecs.erase(it);
+    } else {
+      ++it;
     }
-    vec++;
   }
 }
 
@@ -1247,69 +1263,84 @@ disp_vec_options(const char* vecname, arglist_t* ap)
   }
 }
 
+/*
+ * Give each option of the selected format its value from the command
+ * line, the inifile or its default, and note the format as in use.
+ */
+static void
+select_vec(ff_vecs_t* vec, const char* module, const char* svecname,
+           const char* vecname, const char** opts)
+{
+  int found = 0;
+  const char* res = strchr(vecname, ',');
+
+  if (res) {
+    *opts = res + 1;
+  } else {
+    *opts = nullptr;
+  }
+
+  if (vec->args) {
+    for (auto ap = vec->args; ap->argstring; ap++) {
+      if (res) {
+        const char* opt = get_option(*opts, ap->argstring);
+        if (opt) {
+          found = 1;
+          assign_option(svecname, ap, opt);
+          xfree(opt);
+          continue;
+        }
+      }
+      QString qopt;
+      if (global_opts.inifile != nullptr) {
+        qopt = inifile_readstr(global_opts.inifile, module, ap->argstring);
+        if (qopt.isNull()) {
+          qopt = inifile_readstr(global_opts.inifile, "Common format settings", ap->argstring);
+        }
+      }
+      if (qopt.isNull()) {
+        assign_option(module, ap, ap->defaultvalue);
+      } else {
+        assign_option(module, ap, CSTR(qopt));
+      }
+    }
+  }
+
+  if (opts && opts[0] && !found) {
+    warning("'%s' is an unknown option to %s.\n", *opts, module);
+  }
+
+  if (global_opts.debug_level >= 1) {
+    disp_vec_options(module, vec->args);
+  }
+
+  vec->name = module;	/* needed for session information */
+  if (!selected_vecs.contains(vec)) {
+    selected_vecs.append(vec);
+  }
+}
+
 ff_vecs_t*
 find_vec(const char* vecname, const char** opts)
 {
   vecs_t* vec = vec_list;
   style_vecs_t* svec = style_list;
-  char* v = xstrdup(vecname);
-  char* svecname = strtok(v, ",");
-  int found = 0;
 
   if (vecname == nullptr) {
     fatal("A format name is required.\n");
   }
 
+  /* The name ends at the first comma, select_vec() takes the options from there. */
+  const QByteArray svecname = QByteArray(vecname).split(',').first();
+
   while (vec->vec) {
-    if (case_ignore_strcmp(svecname, vec->name)) {
+    if (case_ignore_strcmp(svecname.constData(), vec->name)) {
       vec++;
       continue;
     }
 
-    const char* res = strchr(vecname, ',');
-    if (res) {
-      *opts = strchr(vecname, ',')+1;
-    } else {
-      *opts = nullptr;
-    }
-
-    if (vec->vec->args) {
-      for (auto ap = vec->vec->args; ap->argstring; ap++) {
-        if (res) {
-          const char* opt = get_option(*opts, ap->argstring);
-          if (opt) {
-            found = 1;
-            assign_option(svecname, ap, opt);
-            xfree(opt);
-            continue;
-          }
-        }
-        QString qopt = inifile_readstr(global_opts.inifile, vec->name, ap->argstring);
-        if (qopt.isNull()) {
-          qopt = inifile_readstr(global_opts.inifile, "Common format settings", ap->argstring);
-        }
-        if (qopt.isNull()) {
-          assign_option(vec->name, ap, ap->defaultvalue);
-        } else {
-          assign_option(vec->name, ap, CSTR(qopt));
-        }
-      }
-    }
-    if (opts && opts[0] && !found) {
-      warning("'%s' is an unknown option to %s.\n", *opts, vec->name);
-    }
-
-    if (global_opts.debug_level >= 1) {
-      disp_vec_options(vec->name, vec->vec->args);
-    }
-
-#if CSVFMTS_ENABLED
-    // xcsv_setup_internal_style( NULL );
-#endif // CSVFMTS_ENABLED
-    xfree(v);
-    vec->vec->name = vec->name;	/* needed for session information */
+    select_vec(vec->vec, vec->name, svecname.constData(), vecname, opts);
     return vec->vec;
-
   }
 
   /*
@@ -1317,61 +1348,22 @@ find_vec(const char* vecname, const char** opts)
    * is to search the list of xcsv styles.
    */
   while (svec->name) {
-    if (case_ignore_strcmp(svecname, svec->name)) {
+    if (case_ignore_strcmp(svecname.constData(), svec->name)) {
       svec++;
       continue;
     }
 
-    const char* res = strchr(vecname, ',');
-    if (res) {
-      *opts = strchr(vecname, ',') + 1;
-    } else {
-      *opts = nullptr;
-    }
-
-    if (vec_list[0].vec->args) {
-      for (auto ap = vec_list[0].vec->args; ap->argstring; ap++) {
-        if (res) {
-          const char* opt = get_option(*opts, ap->argstring);
-          if (opt) {
-            found = 1;
-            assign_option(svecname, ap, opt);
-            xfree(opt);
-            continue;
-          }
-        }
-        QString qopt = inifile_readstr(global_opts.inifile, svec->name, ap->argstring);
-        if (qopt.isNull()) {
-          qopt = inifile_readstr(global_opts.inifile, "Common format settings", ap->argstring);
-        }
-        if (qopt.isNull()) {
-          assign_option(svec->name, ap, ap->defaultvalue);
-        } else {
-          assign_option(svec->name, ap, CSTR(qopt));
-        }
-      }
-    }
-
-    if (opts && opts[0] && !found) {
-      warning("'%s' is an unknown option to %s.\n", *opts, svec->name);
-    }
-
-    if (global_opts.debug_level >= 1) {
-      disp_vec_options(svec->name, vec_list[0].vec->args);
-    }
+    select_vec(vec_list[0].vec, svec->name, svecname.constData(), vecname, opts);
 #if CSVFMTS_ENABLED
     xcsv_setup_internal_style(svec->style_buf);
 #endif // CSVFMTS_ENABLED
 
-    xfree(v);
-    vec_list[0].vec->name = svec->name;	/* needed for session information */
     return vec_list[0].vec;
   }
 
   /*
    * Not found.
    */
-  xfree(v);
   return nullptr;
 }
 
@@ -1382,42 +1374,29 @@ find_vec(const char* vecname, const char** opts)
 char*
 get_option(const char* iarglist, const char* argname)
 {
-  const size_t arglen = strlen(argname);
-  char* rval = nullptr;
-  char* argp;
+  const int arglen = strlen(argname);
 
   if (!iarglist) {
     return nullptr;
   }
 
-  char* arglist = xstrdup(iarglist);
-
-  for (char* arg = arglist; argp = strtok(arg, ","), nullptr != argp; arg = nullptr) {
-    if (0 == case_ignore_strncmp(argp, argname, arglen)) {
+  /* Not strtok(), conversions in other threads look up options too. */
+  const QList<QByteArray> args = QByteArray(iarglist).split(',');
+  for (const auto& arg : args) {
+    if (0 == case_ignore_strncmp(arg.constData(), argname, arglen)) {
       /*
        * If we have something of the form "foo=bar"
        * return "bar".   Otherwise, we assume we have
        * simply "foo" so we return that.
        */
-      if (argp[arglen] == '=') {
-        rval = argp + arglen + 1;
-        break;
-      } else if (argp[arglen] == '\0') {
-        rval = argp;
-        break;
+      if (arg.size() > arglen && arg.at(arglen) == '=') {
+        return xstrdup(arg.constData() + arglen + 1);
+      } else if (arg.size() == arglen) {
+        return xstrdup(arg.constData());
       }
     }
   }
-  /*
-   * Return an offset into the allocated copy.
-   * The caller mustn't free or otherwise get froggy with
-   * this data.
-   */
-  if (rval) {
-    rval = xstrdup(rval);
-  }
-  xfree(arglist);
-  return rval;
+  return nullptr;
 }
 
 /*
@@ -20,12 +20,15 @@
  */
 
 #include <cmath>                // for fabs
+#include <cstddef>              // for offsetof
 #include <cstdio>               // for printf, fflush, fprintf, stdout
 #include <ctime>                // for time_t
+#include <type_traits>          // for is_standard_layout
 
 #include <QtCore/QByteArray>    // for QByteArray
 #include <QtCore/QDateTime>     // for QDateTime
 #include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer> // for QElapsedTimer
 #include <QtCore/QList>         // for QList
 #include <QtCore/QString>       // for QString, operator==
 #include <QtCore/QTime>         // for QTime
@@ -34,23 +37,33 @@
 #include "defs.h"
 #include "garmin_fs.h"          // for garmin_ilink_t, garmin_fs_s, GMSD_FIND, garmin_fs_p
 #include "grtcirc.h"            // for RAD, gcdist, heading_true_degrees, radtometers
+#include "progress.h"           // for progress_point, progress_due
 #include "queue.h"              // for queue, QUEUE_INIT, dequeue, QUEUE_FOR_EACH, QUEUE_MOVE, ENQUEUE_TAIL
 #include "session.h"            // for curr_session, session_t
 #include "src/core/datetime.h"  // for DateTime
-#include "src/core/logging.h"   // for Warning, Fatal
+#include "src/core/logging.h"   // for WarningMsg, FatalMsg
 
 #if NEWQ
-QList<Waypoint*> waypt_list;
-queue waypt_head; // This is here solely to freak out the formats that are
+thread_local QList<Waypoint*> waypt_list;
+thread_local queue waypt_head; // This is here solely to freak out the formats that are
 // looking into what should be a private members.
 #else
-queue waypt_head;
+thread_local queue waypt_head;
 #endif
 
-static unsigned int waypt_ct;
-static short_handle mkshort_handle;
+static thread_local unsigned int waypt_ct;
+static thread_local short_handle mkshort_handle;
 geocache_data Waypoint::empty_gc_data;
-static global_trait traits;
+const waypoint_text Waypoint::empty_text;
+
+// The members that filters and track_recompute() read for every point
+// follow Q and should span no more than a cache line.
+static_assert(std::is_standard_layout<Waypoint>::value,
+              "Waypoint must have a standard layout for offsetof");
+static_assert(offsetof(Waypoint, odometer_distance) + sizeof(float) -
+              offsetof(Waypoint, latitude) <= 64,
+              "the Waypoint members used when walking a track outgrew a cache line");
+static thread_local global_trait traits;
 
 const global_trait* get_traits()
 {
@@ -61,6 +74,7 @@ void
 waypt_init()
 {
   mkshort_handle = mkshort_new_handle();
+  traits = global_trait();
 #if NEWQ
   waypt_list.clear();
 #else
@@ -95,7 +109,7 @@ waypt_add(Waypoint* wpt)
   ENQUEUE_TAIL(&waypt_head, &wpt->Q);
   waypt_ct++;
 #endif
-
+  progress_point();
 
   if (wpt->latitude < -90) {
     wpt->latitude += 180;
@@ -109,12 +123,12 @@ waypt_add(Waypoint* wpt)
   }
 
   if ((wpt->latitude < -90) || (wpt->latitude > 90.0))
-    Fatal() << wpt->session->name
+    fatal(FatalMsg() << wpt->session->name
             << "Invalid latitude" << lat_orig << "in waypoint"
-            << wpt->shortname;
+            << wpt->shortname);
   if ((wpt->longitude < -180) || (wpt->longitude > 180.0))
-    Fatal() << "Invalid longitude" << lon_orig << "in waypoint"
-            << wpt->shortname;
+    fatal(FatalMsg() << "Invalid longitude" << lon_orig << "in waypoint"
+            << wpt->shortname);
 
   /*
    * Some input may not have one or more of these types so we
@@ -125,10 +139,10 @@ waypt_add(Waypoint* wpt)
   // Note tests for isNull here as some formats intentionally set "".
   // This is kind of goofy, but it emulates the C string implementation.
   if (wpt->shortname.isNull()) {
-    if (!wpt->description.isNull()) {
-      wpt->shortname = wpt->description;
-    } else if (!wpt->notes.isNull()) {
-      wpt->shortname = wpt->notes;
+    if (!wpt->GetDescription().isNull()) {
+      wpt->shortname = wpt->GetDescription();
+    } else if (!wpt->GetNotes().isNull()) {
+      wpt->shortname = wpt->GetNotes();
     } else {
       QString n;
       n.sprintf("%03d", waypt_count());
@@ -136,12 +150,12 @@ waypt_add(Waypoint* wpt)
     }
   }
 
-  if (wpt->description.isEmpty()) {
-    if (!wpt->notes.isNull()) {
-      wpt->description = wpt->notes;
+  if (wpt->GetDescription().isEmpty()) {
+    if (!wpt->GetNotes().isNull()) {
+      wpt->SetDescription(wpt->GetNotes());
     } else {
       if (!wpt->shortname.isNull()) {
-        wpt->description = wpt->shortname;
+        wpt->SetDescription(wpt->shortname);
       }
     }
   }
@@ -172,6 +186,29 @@ waypt_count()
 #endif
 }
 
+/* The waypoints of session |se|, or all of them if it is nullptr. */
+unsigned int
+waypt_session_count(const session_t* se)
+{
+  if (se == nullptr) {
+    return waypt_count();
+  }
+
+  unsigned int ct = 0;
+#if NEWQ
+  foreach (const Waypoint* waypointp, waypt_list) {
+#else
+  queue* elem, *tmp;
+  QUEUE_FOR_EACH(&waypt_head, elem, tmp) {
+    const Waypoint* waypointp = reinterpret_cast<Waypoint *>(elem);
+#endif
+    if (waypointp->session == se) {
+      ct++;
+    }
+  }
+  return ct;
+}
+
 void
 set_waypt_count(unsigned int nc)
 {
@@ -181,17 +218,17 @@ set_waypt_count(unsigned int nc)
 void
 waypt_disp(const Waypoint* wpt)
 {
-  if (wpt->GetCreationTime().isValid()) {
-    printf("%s ", qPrintable(wpt->creation_time.toString()));
+  if (wpt->creation_time.isValid()) {
+    printf("%s ", qPrintable(wpt->GetCreationTime().toString()));
   }
   printposn(wpt->latitude,1);
   printposn(wpt->longitude,0);
-  if (!wpt->description.isEmpty()) {
+  if (!wpt->GetDescription().isEmpty()) {
     printf("%s/%s",
            global_opts.synthesize_shortnames ?
-           qPrintable(mkshort(mkshort_handle, wpt->description)) :
+           qPrintable(mkshort(mkshort_handle, wpt->GetDescription())) :
            qPrintable(wpt->shortname),
-           qPrintable(wpt->description));
+           qPrintable(wpt->GetDescription()));
   }
 
   if (wpt->altitude != unknown_alt) {
@@ -203,6 +240,12 @@ waypt_disp(const Waypoint* wpt)
 void
 waypt_status_disp(int total_ct, int myct)
 {
+  static thread_local QElapsedTimer timer;
+
+  /* Drawing every point can take longer than writing it. */
+  if ((myct < total_ct) && !progress_due(timer)) {
+    return;
+  }
   fprintf(stdout, "%d/%d/%d\r", myct*100/total_ct, myct, total_ct);
   fflush(stdout);
 }
@@ -572,36 +615,38 @@ Waypoint::Waypoint() :
   latitude(0),  // These should probably use some invalid data, but
   longitude(0), // it looks like we have code that relies on them being zero.
   altitude(unknown_alt),
-  geoidheight(0),
-  depth(0),
-  proximity(0),
-  route_priority(0),
-  hdop(0),
-  vdop(0),
-  pdop(0),
   course(0),
   speed(0),
-  fix(fix_unknown),
-  sat(-1),
   heartrate(0),
   cadence(0),
   power(0),
   temperature(0),
   odometer_distance(0),
+  hdop(0),
+  vdop(0),
+  pdop(0),
+  fix(fix_unknown),
+  sat(-1),
+  route_priority(0),
+  geoidheight(0),
+  depth(0),
+  proximity(0),
   gc_data(&Waypoint::empty_gc_data),
   fs(nullptr),
   session(curr_session()),
-  extra_data(nullptr)
+  extra_data(nullptr),
+  text(nullptr)
 {
   QUEUE_INIT(&Q);
 }
 
 Waypoint::~Waypoint()
 {
-  if (gc_data != &Waypoint::empty_gc_data) {
+  if ((gc_data != &Waypoint::empty_gc_data) && !gc_data->ref.deref()) {
     delete gc_data;
   }
   fs_chain_destroy(fs);
+  delete text;
 }
 
 Waypoint::Waypoint(const Waypoint& other) :
@@ -609,37 +654,35 @@ Waypoint::Waypoint(const Waypoint& other) :
   latitude(other.latitude),
   longitude(other.longitude),
   altitude(other.altitude),
-  geoidheight(other.geoidheight),
-  depth(other.depth),
-  proximity(other.proximity),
-  shortname(other.shortname),
-  description(other.description),
-  notes(other.notes),
-  urls(other.urls),
-  wpt_flags(other.wpt_flags),
-  icon_descr(other.icon_descr),
   creation_time(other.creation_time),
-  route_priority(other.route_priority),
-  hdop(other.hdop),
-  vdop(other.vdop),
-  pdop(other.pdop),
   course(other.course),
   speed(other.speed),
-  fix(other.fix),
-  sat(other.sat),
+  wpt_flags(other.wpt_flags),
   heartrate(other.heartrate),
   cadence(other.cadence),
   power(other.power),
   temperature(other.temperature),
   odometer_distance(other.odometer_distance),
+  hdop(other.hdop),
+  vdop(other.vdop),
+  pdop(other.pdop),
+  fix(other.fix),
+  sat(other.sat),
+  route_priority(other.route_priority),
+  geoidheight(other.geoidheight),
+  depth(other.depth),
+  proximity(other.proximity),
+  shortname(other.shortname),
   gc_data(other.gc_data),
   fs(other.fs),
   session(other.session),
-  extra_data(other.extra_data)
+  extra_data(other.extra_data),
+  text(other.text ? new waypoint_text(*other.text) : nullptr)
 {
-  // deep copy geocache data unless it is the specail static empty_gc_data.
-  if (other.gc_data != &Waypoint::empty_gc_data) {
-    gc_data = new geocache_data(*other.gc_data);
+  // share geocache data unless it is the special static empty_gc_data.
+  // It is copied on write by AllocGCData().
+  if (gc_data != &Waypoint::empty_gc_data) {
+    gc_data->ref.ref();
   }
 
   /*
@@ -659,8 +702,14 @@ Waypoint& Waypoint::operator=(const Waypoint& rhs)
 {
   if (this != &rhs) {
 
+    // share geocache data unless it is the special static empty_gc_data.
+    // Take our reference before dropping the old one in case they are
+    // the same object.
+    if (rhs.gc_data != &Waypoint::empty_gc_data) {
+      rhs.gc_data->ref.ref();
+    }
     // deallocate
-    if (gc_data != &Waypoint::empty_gc_data) {
+    if ((gc_data != &Waypoint::empty_gc_data) && !gc_data->ref.deref()) {
       delete gc_data;
     }
     fs_chain_destroy(fs);
@@ -674,11 +723,7 @@ Waypoint& Waypoint::operator=(const Waypoint& rhs)
     depth = rhs.depth;
     proximity = rhs.proximity;
     shortname = rhs.shortname;
-    description = rhs.description;
-    notes = rhs.notes;
-    urls = rhs.urls;
     wpt_flags = rhs.wpt_flags;
-    icon_descr = rhs.icon_descr;
     creation_time = rhs.creation_time;
     route_priority = rhs.route_priority;
     hdop = rhs.hdop;
@@ -697,9 +742,15 @@ Waypoint& Waypoint::operator=(const Waypoint& rhs)
     fs = rhs.fs;
     session = rhs.session;
     extra_data = rhs.extra_data;
-    // deep copy geocache data unless it is the specail static empty_gc_data.
-    if (rhs.gc_data != &Waypoint::empty_gc_data) {
-      gc_data = new geocache_data(*rhs.gc_data);
+    if (rhs.text) {
+      if (text) {
+        *text = *rhs.text;
+      } else {
+        text = new waypoint_text(*rhs.text);
+      }
+    } else {
+      delete text;
+      text = nullptr;
     }
 
     /*
@@ -721,25 +772,95 @@ Waypoint& Waypoint::operator=(const Waypoint& rhs)
 bool
 Waypoint::HasUrlLink() const
 {
-  return urls.HasUrlLink();
+  return text && text->urls.HasUrlLink();
 }
 
 const UrlLink&
 Waypoint::GetUrlLink() const
 {
-  return urls.GetUrlLink();
+  return GetUrlList().GetUrlLink();
 }
 
 [[deprecated]] const QList<UrlLink>
 Waypoint::GetUrlLinks() const
 {
-  return urls;
+  return GetUrlList();
+}
+
+const UrlList&
+Waypoint::GetUrlList() const
+{
+  return text ? text->urls : empty_text.urls;
 }
 
 void
 Waypoint::AddUrlLink(const UrlLink& l)
 {
-  urls.AddUrlLink(l);
+  AllocText()->urls.AddUrlLink(l);
+}
+
+void
+Waypoint::ClearUrlLinks()
+{
+  if (text) {
+    text->urls.clear();
+  }
+}
+
+/*
+ * The text setters leave the pointer null for a null string, so a
+ * getter returns a null string for a field that was never set, as
+ * it did when the fields were members.
+ */
+const QString&
+Waypoint::GetDescription() const
+{
+  return text ? text->description : empty_text.description;
+}
+
+void
+Waypoint::SetDescription(const QString& s)
+{
+  if (text || !s.isNull()) {
+    AllocText()->description = s;
+  }
+}
+
+const QString&
+Waypoint::GetNotes() const
+{
+  return text ? text->notes : empty_text.notes;
+}
+
+void
+Waypoint::SetNotes(const QString& s)
+{
+  if (text || !s.isNull()) {
+    AllocText()->notes = s;
+  }
+}
+
+const QString&
+Waypoint::GetIconDescr() const
+{
+  return text ? text->icon_descr : empty_text.icon_descr;
+}
+
+void
+Waypoint::SetIconDescr(const QString& s)
+{
+  if (text || !s.isNull()) {
+    AllocText()->icon_descr = s;
+  }
+}
+
+waypoint_text*
+Waypoint::AllocText()
+{
+  if (!text) {
+    text = new waypoint_text;
+  }
+  return text;
 }
 
 QString
@@ -749,7 +870,7 @@ Waypoint::CreationTimeXML() const
     return nullptr;
   }
 
-  QDateTime dt = GetCreationTime().toUTC();
+  QDateTime dt = QDateTime::fromMSecsSinceEpoch(creation_time.toMSecsSinceEpoch(), Qt::UTC);
 // qDebug() << dt.toString("dd.MM.yyyy hh:mm:ss.zzz")  << " CML " << microseconds;
 
   const char* format = "yyyy-MM-ddTHH:mm:ssZ";
@@ -763,7 +884,7 @@ Waypoint::CreationTimeXML() const
 gpsbabel::DateTime
 Waypoint::GetCreationTime() const
 {
-  return creation_time;
+  return creation_time.toDateTime();
 }
 
 void
@@ -775,7 +896,9 @@ Waypoint::SetCreationTime(const gpsbabel::DateTime& t)
 void
 Waypoint::SetCreationTime(time_t t)
 {
-  creation_time = QDateTime::fromTime_t(t);
+  // As QDateTime::fromTime_t(), which takes an unsigned int: local time.
+  creation_time = gpsbabel::TimeStamp();
+  creation_time.setTime_t(t);
 }
 
 void
@@ -785,11 +908,21 @@ Waypoint::SetCreationTime(time_t t, int ms)
   creation_time = creation_time.addMSecs(ms);
 }
 
+/*
+ * Returns geocache data that is safe to modify, allocating it on first
+ * use and detaching it from any copies of this waypoint that share it.
+ */
 geocache_data*
 Waypoint::AllocGCData()
 {
   if (gc_data == &Waypoint::empty_gc_data) {
     gc_data = new geocache_data;
+    gc_data->ref.ref();
+  } else if (gc_data->ref.load() != 1) {
+    auto* detached = new geocache_data(*gc_data);
+    detached->ref.ref();
+    gc_data->ref.deref();
+    gc_data = detached;
   }
   return gc_data;
 }
@@ -165,7 +165,7 @@ void wfff_e(xg_string, const QXmlStreamAttributes*)
              "%s/%s/WEP %s/Ch %d/%2.0fdB/%2.0fdB/%s",
              snmac?CSTR(ap_ssid):CSTR(ap_mac), CSTR(ap_type), CSTR(ap_wep),
              ap_chan, ap_mnrssi, ap_mxrssi, CSTR(ap_last));
-    wpt_tmp->description = desc;
+    wpt_tmp->SetDescription(desc);
 
     wpt_tmp->latitude = ap_lat;
     wpt_tmp->longitude = ap_lon;
@@ -177,15 +177,15 @@ void wfff_e(xg_string, const QXmlStreamAttributes*)
     QString ap_type_(ap_type);
     if (ap_wep_.startsWith("on", Qt::CaseInsensitive)) {
       if (ap_type_.startsWith("AP", Qt::CaseInsensitive)) {
-        wpt_tmp->icon_descr = aicicon; /* Infra Closed */
+        wpt_tmp->SetIconDescr(aicicon); /* Infra Closed */
       } else {
-        wpt_tmp->icon_descr = ahcicon; /* AdHoc Closed */
+        wpt_tmp->SetIconDescr(ahcicon); /* AdHoc Closed */
       }
     } else {
       if (ap_type_.startsWith("AP", Qt::CaseInsensitive)) {
-        wpt_tmp->icon_descr = aioicon; /* Infra Open */
+        wpt_tmp->SetIconDescr(aioicon); /* Infra Open */
       } else {
-        wpt_tmp->icon_descr = ahoicon;	/* AdHoc Open */
+        wpt_tmp->SetIconDescr(ahoicon);	/* AdHoc Open */
       }
     }
 
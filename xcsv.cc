@@ -28,7 +28,7 @@
 #include <cstdio>                  // for snprintf, sscanf
 #include <cstdlib>                 // for atof, atoi, strtod, atol
 #include <cstring>                 // for strlen, strncmp, strcmp, strncpy, memset
-#include <ctime>                   // for gmtime, localtime, mktime, strftime
+#include <ctime>                   // for mktime, strftime
 
 #include <QtCore/QByteArray>       // for QByteArray
 #include <QtCore/QChar>            // for QChar
@@ -58,7 +58,7 @@
 #include "session.h"               // for session_t
 #include "src/core/datetime.h"     // for DateTime
 #include "src/core/file.h"         // for File
-#include "src/core/logging.h"      // for Warning, Fatal
+#include "src/core/logging.h"      // for WarningMsg, FatalMsg
 #include "src/core/optional.h"     // for optional
 #include "strptime.h"              // for strptime
 #include "xcsv.h"
@@ -180,16 +180,16 @@ typedef enum {
 /* obligatory global struct                                                 */
 /****************************************************************************/
 
-extern char* xcsv_urlbase;
-extern char* prefer_shortnames;
+extern thread_local char* xcsv_urlbase;
+extern thread_local char* prefer_shortnames;
 
-XcsvFile xcsv_file;
-static double pathdist = 0;
-static double oldlon = 999;
-static double oldlat = 999;
+thread_local XcsvFile xcsv_file;
+static thread_local double pathdist = 0;
+static thread_local double oldlon = 999;
+static thread_local double oldlat = 999;
 
-static int waypt_out_count;
-static route_head* csv_track, *csv_route;
+static thread_local int waypt_out_count;
+static thread_local route_head* csv_track, *csv_route;
 
 struct xcsv_parse_data {
   QString rte_name;
@@ -204,18 +204,18 @@ struct xcsv_parse_data {
   gpsbabel_optional::optional<bool> lon_dir_positive;
 };
 
-static char* styleopt = nullptr;
-static char* snlenopt = nullptr;
-static char* snwhiteopt = nullptr;
-static char* snupperopt = nullptr;
-static char* snuniqueopt = nullptr;
-char* prefer_shortnames = nullptr;
-char* xcsv_urlbase = nullptr;
-static char* opt_datum;
+static thread_local char* styleopt = nullptr;
+static thread_local char* snlenopt = nullptr;
+static thread_local char* snwhiteopt = nullptr;
+static thread_local char* snupperopt = nullptr;
+static thread_local char* snuniqueopt = nullptr;
+thread_local char* prefer_shortnames = nullptr;
+thread_local char* xcsv_urlbase = nullptr;
+static thread_local char* opt_datum;
 
-static const char* intstylebuf = nullptr;
+static thread_local const char* intstylebuf = nullptr;
 
-static
+static thread_local
 arglist_t xcsv_args[] = {
   {
     "style", &styleopt, "Full path to XCSV style file", nullptr,
@@ -316,7 +316,7 @@ xcsv_destroy_style()
 static QString
 xcsv_get_char_from_constant_table(const QString& key)
 {
-  static QHash<QString, QString> substitutions;
+  static thread_local QHash<QString, QString> substitutions;
   if (substitutions.empty()) {
     for (char_map_t* cm = xcsv_char_table; !cm->key.isNull(); cm++) {
       substitutions.insert(cm->key, cm->chars);
@@ -377,14 +377,14 @@ XcsvFile::XcsvFile() {
 
 static void validate_fieldmap(const field_map& fmp, bool is_output) {
   if (fmp.key.isEmpty()) {
-    Fatal() << MYNAME << ": xcsv style is missing" <<
-            (is_output ? "output" : "input") << "field type.";
+    fatal(FatalMsg() << MYNAME << ": xcsv style is missing" <<
+            (is_output ? "output" : "input") << "field type.");
   }
   if (fmp.val.isNull()) {
-    Fatal() << MYNAME << ": xcsv style" << fmp.key.constData() << "is missing default.";
+    fatal(FatalMsg() << MYNAME << ": xcsv style" << fmp.key.constData() << "is missing default.");
   }
   if (is_output && fmp.printfc.isNull()) {
-    Fatal() << MYNAME << ": xcsv style" << fmp.key.constData() << "output is missing format specifier.";
+    fatal(FatalMsg() << MYNAME << ": xcsv style" << fmp.key.constData() << "output is missing format specifier.");
   }
 }
 
@@ -513,12 +513,13 @@ static
 QString
 writetime(const char* format, time_t t, bool gmt)
 {
-  static struct tm* stmp;
+  struct tm tm_buf;
+  struct tm* stmp;
 
   if (gmt) {
-    stmp = gmtime(&t);
+    stmp = gb_gmtime_r(&t, &tm_buf);
   } else {
-    stmp = localtime(&t);
+    stmp = gb_localtime_r(&t, &tm_buf);
   }
 
   // It's unfortunate that we publish the definition of "strftime specifiers"
@@ -540,17 +541,18 @@ writetime(const char* format, const gpsbabel::DateTime& t, bool gmt)
 QString
 writehms(const char* format, time_t t, int gmt)
 {
-  static struct tm no_time = tm();
-  static struct tm* stmp = &no_time;
+  struct tm tm_buf;
+  struct tm* stmp;
 
   if (gmt) {
-    stmp = gmtime(&t);
+    stmp = gb_gmtime_r(&t, &tm_buf);
   } else {
-    stmp = localtime(&t);
+    stmp = gb_localtime_r(&t, &tm_buf);
   }
 
   if (stmp == nullptr) {
-    stmp = &no_time;
+    tm_buf = tm();
+    stmp = &tm_buf;
   }
 
   return QString().sprintf(format,
@@ -618,10 +620,10 @@ xcsv_parse_val(const char* s, Waypoint* wpt, const field_map& fmp,
     wpt->shortname = csv_stringtrim(s, enclosure);
     break;
   case XT_DESCRIPTION:
-    wpt->description = csv_stringtrim(s, enclosure);
+    wpt->SetDescription(csv_stringtrim(s, enclosure));
     break;
   case XT_NOTES:
-    wpt->notes = csv_stringtrim(s, "");
+    wpt->SetNotes(csv_stringtrim(s, ""));
     break;
   case XT_URL:
     if (!parse_data->link_) {
@@ -636,7 +638,7 @@ xcsv_parse_val(const char* s, Waypoint* wpt, const field_map& fmp,
     parse_data->link_->url_link_text_ = QString(s).trimmed();
     break;
   case XT_ICON_DESCR:
-    wpt->icon_descr = QString(s).trimmed();
+    wpt->SetIconDescr(QString(s).trimmed());
     break;
 
     /* LATITUDE CONVERSIONS**************************************************/
@@ -1200,11 +1202,11 @@ xcsv_waypt_pr(const Waypoint* wpt)
   QString description;
   QString shortname;
   if (wpt->shortname.isEmpty() || global_opts.synthesize_shortnames) {
-    if (!wpt->description.isEmpty()) {
+    if (!wpt->GetDescription().isEmpty()) {
       if (global_opts.synthesize_shortnames) {
         shortname = mkshort_from_wpt(xcsv_file.mkshort_handle, wpt);
       } else {
-        shortname = csv_stringclean(wpt->description, xcsv_file.badchars);
+        shortname = csv_stringclean(wpt->GetDescription(), xcsv_file.badchars);
       }
     } else {
       /* no shortname available -- let shortname default on output */
@@ -1212,14 +1214,14 @@ xcsv_waypt_pr(const Waypoint* wpt)
   } else {
     shortname = csv_stringclean(wpt->shortname, xcsv_file.badchars);
   }
-  if (wpt->description.isEmpty()) {
+  if (wpt->GetDescription().isEmpty()) {
     if (!shortname.isEmpty()) {
       description = csv_stringclean(shortname, xcsv_file.badchars);
     } else {
       /* no description -- let description default on output */
     }
   } else {
-    description = csv_stringclean(wpt->description, xcsv_file.badchars);
+    description = csv_stringclean(wpt->GetDescription(), xcsv_file.badchars);
   }
 
   if (prefer_shortnames) {
@@ -1281,13 +1283,13 @@ xcsv_waypt_pr(const Waypoint* wpt)
       {
       QString anyname = wpt->shortname;
       if (anyname.isEmpty()) {
-        anyname = mkshort(xcsv_file.mkshort_handle, wpt->description);
+        anyname = mkshort(xcsv_file.mkshort_handle, wpt->GetDescription());
       }
       if (anyname.isEmpty()) {
-        anyname = mkshort(xcsv_file.mkshort_handle, wpt->description);
+        anyname = mkshort(xcsv_file.mkshort_handle, wpt->GetDescription());
       }
       if (anyname.isEmpty()) {
-        anyname = wpt->notes;
+        anyname = wpt->GetNotes();
       }
       if (anyname.isEmpty()) {
         anyname = fmp.val.constData();
@@ -1302,7 +1304,7 @@ xcsv_waypt_pr(const Waypoint* wpt)
       break;
     case XT_NOTES:
       buff = QString().sprintf(fmp.printfc.constData(),
-                wpt->notes.isEmpty() ? fmp.val.constData() : CSTR(wpt->notes));
+                wpt->GetNotes().isEmpty() ? fmp.val.constData() : CSTR(wpt->GetNotes()));
       break;
     case XT_URL: {
       if (xcsv_urlbase) {
@@ -1325,8 +1327,8 @@ xcsv_waypt_pr(const Waypoint* wpt)
       break;
     case XT_ICON_DESCR:
       buff = QString().sprintf(fmp.printfc.constData(),
-                (!wpt->icon_descr.isNull()) ?
-                CSTR(wpt->icon_descr) : fmp.val.constData());
+                (!wpt->GetIconDescr().isNull()) ?
+                CSTR(wpt->GetIconDescr()) : fmp.val.constData());
       break;
 
       /* LATITUDE CONVERSION***********************************************/
@@ -1958,7 +1960,7 @@ xcsv_parse_style_line(QString line)
     ba.append(tokens[0]);
     xcsv_file.codec = QTextCodec::codecForName(ba);
     if (!xcsv_file.codec) {
-      Fatal() << "Unsupported character set '" << QString(tokens[0]) << "'.";
+      fatal(FatalMsg() << "Unsupported character set '" << QString(tokens[0]) << "'.");
     }
   } else
 
@@ -1976,13 +1978,13 @@ xcsv_parse_style_line(QString line)
     } else if (p == "WAYPOINT") {
       xcsv_file.datatype = wptdata;
     } else {
-      Fatal() << MYNAME << ": Unknown data type" << p;
+      fatal(FatalMsg() << MYNAME << ": Unknown data type" << p);
     }
   } else
 
   if (op == "IFIELD") {
     if (tokens.size() < 3) {
-      Fatal() << "Invalid IFIELD line: " << tokenstr;
+      fatal(FatalMsg() << "Invalid IFIELD line: " << tokenstr);
     }
 
     // The key ("LAT_DIR") should never contain quotes.
@@ -2002,7 +2004,7 @@ xcsv_parse_style_line(QString line)
     unsigned options = 0;
       // Note: simplifieid() has to run after split().
     if (tokens.size() < 3) {
-      Fatal() << "Invalid OFIELD line: " << tokenstr;
+      fatal(FatalMsg() << "Invalid OFIELD line: " << tokenstr);
     }
 
     // The key ("LAT_DIR") should never contain quotes.
@@ -2249,7 +2251,7 @@ xcsv_wr_position(Waypoint* wpt)
   xcsv_file.stream->flush();
 }
 
-ff_vecs_t xcsv_vecs = {
+thread_local ff_vecs_t xcsv_vecs = {
   ff_type_internal,
   FF_CAP_RW_WPT, /* This is a bit of a lie for now... */
   xcsv_rd_init,
@@ -111,6 +111,6 @@ class XcsvFile {
 /****************************************************************************/
 /* obligatory global struct                                                 */
 /****************************************************************************/
-extern XcsvFile xcsv_file;
+extern thread_local XcsvFile xcsv_file;
 
 #endif  // XCSV_H_INCLUDED_
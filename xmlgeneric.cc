@@ -35,14 +35,14 @@
 #include <QtCore/QDebug>
 #endif
 
-static xg_tag_mapping* xg_tag_tbl;
-static QSet<QString> xg_ignore_taglist;
+static thread_local xg_tag_mapping* xg_tag_tbl;
+static thread_local QSet<QString> xg_ignore_taglist;
 
-static QString rd_fname;
-static QByteArray reader_data;
-static const char* xg_encoding;
+static thread_local QString rd_fname;
+static thread_local QByteArray reader_data;
+static thread_local const char* xg_encoding;
 static QTextCodec* utf8_codec = QTextCodec::codecForName("UTF-8");
-static QTextCodec* codec = utf8_codec;  // Qt has no vanilla ASCII encoding =(
+static thread_local QTextCodec* codec = utf8_codec;  // Qt has no vanilla ASCII encoding =(
 
 #define MYNAME "XML Reader"
 
@@ -83,7 +83,7 @@ static void xol_shape(xg_string, const QXmlStreamAttributes* attrv) {
 
   if (wpt) {
     if (attrv->hasAttribute("comment")) {
-      wpt->notes = attrv->value("comment").toString();
+      wpt->SetNotes(attrv->value("comment").toString());
     }
 
     if (attrv->hasAttribute("alt")) {
@@ -91,12 +91,12 @@ static void xol_shape(xg_string, const QXmlStreamAttributes* attrv) {
     }
 
     if (attrv->hasAttribute("timestamp")) {
-      wpt->creation_time = xml_parse_time(
-          attrv->value("timestamp").toString().toUtf8().constData());
+      wpt->SetCreationTime(xml_parse_time(
+                             attrv->value("timestamp").toString().toUtf8().constData()));
     }
 
     if (attrv->hasAttribute("icon")) {
-      wpt->icon_descr = attrv->value("icon").toString();
+      wpt->SetIconDescr(attrv->value("icon").toString());
     }
   }
 }
@@ -202,8 +202,8 @@ static void xol_waypt_disp_cb(const Waypoint* wpt) {
   writer->writeStartElement(QStringLiteral("shape"));
   writer->writeAttribute(QStringLiteral("type"), QStringLiteral("waypoint"));
   writer->writeAttribute(QStringLiteral("name"), name);
-  writer->writeAttribute(QStringLiteral("comment"), wpt->notes);
-  writer->writeAttribute(QStringLiteral("icon"), wpt->icon_descr);
+  writer->writeAttribute(QStringLiteral("comment"), wpt->GetNotes());
+  writer->writeAttribute(QStringLiteral("icon"), wpt->GetIconDescr());
 
   if (wpt->creation_time.isValid()) {
     writer->writeAttribute(QStringLiteral("timestamp"), wpt->CreationTimeXML());
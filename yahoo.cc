@@ -101,10 +101,11 @@ void	wpt_lon(xg_string args, const QXmlStreamAttributes*)
 
 void	wpt_addr(xg_string args, const QXmlStreamAttributes*)
 {
-  if (!wpt_tmp->notes.isEmpty()) {
-    wpt_tmp->notes += as;
+  QString notes = wpt_tmp->GetNotes();
+  if (!notes.isEmpty()) {
+    notes += as;
   }
-  wpt_tmp->notes += args;
+  wpt_tmp->SetNotes(notes + args);
 }
 
 ff_vecs_t yahoo_vecs = {